@@ -0,0 +1,73 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#include "config.h"
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+namespace engine::core {
+
+bool Config::loadFromFile(const std::string& file_path) {
+    std::ifstream file(file_path);
+    if (!file.is_open()) {
+        spdlog::warn("无法打开配置文件 '{}'，使用默认配置。", file_path);
+        return false;
+    }
+
+    nlohmann::json json;
+    try {
+        file >> json;
+    } catch (const nlohmann::json::parse_error& e) {
+        spdlog::error("解析配置文件 '{}' 失败: {}，使用默认配置。", file_path, e.what());
+        return false;
+    }
+
+    try {
+        if (const auto it = json.find("window"); it != json.end()) {
+            window_title_ = it->value("title", window_title_);
+            window_width_ = it->value("width", window_width_);
+            window_height_ = it->value("height", window_height_);
+            window_resizable_ = it->value("resizable", window_resizable_);
+        }
+        if (const auto it = json.find("graphics"); it != json.end()) {
+            vsync_enabled_ = it->value("vsync", vsync_enabled_);
+            logical_width_ = it->value("logical_width", logical_width_);
+            logical_height_ = it->value("logical_height", logical_height_);
+        }
+        if (const auto it = json.find("performance"); it != json.end()) {
+            target_fps_ = it->value("target_fps", target_fps_);
+            adaptive_quality_ = it->value("adaptive_quality", adaptive_quality_);
+            idle_throttle_ = it->value("idle_throttle", idle_throttle_);
+            idle_timeout_ms_ = it->value("idle_timeout_ms", idle_timeout_ms_);
+            pause_on_focus_loss_ = it->value("pause_on_focus_loss", pause_on_focus_loss_);
+        }
+        if (const auto it = json.find("audio"); it != json.end()) {
+            music_volume_ = it->value("music_volume", music_volume_);
+            sound_volume_ = it->value("sound_volume", sound_volume_);
+        }
+        if (const auto it = json.find("input_mappings"); it != json.end() && it->is_object()) {
+            input_mappings_.clear();
+            for (const auto& [action, keys] : it->items()) {
+                input_mappings_[action] = keys.get<std::vector<std::string>>();
+            }
+        }
+    } catch (const nlohmann::json::type_error& e) {
+        spdlog::error("配置文件 '{}' 中存在类型错误的配置项: {}", file_path, e.what());
+        return false;
+    }
+
+    if (target_fps_ < 0) {
+        spdlog::warn("配置项 performance.target_fps 不能为负，已改为 0（不限制）。");
+        target_fps_ = 0;
+    }
+    if (idle_timeout_ms_ <= 0) {
+        spdlog::warn("配置项 performance.idle_timeout_ms 必须为正，已改为 250。");
+        idle_timeout_ms_ = 250;
+    }
+    spdlog::info("已加载配置文件: {}", file_path);
+    return true;
+}
+
+} // namespace engine::core
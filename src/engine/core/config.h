@@ -0,0 +1,55 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#ifndef SUNNYLAND_CONFIG_H
+#define SUNNYLAND_CONFIG_H
+
+#include <string>           // 用于 std::string
+#include <unordered_map>    // 用于 std::unordered_map
+#include <vector>           // 用于 std::vector
+
+namespace engine::core {
+
+/**
+ * @brief 游戏配置（assets/config.json）。文件缺失或某一项缺失时使用下面的默认值。
+ */
+class Config final {
+public:
+    // --- window ---
+    std::string window_title_ = "SunnyLand";
+    int window_width_ = 1280;
+    int window_height_ = 720;
+    bool window_resizable_ = true;
+
+    // --- graphics ---
+    bool vsync_enabled_ = true;
+    int logical_width_ = 640;               ///< @brief 虚拟画布分辨率，整数倍放大到窗口
+    int logical_height_ = 360;
+
+    // --- performance ---
+    int target_fps_ = 60;                   ///< @brief 0 表示不限制
+    bool adaptive_quality_ = true;          ///< @brief 帧时间超出预算时是否由 FrameGovernor 自动降低画质
+    bool idle_throttle_ = true;             ///< @brief 暂停、菜单、失去焦点或最小化时只在画面变化时渲染，并阻塞等待事件
+    int idle_timeout_ms_ = 250;             ///< @brief 空闲时等待事件的最长时间（最小化时为 4 倍），到时检查后台加载等
+    bool pause_on_focus_loss_ = true;       ///< @brief 窗口失去焦点时是否冻结游戏
+
+    // --- audio ---
+    float music_volume_ = 0.5f;
+    float sound_volume_ = 0.5f;
+
+    // --- input_mappings ---
+    std::unordered_map<std::string, std::vector<std::string>> input_mappings_;  ///< @brief 动作名 -> 按键名列表
+
+    Config() = default;
+
+    /**
+     * @brief 读取配置文件。
+     * @return 文件无法读取或解析失败时返回 false，此时保持默认值。
+     */
+    bool loadFromFile(const std::string& file_path);
+};
+
+} // namespace engine::core
+
+#endif //SUNNYLAND_CONFIG_H
@@ -0,0 +1,207 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#include "coroutine.h"
+#include "../utils/metrics.h"
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <spdlog/spdlog.h>
+
+namespace engine::core {
+
+namespace {
+
+constexpr ScriptId makeScriptId(std::uint32_t index, std::uint32_t generation) {
+    return (static_cast<ScriptId>(generation) << 32) | index;
+}
+
+constexpr std::uint32_t scriptIndex(ScriptId script) {
+    return static_cast<std::uint32_t>(script & 0xFFFFFFFFu);
+}
+
+constexpr std::uint32_t scriptGeneration(ScriptId script) {
+    return static_cast<std::uint32_t>(script >> 32);
+}
+
+} // namespace
+
+std::coroutine_handle<> Task::FinalAwaiter::await_suspend(Handle handle) noexcept {
+    auto& promise = handle.promise();
+    if (promise.continuation && !promise.failed) {
+        return promise.continuation;
+    }
+    // 子协程失败时父协程不能当作成功继续执行：取消整个脚本，父协程停在 co_await 处随脚本一起销毁
+    if (promise.continuation && promise.scheduler) {
+        promise.scheduler->cancel(promise.script);
+    }
+    return std::noop_coroutine();      // 顶层协程停在结束点，由调度器销毁
+}
+
+void Task::promise_type::unhandled_exception() noexcept {
+    failed = true;
+    try {
+        throw;
+    } catch (const std::exception& e) {
+        spdlog::error("协程脚本抛出异常，已终止: {}", e.what());
+    } catch (...) {
+        spdlog::error("协程脚本抛出未知异常，已终止。");
+    }
+}
+
+CoroutineScheduler::CoroutineScheduler(EventBus& event_bus)
+    : event_bus_(event_bus) {
+    ready_.reserve(256);
+    next_frame_.reserve(256);
+    resuming_.reserve(256);
+    timers_.reserve(256);
+}
+
+CoroutineScheduler::~CoroutineScheduler() {
+    clear();
+    for (const auto listener : listeners_) {
+        event_bus_.unsubscribe(listener);
+    }
+}
+
+ScriptId CoroutineScheduler::start(Task task, const void* owner) {
+    auto root = task.release();
+    if (!root) {
+        return INVALID_SCRIPT;
+    }
+
+    std::uint32_t index;
+    if (!free_slots_.empty()) {
+        index = free_slots_.back();
+        free_slots_.pop_back();
+    } else {
+        index = static_cast<std::uint32_t>(slots_.size());
+        slots_.emplace_back();
+    }
+    auto& slot = slots_[index];
+    slot.root = root;
+    slot.owner = owner;
+    slot.cancel_requested = false;
+    ++script_count_;
+
+    const auto script = makeScriptId(index, slot.generation);
+    root.promise().scheduler = this;
+    root.promise().script = script;
+    resume({script, root});
+    return isRunning(script) ? script : INVALID_SCRIPT;
+}
+
+bool CoroutineScheduler::cancel(ScriptId script) {
+    if (!findSlot(script)) {
+        return false;
+    }
+    auto& slot = slots_[scriptIndex(script)];
+    if (slot.resume_depth > 0) {
+        slot.cancel_requested = true;       // 协程帧仍在调用栈上（自己取消自己，或子脚本取消了父脚本），不能销毁
+    } else {
+        destroySlot(scriptIndex(script));
+    }
+    // 被取消脚本的计时器要到唤醒时间才会被丢弃，积累过多时（如长时间等待的脚本被批量取消）集中清理一次
+    if (timers_.size() > 2 * script_count_ + 64) {
+        purgeTimers();
+    }
+    return true;
+}
+
+void CoroutineScheduler::cancelAll(const void* owner) {
+    for (std::uint32_t index = 0; index < slots_.size(); ++index) {
+        const auto& slot = slots_[index];
+        if (slot.root && slot.owner == owner) {
+            cancel(makeScriptId(index, slot.generation));
+        }
+    }
+}
+
+void CoroutineScheduler::clear() {
+    for (std::uint32_t index = 0; index < slots_.size(); ++index) {
+        const auto& slot = slots_[index];
+        if (slot.root) {
+            cancel(makeScriptId(index, slot.generation));
+        }
+    }
+    ready_.clear();
+    next_frame_.clear();
+    timers_.clear();
+}
+
+void CoroutineScheduler::update(float delta_time) {
+    clock_ += delta_time;
+
+    // 本帧的批次：事件唤醒的 + 上一帧 nextFrame() 的 + 到期的计时器。恢复期间新挂起的一律留到下一帧
+    resuming_.swap(ready_);
+    resuming_.insert(resuming_.end(), next_frame_.begin(), next_frame_.end());
+    next_frame_.clear();
+    while (!timers_.empty() && timers_.front().wake_time <= clock_) {
+        std::pop_heap(timers_.begin(), timers_.end(), std::greater<>{});
+        resuming_.push_back(timers_.back().resumption);
+        timers_.pop_back();
+    }
+
+    last_resumes_ = 0;
+    for (const auto& resumption : resuming_) {
+        resume(resumption);
+    }
+    resuming_.clear();
+}
+
+bool CoroutineScheduler::isRunning(ScriptId script) const {
+    const auto index = scriptIndex(script);
+    return index < slots_.size() && slots_[index].root && slots_[index].generation == scriptGeneration(script);
+}
+
+CoroutineScheduler::ScriptSlot* CoroutineScheduler::findSlot(ScriptId script) {
+    return isRunning(script) ? &slots_[scriptIndex(script)] : nullptr;
+}
+
+void CoroutineScheduler::resume(const Resumption& resumption) {
+    // 脚本可能已被取消（槽位为空或已被新脚本复用），此时句柄已失效，直接丢弃
+    if (!findSlot(resumption.script)) {
+        return;
+    }
+    const auto index = scriptIndex(resumption.script);
+    ++slots_[index].resume_depth;
+    resumption.handle.resume();
+    ++last_resumes_;
+    engine::utils::Metrics::add(engine::utils::Metric::CoroutineResumes);
+
+    // resume() 期间 slots_ 可能因启动新脚本而扩容，重新取槽位。嵌套恢复时由最外层负责销毁
+    auto& slot = slots_[index];
+    if (--slot.resume_depth == 0 && (slot.cancel_requested || slot.root.done())) {
+        destroySlot(index);
+    }
+}
+
+void CoroutineScheduler::destroySlot(std::uint32_t index) {
+    // 先把槽位置空再销毁协程帧：帧内局部对象的析构函数可能再调用调度器
+    const auto root = std::exchange(slots_[index].root, {});
+    slots_[index].owner = nullptr;
+    slots_[index].cancel_requested = false;
+    if (++slots_[index].generation == 0) {
+        slots_[index].generation = 1;      // 代数 0 会与 INVALID_SCRIPT 冲突
+    }
+    free_slots_.push_back(index);
+    --script_count_;
+    root.destroy();
+}
+
+void CoroutineScheduler::purgeTimers() {
+    std::erase_if(timers_, [this](const Timer& timer) { return !isRunning(timer.resumption.script); });
+    std::make_heap(timers_.begin(), timers_.end(), std::greater<>{});
+}
+
+void CoroutineScheduler::scheduleNextFrame(ScriptId script, std::coroutine_handle<> handle) {
+    next_frame_.push_back({script, handle});
+}
+
+void CoroutineScheduler::scheduleAt(double wake_time, ScriptId script, std::coroutine_handle<> handle) {
+    timers_.push_back({wake_time, {script, handle}});
+    std::push_heap(timers_.begin(), timers_.end(), std::greater<>{});
+}
+
+} // namespace engine::core
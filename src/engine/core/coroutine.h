@@ -0,0 +1,351 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#ifndef SUNNYLAND_COROUTINE_H
+#define SUNNYLAND_COROUTINE_H
+
+#include "event_bus.h"
+#include "../utils/frame_pool.h"
+#include <array>        // 用于 std::array
+#include <coroutine>    // 用于 std::coroutine_handle
+#include <cstddef>      // 用于 std::size_t
+#include <cstdint>      // 用于 std::uint64_t
+#include <memory>       // 用于 std::unique_ptr
+#include <span>         // 用于 std::span
+#include <stdexcept>    // 用于 std::runtime_error
+#include <utility>      // 用于 std::exchange
+#include <vector>       // 用于 std::vector
+
+namespace engine::core {
+
+class CoroutineScheduler;
+
+using ScriptId = std::uint64_t;         ///< @brief 高 32 位为代数，低 32 位为槽位下标
+inline constexpr ScriptId INVALID_SCRIPT = 0;
+
+/**
+ * @brief 游戏脚本 / AI 行为的协程返回类型。
+ *
+ * 协程创建后不会立即执行，需要交给 CoroutineScheduler::start() 运行，或在另一个 Task 中 co_await（作为子过程同步执行完）。
+ * 协程帧从 FramePool 分配。Task 只能移动，析构时销毁尚未交出的协程帧。
+ * 用法：
+ *   engine::core::Task patrol(Enemy& self) {
+ *       for (;;) {
+ *           co_await engine::core::waitSeconds(2.0f);
+ *           self.turn();
+ *           const auto hit = co_await engine::core::waitEvent<DamageEvent>([&](const DamageEvent& e) { return e.target == self.id; });
+ *           co_await flee(self, hit.amount);   // 子协程
+ *       }
+ *   }
+ *   scheduler.start(patrol(*this), this);
+ */
+class Task final {
+public:
+    struct promise_type;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+        std::coroutine_handle<> await_suspend(Handle handle) noexcept;  ///< @brief 子协程结束时直接切回父协程
+        void await_resume() const noexcept {}
+    };
+
+    struct promise_type {
+        CoroutineScheduler* scheduler = nullptr;    ///< @brief 所属调度器，子协程从父协程继承
+        ScriptId script = INVALID_SCRIPT;           ///< @brief 所属的顶层脚本
+        std::coroutine_handle<> continuation;       ///< @brief 等待本协程结束的父协程，顶层协程为空
+        bool failed = false;                        ///< @brief 协程因异常结束，父协程不再恢复，整个脚本被取消
+
+        Task get_return_object() { return Task(Handle::from_promise(*this)); }
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        FinalAwaiter final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() noexcept;        ///< @brief 记录错误并终止整个脚本（不向调度器传播）
+
+        static void* operator new(std::size_t size) { return engine::utils::FramePool::instance().allocate(size); }
+        static void operator delete(void* pointer, std::size_t size) noexcept {
+            engine::utils::FramePool::instance().deallocate(pointer, size);
+        }
+    };
+
+private:
+    Handle handle_;
+
+public:
+    Task() = default;
+    explicit Task(Handle handle) : handle_(handle) {}
+    ~Task() { if (handle_) { handle_.destroy(); } }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (handle_) {
+                handle_.destroy();
+            }
+            handle_ = std::exchange(other.handle_, {});
+        }
+        return *this;
+    }
+
+    [[nodiscard]] bool valid() const { return static_cast<bool>(handle_); }
+    Handle release() { return std::exchange(handle_, {}); }     ///< @brief 交出协程帧的所有权
+
+    /**
+     * @brief 在另一个 Task 中 co_await 子协程：立即切换到子协程执行，子协程结束后回到调用处。
+     */
+    auto operator co_await() && noexcept {
+        struct Awaiter {
+            Handle child;
+            bool await_ready() const noexcept { return !child || child.done(); }
+            Handle await_suspend(Handle parent) noexcept {
+                auto& promise = child.promise();
+                promise.scheduler = parent.promise().scheduler;
+                promise.script = parent.promise().script;
+                promise.continuation = parent;
+                return child;
+            }
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{handle_};
+    }
+};
+
+namespace detail {
+
+/**
+ * @brief 某个事件类型上挂起的 waitEvent() 等待者。等待者对象位于协程帧内，挂起期间地址不变，注册时不分配内存。
+ */
+template <typename Event>
+class EventWaiter {
+public:
+    ScriptId script = INVALID_SCRIPT;
+    std::coroutine_handle<> handle;
+    Event value{};
+    std::vector<EventWaiter*>* list = nullptr;     ///< @brief 所在的等待列表，不在列表中时为空
+
+    virtual bool accept(const Event& event) = 0;
+
+protected:
+    ~EventWaiter() {
+        // 协程被取消时等待者随协程帧销毁，需要把自己从列表中摘掉
+        if (list) {
+            std::erase(*list, this);
+        }
+    }
+};
+
+class WaiterListBase {
+public:
+    virtual ~WaiterListBase() = default;
+};
+
+template <typename Event>
+class WaiterList final : public WaiterListBase {
+public:
+    CoroutineScheduler* scheduler = nullptr;
+    std::vector<EventWaiter<Event>*> waiters;
+    ListenerId listener = INVALID_LISTENER;
+};
+
+struct AcceptAny {
+    template <typename Event>
+    bool operator()(const Event&) const noexcept { return true; }
+};
+
+} // namespace detail
+
+/**
+ * @brief 协程调度器，只恢复已就绪的协程。
+ *
+ * - nextFrame() 的协程放在下一帧的列表里；waitSeconds() 的协程按唤醒时间放进最小堆，每帧只看堆顶；
+ *   waitEvent() 的协程挂在该事件类型的等待列表上，由 EventBus 分发该类型的事件时唤醒。
+ *   因此休眠中的协程每帧没有任何开销，update() 的开销只与本帧就绪的协程数有关。
+ * - 时间使用 update() 传入的缩放后的帧间时间（Time::getDeltaTime()），暂停或慢动作会同样作用于 waitSeconds()。
+ * - 每个顶层脚本可以关联一个 owner（如场景或游戏对象），owner 销毁前用 cancelAll(owner) 取消它的脚本。
+ *
+ * 只能在主线程使用。EventBus 的生命周期必须长于调度器。
+ */
+class CoroutineScheduler final {
+    template <typename Event, typename Predicate>
+    friend class EventAwaiter;
+    friend struct NextFrameAwaiter;
+    friend struct WaitSecondsAwaiter;
+
+private:
+    struct ScriptSlot {
+        Task::Handle root;                      ///< @brief 顶层协程，空表示槽位空闲
+        const void* owner = nullptr;
+        std::uint32_t generation = 1;
+        std::uint32_t resume_depth = 0;         ///< @brief 正在恢复的嵌套层数（脚本内 start() 的子脚本可能再恢复到它）
+        bool cancel_requested = false;          ///< @brief 脚本在恢复期间被取消，最外层的恢复返回后再销毁
+    };
+
+    struct Resumption {
+        ScriptId script = INVALID_SCRIPT;
+        std::coroutine_handle<> handle;         ///< @brief 实际挂起的（可能是子）协程
+    };
+
+    struct Timer {
+        double wake_time = 0.0;
+        Resumption resumption;
+
+        bool operator>(const Timer& other) const { return wake_time > other.wake_time; }
+    };
+
+    EventBus& event_bus_;
+    std::vector<ScriptSlot> slots_;
+    std::vector<std::uint32_t> free_slots_;
+    std::vector<Resumption> ready_;             ///< @brief 本帧待恢复（由事件唤醒或计时器到期）
+    std::vector<Resumption> next_frame_;        ///< @brief 等待下一帧
+    std::vector<Resumption> resuming_;          ///< @brief 正在恢复的批次，与 ready_ 交替使用以复用容量
+    std::vector<Timer> timers_;                 ///< @brief 按 wake_time 排列的最小堆
+    std::array<std::unique_ptr<detail::WaiterListBase>, EventBus::MAX_EVENT_TYPES> waiter_lists_;
+    std::vector<ListenerId> listeners_;
+
+    double clock_ = 0.0;                        ///< @brief 累计的缩放时间（秒）
+    std::size_t script_count_ = 0;
+    std::size_t last_resumes_ = 0;
+
+public:
+    explicit CoroutineScheduler(EventBus& event_bus);
+    ~CoroutineScheduler();
+
+    CoroutineScheduler(const CoroutineScheduler&) = delete;
+    CoroutineScheduler& operator=(const CoroutineScheduler&) = delete;
+    CoroutineScheduler(CoroutineScheduler&&) = delete;
+    CoroutineScheduler& operator=(CoroutineScheduler&&) = delete;
+
+    /**
+     * @brief 启动脚本：立即运行到第一个挂起点。
+     * @param task 尚未启动的协程。
+     * @param owner 可选的所有者，用于 cancelAll()。
+     * @return 脚本 ID；task 为空或在第一个挂起点之前就已结束时返回 INVALID_SCRIPT。
+     */
+    ScriptId start(Task task, const void* owner = nullptr);
+
+    bool cancel(ScriptId script);               ///< @brief 取消脚本并销毁协程帧；正在执行的脚本（包括自己和调用栈上的父脚本）在其恢复返回后销毁
+    void cancelAll(const void* owner);          ///< @brief 取消 owner 的所有脚本
+    void clear();                               ///< @brief 取消所有脚本
+
+    /**
+     * @brief 推进时钟并恢复所有就绪的协程。GameApp 在事件分发之后每帧调用一次。
+     * @param delta_time 缩放后的帧间时间（秒）。
+     */
+    void update(float delta_time);
+
+    [[nodiscard]] bool isRunning(ScriptId script) const;
+    [[nodiscard]] std::size_t getScriptCount() const { return script_count_; }
+    [[nodiscard]] std::size_t getLastResumeCount() const { return last_resumes_; }     ///< @brief 上一次 update() 恢复的协程数
+    [[nodiscard]] double getClock() const { return clock_; }
+
+private:
+    [[nodiscard]] ScriptSlot* findSlot(ScriptId script);
+    void resume(const Resumption& resumption);
+    void destroySlot(std::uint32_t index);
+    void purgeTimers();     ///< @brief 移除已取消脚本留下的计时器
+
+    void scheduleNextFrame(ScriptId script, std::coroutine_handle<> handle);
+    void scheduleAt(double wake_time, ScriptId script, std::coroutine_handle<> handle);
+
+    template <typename Event>
+    detail::WaiterList<Event>& getWaiterList() {
+        const auto type_id = detail::eventTypeId<Event>();
+        if (type_id >= EventBus::MAX_EVENT_TYPES) {
+            throw std::runtime_error("CoroutineScheduler 错误: 事件类型数量超过 EventBus::MAX_EVENT_TYPES");
+        }
+        auto& slot = waiter_lists_[type_id];
+        if (!slot) {
+            auto list = std::make_unique<detail::WaiterList<Event>>();
+            list->scheduler = this;
+            list->listener = event_bus_.subscribe<Event>(list.get(), &CoroutineScheduler::onEvents<Event>);
+            listeners_.push_back(list->listener);
+            slot = std::move(list);
+        }
+        return static_cast<detail::WaiterList<Event>&>(*slot);
+    }
+
+    // 每批事件调用一次：逐个等待者找第一个满足条件的事件，命中就移入就绪列表。没有等待者时立即返回
+    template <typename Event>
+    static void onEvents(void* instance, std::span<const Event> events) {
+        auto& list = *static_cast<detail::WaiterList<Event>*>(instance);
+        std::erase_if(list.waiters, [&](detail::EventWaiter<Event>* waiter) {
+            for (const auto& event : events) {
+                if (waiter->accept(event)) {
+                    waiter->value = event;
+                    waiter->list = nullptr;
+                    list.scheduler->ready_.push_back({waiter->script, waiter->handle});
+                    return true;
+                }
+            }
+            return false;
+        });
+    }
+};
+
+// --- 可等待对象，只能在 Task 协程中 co_await ---
+
+struct NextFrameAwaiter {
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(Task::Handle handle) const {
+        auto& promise = handle.promise();
+        promise.scheduler->scheduleNextFrame(promise.script, handle);
+    }
+    void await_resume() const noexcept {}
+};
+
+struct WaitSecondsAwaiter {
+    float seconds = 0.0f;
+
+    bool await_ready() const noexcept { return seconds <= 0.0f; }
+    void await_suspend(Task::Handle handle) const {
+        auto& promise = handle.promise();
+        promise.scheduler->scheduleAt(promise.scheduler->clock_ + seconds, promise.script, handle);
+    }
+    void await_resume() const noexcept {}
+};
+
+template <typename Event, typename Predicate>
+class EventAwaiter final : public detail::EventWaiter<Event> {
+private:
+    Predicate predicate_;
+
+public:
+    explicit EventAwaiter(Predicate predicate) : predicate_(std::move(predicate)) {}
+    ~EventAwaiter() = default;
+
+    EventAwaiter(const EventAwaiter&) = delete;
+    EventAwaiter& operator=(const EventAwaiter&) = delete;
+    EventAwaiter(EventAwaiter&&) = delete;
+    EventAwaiter& operator=(EventAwaiter&&) = delete;
+
+    bool accept(const Event& event) override { return predicate_(event); }
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(Task::Handle handle) {
+        auto& promise = handle.promise();
+        auto& list = promise.scheduler->template getWaiterList<Event>();
+        this->script = promise.script;
+        this->handle = handle;
+        this->list = &list.waiters;
+        list.waiters.push_back(this);
+    }
+    Event await_resume() const noexcept { return this->value; }
+};
+
+inline NextFrameAwaiter nextFrame() { return {}; }      ///< @brief 挂起到下一次 update()
+inline WaitSecondsAwaiter waitSeconds(float seconds) { return {seconds}; }     ///< @brief 挂起 seconds 秒缩放时间；不大于 0 时不挂起
+
+/**
+ * @brief 挂起直到分发出一个满足 predicate 的 Event，返回该事件。等待开始前已发布但尚未分发的事件也会被接收。
+ */
+template <typename Event, typename Predicate = detail::AcceptAny>
+EventAwaiter<Event, Predicate> waitEvent(Predicate predicate = {}) {
+    return EventAwaiter<Event, Predicate>(std::move(predicate));
+}
+
+} // namespace engine::core
+
+#endif //SUNNYLAND_COROUTINE_H
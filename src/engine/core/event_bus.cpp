@@ -0,0 +1,99 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#include "event_bus.h"
+#include "../utils/log.h"
+#include "../utils/metrics.h"
+#include <atomic>
+#include <stdexcept>
+#include <string>
+
+namespace engine::core {
+
+namespace detail {
+
+std::uint32_t nextEventTypeId() {
+    static std::atomic<std::uint32_t> next{0};
+    return next.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace detail
+
+EventBus::~EventBus() {
+    const auto pending = getPendingCount();
+    if (pending > 0) {
+        SPDLOG_DEBUG("EventBus 析构时仍有 {} 个事件未分发。", pending);
+    }
+}
+
+bool EventBus::unsubscribe(ListenerId id) {
+    const auto type_id = id >> 24;
+    if (id == INVALID_LISTENER || type_id >= channel_count_ || !channels_[type_id]) {
+        return false;
+    }
+    return channels_[type_id]->removeListener(id);
+}
+
+void EventBus::unsubscribeAll(const void* instance) {
+    for (std::size_t i = 0; i < channel_count_; ++i) {
+        if (channels_[i]) {
+            channels_[i]->removeInstance(instance);
+        }
+    }
+}
+
+std::size_t EventBus::dispatch() {
+    std::size_t total = 0;
+    for (int round = 0; round < MAX_ROUNDS; ++round) {
+        std::size_t dispatched = 0;
+        // 按下标遍历：监听者可能订阅新的事件类型，channel_count_ 会随之增长
+        for (std::size_t i = 0; i < channel_count_; ++i) {
+            if (channels_[i]) {
+                dispatched += channels_[i]->dispatch();
+            }
+        }
+        total += dispatched;
+        if (dispatched == 0) {
+            break;
+        }
+    }
+    if (total > 0) {
+        engine::utils::Metrics::add(engine::utils::Metric::EventsDispatched, total);
+    }
+    if (getPendingCount() > 0) {
+        SUNNYLAND_LOG_EVERY(spdlog::level::warn, 1000, "EventBus: 事件在 {} 轮分发后仍在连锁产生，剩余 {} 个留到下一帧。",
+                            MAX_ROUNDS, getPendingCount());
+    }
+    return total;
+}
+
+void EventBus::clearPending() {
+    for (std::size_t i = 0; i < channel_count_; ++i) {
+        if (channels_[i]) {
+            channels_[i]->clearPending();
+        }
+    }
+}
+
+std::size_t EventBus::getPendingCount() const {
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < channel_count_; ++i) {
+        if (channels_[i]) {
+            count += channels_[i]->getPendingCount();
+        }
+    }
+    return count;
+}
+
+void EventBus::onTooManyTypes(std::uint32_t type_id) {
+    throw std::runtime_error("EventBus: 事件类型过多（类型 ID " + std::to_string(type_id) + "，上限 " +
+                             std::to_string(MAX_EVENT_TYPES) + "）");
+}
+
+void EventBus::onAsyncDropped(std::uint32_t type_id) {
+    engine::utils::Metrics::add(engine::utils::Metric::EventsDropped);
+    SUNNYLAND_LOG_EVERY(spdlog::level::warn, 1000, "EventBus: 类型 {} 的跨线程事件被丢弃（未调用 enableAsync 或队列已满）。", type_id);
+}
+
+} // namespace engine::core
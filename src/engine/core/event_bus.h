@@ -0,0 +1,303 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#ifndef SUNNYLAND_EVENT_BUS_H
+#define SUNNYLAND_EVENT_BUS_H
+
+#include "../utils/mpsc_queue.h"
+#include <algorithm>    // 用于 std::max
+#include <array>        // 用于 std::array
+#include <cstddef>      // 用于 std::size_t
+#include <cstdint>      // 用于 std::uint32_t
+#include <memory>       // 用于 std::unique_ptr
+#include <span>         // 用于 std::span
+#include <type_traits>  // 用于 std::is_trivially_copyable_v
+#include <vector>       // 用于 std::vector
+
+namespace engine::core {
+
+using ListenerId = std::uint32_t;       ///< @brief 高 8 位为事件类型，低 24 位为该类型内的序号
+inline constexpr ListenerId INVALID_LISTENER = 0;
+
+namespace detail {
+
+std::uint32_t nextEventTypeId();
+
+template <typename Event>
+std::uint32_t eventTypeId() {
+    static const std::uint32_t id = nextEventTypeId();     // 首次使用时分配，线程安全
+    return id;
+}
+
+/**
+ * @brief 单个事件类型的通道基类。虚函数只在每次分发时对每个通道调用一次，与监听者和事件的数量无关。
+ */
+class EventChannelBase {
+public:
+    virtual ~EventChannelBase() = default;
+    virtual std::size_t dispatch() = 0;             ///< @brief 取出跨线程队列中的事件，把当前批次交给所有监听者，返回事件数
+    virtual bool removeListener(ListenerId id) = 0;
+    virtual void removeInstance(const void* instance) = 0;
+    virtual void clearPending() = 0;
+    [[nodiscard]] virtual std::size_t getPendingCount() const = 0;
+};
+
+template <typename Event>
+class EventChannel final : public EventChannelBase {
+    static_assert(std::is_trivially_copyable_v<Event> && std::is_default_constructible_v<Event>,
+                  "事件必须是可平凡拷贝、可默认构造的类型（整数 ID、数值等），发布时不会分配内存");
+
+public:
+    using Invoke = void (*)(void* instance, std::span<const Event> events);
+
+    struct Listener {
+        ListenerId id = INVALID_LISTENER;
+        void* instance = nullptr;
+        Invoke invoke = nullptr;        ///< @brief 为空表示已在分发期间取消订阅，分发结束后移除
+    };
+
+    std::vector<Event> queue_;          ///< @brief 主线程发布、等待下次分发的事件
+    std::vector<Event> batch_;          ///< @brief 正在分发的批次，与 queue_ 交替使用以复用容量
+    std::vector<Listener> listeners_;
+    std::unique_ptr<engine::utils::MpscQueue<Event>> async_queue_;     ///< @brief 其他线程发布的事件，未启用时为空
+    std::uint32_t next_serial_ = 1;
+    bool dispatching_ = false;
+    bool needs_compact_ = false;
+
+    std::size_t dispatch() override {
+        if (async_queue_) {
+            Event event;
+            while (async_queue_->tryPop(event)) {
+                queue_.push_back(event);
+            }
+        }
+        if (queue_.empty()) {
+            return 0;
+        }
+        batch_.swap(queue_);            // 分发期间发布的事件进入（已清空的）queue_，留到下一轮
+        dispatching_ = true;
+        const std::span<const Event> events(batch_);
+        const auto count = listeners_.size();      // 分发期间新增的监听者从下一批开始接收
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto listener = listeners_[i];    // 拷贝：回调中订阅可能使 listeners_ 扩容
+            if (listener.invoke) {
+                listener.invoke(listener.instance, events);
+            }
+        }
+        dispatching_ = false;
+        if (needs_compact_) {
+            std::erase_if(listeners_, [](const Listener& listener) { return listener.invoke == nullptr; });
+            needs_compact_ = false;
+        }
+        const auto dispatched = batch_.size();
+        batch_.clear();
+        return dispatched;
+    }
+
+    bool removeListener(ListenerId id) override {
+        for (auto& listener : listeners_) {
+            if (listener.id == id && listener.invoke) {
+                listener.invoke = nullptr;
+                compact();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void removeInstance(const void* instance) override {
+        for (auto& listener : listeners_) {
+            if (listener.instance == instance) {
+                listener.invoke = nullptr;
+            }
+        }
+        compact();
+    }
+
+    void clearPending() override {
+        queue_.clear();
+        if (async_queue_) {
+            Event event;
+            while (async_queue_->tryPop(event)) {
+            }
+        }
+    }
+
+    [[nodiscard]] std::size_t getPendingCount() const override { return queue_.size(); }
+
+private:
+    // 移除已取消的监听者；分发期间只做标记，分发结束后再移除，以免改变正在遍历的数组
+    void compact() {
+        if (dispatching_) {
+            needs_compact_ = true;
+        } else {
+            std::erase_if(listeners_, [](const Listener& listener) { return listener.invoke == nullptr; });
+        }
+    }
+};
+
+// 成员函数 / 自由函数到 Invoke 的转发。Method 是编译期常量，循环内是直接调用，可以内联
+template <typename Event, auto Method, typename Class>
+void invokeMember(void* instance, std::span<const Event> events) {
+    auto* object = static_cast<Class*>(instance);
+    if constexpr (std::is_invocable_v<decltype(Method), Class*, std::span<const Event>>) {
+        (object->*Method)(events);
+    } else {
+        for (const auto& event : events) {
+            (object->*Method)(event);
+        }
+    }
+}
+
+template <typename Event, auto Function>
+void invokeFunction(void*, std::span<const Event> events) {
+    if constexpr (std::is_invocable_v<decltype(Function), std::span<const Event>>) {
+        Function(events);
+    } else {
+        for (const auto& event : events) {
+            Function(event);
+        }
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief 类型化、批量分发的游戏事件总线，用于伤害、拾取、分数变化等系统之间的消息传递。
+ *
+ * - 每种事件类型一个通道，事件按值连续存放在该类型自己的数组中；事件必须可平凡拷贝。
+ * - publish() 只把事件追加到数组末尾（容量复用，稳定后不再分配），不会立即调用监听者；
+ *   所有事件在 dispatch() 时按类型成批交给监听者（GameApp 在每帧 update 之后调用一次）。
+ * - 监听者是“函数指针 + 对象指针”，每个监听者每批只调用一次；成员函数以模板参数给出，
+ *   逐个事件的循环在转发函数内部直接调用，没有逐事件、逐监听者的虚调用或 std::function。
+ * - 其他线程通过 publishAsync() 发布，事件进入该类型预先分配的无锁 MPSC 队列，下次分发时并入主线程的批次。
+ *
+ * 除 publishAsync() 外的所有函数只能在主线程调用。
+ * 用法：
+ *   bus.subscribe<DamageEvent, &Player::onDamage>(this);     // void Player::onDamage(const DamageEvent&)
+ *   bus.subscribe<ScoreEvent, &Hud::onScores>(this);         // 或整批接收：void Hud::onScores(std::span<const ScoreEvent>)
+ *   bus.publish(DamageEvent{target, 1});
+ */
+class EventBus final {
+public:
+    static constexpr std::size_t MAX_EVENT_TYPES = 64;
+    static constexpr int MAX_ROUNDS = 4;    ///< @brief 一次 dispatch() 中最多处理几轮“监听者又发布了新事件”
+
+private:
+    // 固定大小的槽位：注册新类型不会移动已有通道，其他线程可以安全地读取已注册的槽位
+    std::array<std::unique_ptr<detail::EventChannelBase>, MAX_EVENT_TYPES> channels_;
+    std::size_t channel_count_ = 0;     ///< @brief 最大已用类型 ID + 1
+
+public:
+    EventBus() = default;
+    ~EventBus();
+
+    EventBus(const EventBus&) = delete;
+    EventBus& operator=(const EventBus&) = delete;
+    EventBus(EventBus&&) = delete;
+    EventBus& operator=(EventBus&&) = delete;
+
+    /**
+     * @brief 为 Event 启用跨线程发布，预分配容量为 async_capacity 的无锁队列。
+     *        必须在其他线程可能发布该事件之前（如启动工作线程之前）在主线程调用。
+     */
+    template <typename Event>
+    void enableAsync(std::size_t async_capacity) {
+        auto& channel = getChannel<Event>();
+        if (!channel.async_queue_) {
+            channel.async_queue_ = std::make_unique<engine::utils::MpscQueue<Event>>(async_capacity);
+        }
+    }
+
+    /**
+     * @brief 订阅事件。Method 为 void (Class::*)(const Event&) 或 void (Class::*)(std::span<const Event>)。
+     *        instance 销毁前必须取消订阅（unsubscribe 或 unsubscribeAll）。
+     */
+    template <typename Event, auto Method, typename Class>
+    ListenerId subscribe(Class* instance) {
+        return addListener<Event>(instance, &detail::invokeMember<Event, Method, Class>);
+    }
+
+    /**
+     * @brief 订阅事件，Function 为 void (*)(const Event&) 或 void (*)(std::span<const Event>)。
+     */
+    template <typename Event, auto Function>
+    ListenerId subscribe() {
+        return addListener<Event>(nullptr, &detail::invokeFunction<Event, Function>);
+    }
+
+    /**
+     * @brief 以原始的“函数指针 + 上下文”订阅，invoke 每批调用一次。
+     */
+    template <typename Event>
+    ListenerId subscribe(void* instance, typename detail::EventChannel<Event>::Invoke invoke) {
+        return addListener<Event>(instance, invoke);
+    }
+
+    bool unsubscribe(ListenerId id);                ///< @brief 分发期间调用也是安全的，被取消的监听者不再收到本批剩余的调用
+    void unsubscribeAll(const void* instance);      ///< @brief 取消 instance 在所有事件类型上的订阅
+
+    /**
+     * @brief 主线程发布事件，在下一次 dispatch() 时分发。
+     */
+    template <typename Event>
+    void publish(const Event& event) {
+        getChannel<Event>().queue_.push_back(event);
+    }
+
+    /**
+     * @brief 任意线程发布事件。Event 必须已通过 enableAsync() 启用。
+     * @return 未启用或队列已满时返回 false（事件被丢弃并计入 Metric::EventsDropped）。
+     */
+    template <typename Event>
+    bool publishAsync(const Event& event) {
+        const auto type_id = detail::eventTypeId<Event>();
+        auto* channel = type_id < MAX_EVENT_TYPES ? static_cast<detail::EventChannel<Event>*>(channels_[type_id].get()) : nullptr;
+        if (channel && channel->async_queue_ && channel->async_queue_->tryPush(event)) {
+            return true;
+        }
+        onAsyncDropped(type_id);
+        return false;
+    }
+
+    /**
+     * @brief 分发所有待处理事件。按类型依次整批交给监听者；监听者发布的新事件在同一次调用中的下一轮分发，
+     *        最多 MAX_ROUNDS 轮，剩余的留到下一次 dispatch()。
+     * @return 本次分发的事件总数。
+     */
+    std::size_t dispatch();
+
+    void clearPending();    ///< @brief 丢弃所有未分发的事件（如切换关卡时）
+    [[nodiscard]] std::size_t getPendingCount() const;      ///< @brief 主线程队列中未分发的事件数（不含跨线程队列）
+
+private:
+    template <typename Event>
+    detail::EventChannel<Event>& getChannel() {
+        const auto type_id = detail::eventTypeId<Event>();
+        if (type_id >= MAX_EVENT_TYPES) {
+            onTooManyTypes(type_id);
+        }
+        auto& slot = channels_[type_id];
+        if (!slot) {
+            slot = std::make_unique<detail::EventChannel<Event>>();
+            channel_count_ = std::max(channel_count_, static_cast<std::size_t>(type_id) + 1);
+        }
+        return static_cast<detail::EventChannel<Event>&>(*slot);
+    }
+
+    template <typename Event>
+    ListenerId addListener(void* instance, typename detail::EventChannel<Event>::Invoke invoke) {
+        auto& channel = getChannel<Event>();
+        const auto id = (detail::eventTypeId<Event>() << 24) | (channel.next_serial_++ & 0x00FFFFFFu);
+        channel.listeners_.push_back({id, instance, invoke});
+        return id;
+    }
+
+    [[noreturn]] static void onTooManyTypes(std::uint32_t type_id);
+    static void onAsyncDropped(std::uint32_t type_id);
+};
+
+} // namespace engine::core
+
+#endif //SUNNYLAND_EVENT_BUS_H
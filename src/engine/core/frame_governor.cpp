@@ -0,0 +1,256 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#include "frame_governor.h"
+#include "../utils/metrics.h"
+#include <algorithm>
+#include <spdlog/spdlog.h>
+
+namespace engine::core {
+
+namespace {
+
+constexpr float DEFAULT_BUDGET_FPS = 60.0f;     // target_fps 为 0（不限制）时按 60 FPS 的预算调节
+
+// 分位数：values 会被重新排列
+float percentile(std::vector<float>& values, float fraction) {
+    if (values.empty()) {
+        return 0.0f;
+    }
+    const auto index = static_cast<std::size_t>(fraction * static_cast<float>(values.size() - 1));
+    std::ranges::nth_element(values, values.begin() + static_cast<std::ptrdiff_t>(index));
+    return values[index];
+}
+
+} // namespace
+
+FrameGovernor::FrameGovernor(Settings settings) : settings_(settings) {
+    settings_.window_frames = std::max(settings_.window_frames, EVALUATE_INTERVAL);
+    work_ms_.resize(static_cast<std::size_t>(settings_.window_frames));
+    frame_ms_.resize(static_cast<std::size_t>(settings_.window_frames));
+    scratch_.reserve(static_cast<std::size_t>(settings_.window_frames));
+}
+
+FrameGovernor::FrameGovernor() : FrameGovernor(Settings{}) {
+}
+
+KnobId FrameGovernor::addKnob(std::string name, int priority, int max_level, std::function<void(int level)> apply, const void* owner) {
+    QualityKnob knob;
+    knob.id = next_knob_id_++;
+    knob.name = std::move(name);
+    knob.priority = priority;
+    knob.max_level = std::max(max_level, 0);
+    knob.apply = std::move(apply);
+    knob.owner = owner;
+    if (enabled_) {
+        const auto it = std::ranges::find(remembered_levels_, knob.name, &std::pair<std::string, int>::first);
+        if (it != remembered_levels_.end()) {
+            knob.level = std::min(it->second, knob.max_level);
+        }
+    }
+    if (knob.apply) {
+        knob.apply(knob.level);
+    }
+    const auto id = knob.id;
+    const auto position = std::ranges::upper_bound(knobs_, priority, {}, &QualityKnob::priority);
+    knobs_.insert(position, std::move(knob));
+    return id;
+}
+
+void FrameGovernor::removeKnob(KnobId id) {
+    const auto it = std::ranges::find(knobs_, id, &QualityKnob::id);
+    if (it == knobs_.end()) {
+        return;
+    }
+    const auto remembered = std::ranges::find(remembered_levels_, it->name, &std::pair<std::string, int>::first);
+    if (remembered != remembered_levels_.end()) {
+        remembered->second = it->level;
+    } else {
+        remembered_levels_.emplace_back(it->name, it->level);
+    }
+    knobs_.erase(it);
+}
+
+void FrameGovernor::removeKnobs(const void* owner) {
+    std::vector<KnobId> ids;
+    for (const auto& knob : knobs_) {
+        if (knob.owner == owner) {
+            ids.push_back(knob.id);
+        }
+    }
+    for (const auto id : ids) {
+        removeKnob(id);
+    }
+}
+
+void FrameGovernor::addFrame(float work_seconds, float frame_seconds) {
+    clock_ += frame_seconds;
+    if (!enabled_) {
+        return;
+    }
+    cooldown_left_ = std::max(cooldown_left_ - frame_seconds, 0.0f);
+    evaluate_time_ += frame_seconds;
+
+    work_ms_[sample_head_] = work_seconds * 1000.0f;
+    frame_ms_[sample_head_] = frame_seconds * 1000.0f;
+    sample_head_ = (sample_head_ + 1) % work_ms_.size();
+    sample_count_ = std::min(sample_count_ + 1, work_ms_.size());
+
+    if (--frames_until_evaluate_ <= 0) {
+        frames_until_evaluate_ = EVALUATE_INTERVAL;
+        evaluate();
+        evaluate_time_ = 0.0f;
+    }
+}
+
+void FrameGovernor::evaluate() {
+    // 调整后的冷却期内、窗口未填满一半时不做判断
+    if (cooldown_left_ > 0.0f || sample_count_ < work_ms_.size() / 2) {
+        load_ = Load::Unknown;
+        return;
+    }
+    scratch_.assign(work_ms_.begin(), work_ms_.begin() + static_cast<std::ptrdiff_t>(sample_count_));
+    work_p90_ms_ = percentile(scratch_, 0.9f);
+    scratch_.assign(frame_ms_.begin(), frame_ms_.begin() + static_cast<std::ptrdiff_t>(sample_count_));
+    frame_p90_ms_ = percentile(scratch_, 0.9f);
+
+    const float budget = getBudgetMs();
+    const bool missed = frame_p90_ms_ > budget * settings_.missed_ratio;
+    if (work_p90_ms_ > budget * settings_.downgrade_ratio || missed) {
+        load_ = Load::Over;
+        over_time_ += evaluate_time_;
+        spare_time_ = 0.0f;
+    } else if (work_p90_ms_ < budget * settings_.upgrade_ratio) {
+        load_ = Load::Spare;
+        spare_time_ += evaluate_time_;
+        over_time_ = 0.0f;
+    } else {
+        load_ = Load::Ok;
+        over_time_ = 0.0f;
+        spare_time_ = 0.0f;
+    }
+
+    if (over_time_ >= settings_.downgrade_hold) {
+        if (step(1)) {
+            clearSamples();
+        }
+        over_time_ = 0.0f;
+    } else if (spare_time_ >= settings_.upgrade_hold) {
+        if (step(-1)) {
+            clearSamples();
+        }
+        spare_time_ = 0.0f;
+    }
+}
+
+bool FrameGovernor::step(int direction) {
+    QualityKnob* target = nullptr;
+    if (direction > 0) {
+        const auto it = std::ranges::find_if(knobs_, [](const QualityKnob& knob) { return knob.level < knob.max_level; });
+        target = it != knobs_.end() ? &*it : nullptr;
+    } else {
+        const auto it = std::ranges::find_if(knobs_.rbegin(), knobs_.rend(), [](const QualityKnob& knob) { return knob.level > 0; });
+        target = it != knobs_.rend() ? &*it : nullptr;
+    }
+    if (!target) {
+        return false;
+    }
+
+    GovernorDecision& decision = decisions_[decision_count_ % DECISION_HISTORY];
+    decision.time = clock_;
+    decision.knob = target->name;
+    decision.from_level = target->level;
+    decision.to_level = target->level + direction;
+    decision.work_p90_ms = work_p90_ms_;
+    decision.frame_p90_ms = frame_p90_ms_;
+    ++decision_count_;
+    engine::utils::Metrics::add(engine::utils::Metric::QualityChanges);
+    spdlog::info("FrameGovernor: {} {} {} -> {}（工作 p90 {:.2f} ms，帧间隔 p90 {:.2f} ms，预算 {:.2f} ms）",
+                 direction > 0 ? "降低画质" : "恢复画质", target->name, decision.from_level, decision.to_level,
+                 work_p90_ms_, frame_p90_ms_, getBudgetMs());
+
+    setLevel(*target, decision.to_level);
+    return true;
+}
+
+void FrameGovernor::setLevel(QualityKnob& knob, int level) {
+    knob.level = level;
+    if (knob.apply) {
+        knob.apply(level);
+    }
+}
+
+void FrameGovernor::clearSamples() {
+    sample_head_ = 0;
+    sample_count_ = 0;
+    frames_until_evaluate_ = EVALUATE_INTERVAL;
+    cooldown_left_ = settings_.cooldown;
+    over_time_ = 0.0f;
+    spare_time_ = 0.0f;
+}
+
+void FrameGovernor::setTargetFPS(int fps) {
+    settings_.target_fps = std::max(fps, 0);
+    reset();
+}
+
+void FrameGovernor::setEnabled(bool enabled) {
+    if (enabled_ == enabled) {
+        return;
+    }
+    enabled_ = enabled;
+    if (!enabled_) {
+        for (auto& knob : knobs_) {
+            if (knob.level != 0) {
+                setLevel(knob, 0);
+            }
+        }
+        remembered_levels_.clear();
+        load_ = Load::Unknown;
+    }
+    reset();
+    spdlog::info("FrameGovernor: 自适应画质已{}。", enabled_ ? "开启" : "关闭");
+}
+
+void FrameGovernor::reset() {
+    clearSamples();
+    cooldown_left_ = 0.0f;
+}
+
+float FrameGovernor::getBudgetMs() const {
+    const float fps = settings_.target_fps > 0 ? static_cast<float>(settings_.target_fps) : DEFAULT_BUDGET_FPS;
+    return 1000.0f / fps;
+}
+
+int FrameGovernor::getTotalLevel() const {
+    int total = 0;
+    for (const auto& knob : knobs_) {
+        total += knob.level;
+    }
+    return total;
+}
+
+int FrameGovernor::getMaxTotalLevel() const {
+    int total = 0;
+    for (const auto& knob : knobs_) {
+        total += knob.max_level;
+    }
+    return total;
+}
+
+const GovernorDecision* FrameGovernor::getLastDecision() const {
+    return decision_count_ > 0 ? &decisions_[(decision_count_ - 1) % DECISION_HISTORY] : nullptr;
+}
+
+std::vector<GovernorDecision> FrameGovernor::getDecisions() const {
+    std::vector<GovernorDecision> result;
+    const auto count = std::min(decision_count_, DECISION_HISTORY);
+    result.reserve(count);
+    for (std::size_t i = decision_count_ - count; i < decision_count_; ++i) {
+        result.push_back(decisions_[i % DECISION_HISTORY]);
+    }
+    return result;
+}
+
+} // namespace engine::core
@@ -0,0 +1,168 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#ifndef SUNNYLAND_FRAME_GOVERNOR_H
+#define SUNNYLAND_FRAME_GOVERNOR_H
+
+#include <array>        // 用于 std::array
+#include <cstddef>      // 用于 std::size_t
+#include <cstdint>      // 用于 std::uint32_t
+#include <functional>   // 用于 std::function
+#include <string>       // 用于 std::string
+#include <utility>      // 用于 std::pair
+#include <vector>       // 用于 std::vector
+
+namespace engine::core {
+
+using KnobId = std::uint32_t;
+
+/**
+ * @brief 画质旋钮的降级优先级，数值小的先降、后升。
+ */
+namespace knob_priority {
+inline constexpr int PARTICLES = 0;             ///< @brief 粒子上限
+inline constexpr int OFFSCREEN_ANIMATION = 10;  ///< @brief 屏幕外实体的动画更新频率
+inline constexpr int PARALLAX = 20;             ///< @brief 视差背景层数，最影响观感，最后才降
+}
+
+/**
+ * @brief 一个可调节的画质旋钮。level 0 为最高画质，max_level 为最省的档位。
+ */
+struct QualityKnob {
+    KnobId id = 0;
+    std::string name;
+    int priority = 0;
+    int level = 0;
+    int max_level = 0;
+    std::function<void(int level)> apply;   ///< @brief 档位改变时调用（注册时也会以起始档位调用一次）
+    const void* owner = nullptr;            ///< @brief 用于按所有者批量移除（如场景 clean 时）
+};
+
+/**
+ * @brief 一次档位调整，作为遥测数据保留最近若干条。
+ */
+struct GovernorDecision {
+    double time = 0.0;          ///< @brief 距开始运行的秒数
+    std::string knob;
+    int from_level = 0;
+    int to_level = 0;
+    float work_p90_ms = 0.0f;   ///< @brief 做出决定时的帧工作时间 p90
+    float frame_p90_ms = 0.0f;  ///< @brief 做出决定时的实际帧间隔 p90
+};
+
+/**
+ * @brief 帧时间调节器：根据最近若干帧的耗时与 target_fps 的预算比较，逐档调节已注册的画质旋钮，
+ *        让低端机器稳定在目标帧率，而不是时快时慢地卡顿。
+ *
+ * 每帧输入两个时间：
+ * - 工作时间：从帧开始到提交（SDL_RenderPresent）之前的 CPU 耗时，不含帧率限制的等待和垂直同步阻塞；
+ * - 帧间隔：实际的帧间时间，用于发现 GPU 或提交阶段导致的掉帧。
+ * 每 EVALUATE_INTERVAL 帧用滚动窗口的 p90 判断一次负载：
+ * - 过载（工作 p90 > 预算 * downgrade_ratio，或帧间隔 p90 > 预算 * missed_ratio）持续 downgrade_hold 秒，
+ *   把优先级最低、尚未到底的旋钮降一档；
+ * - 有余量（工作 p90 < 预算 * upgrade_ratio 且未掉帧）持续 upgrade_hold 秒，按相反顺序升一档。
+ * 两个阈值之间留有空档、升级比降级等得更久，并且每次调整后清空窗口、冷却 cooldown 秒，避免来回振荡。
+ * 每次调整都会写日志、计入 Metric::QualityChanges，并保留在 getDecisions() 中。
+ */
+class FrameGovernor final {
+public:
+    struct Settings {
+        int target_fps = 60;
+        int window_frames = 120;        ///< @brief 滚动窗口帧数
+        float downgrade_ratio = 0.9f;   ///< @brief 工作时间留出 10% 给提交和系统开销
+        float upgrade_ratio = 0.6f;
+        float missed_ratio = 1.25f;
+        float downgrade_hold = 0.5f;    ///< @brief 持续过载多少秒后降级
+        float upgrade_hold = 3.0f;      ///< @brief 持续有余量多少秒后升级
+        float cooldown = 1.0f;          ///< @brief 每次调整后的冷却时间（秒）
+    };
+
+    enum class Load : std::uint8_t { Unknown, Over, Ok, Spare };
+
+    static constexpr int EVALUATE_INTERVAL = 10;
+    static constexpr std::size_t DECISION_HISTORY = 16;
+
+private:
+    Settings settings_;
+    bool enabled_ = true;
+    std::vector<QualityKnob> knobs_;            ///< @brief 按 priority 稳定排序
+    std::vector<std::pair<std::string, int>> remembered_levels_;   ///< @brief 已移除旋钮的名称与档位
+    KnobId next_knob_id_ = 1;
+
+    std::vector<float> work_ms_;                ///< @brief 环形缓冲区
+    std::vector<float> frame_ms_;
+    std::vector<float> scratch_;                ///< @brief 求分位数时复用
+    std::size_t sample_head_ = 0;
+    std::size_t sample_count_ = 0;
+    int frames_until_evaluate_ = EVALUATE_INTERVAL;
+
+    double clock_ = 0.0;
+    float evaluate_time_ = 0.0f;                ///< @brief 自上次评估以来经过的时间
+    float over_time_ = 0.0f;
+    float spare_time_ = 0.0f;
+    float cooldown_left_ = 0.0f;
+    float work_p90_ms_ = 0.0f;
+    float frame_p90_ms_ = 0.0f;
+    Load load_ = Load::Unknown;
+
+    std::array<GovernorDecision, DECISION_HISTORY> decisions_{};
+    std::size_t decision_count_ = 0;            ///< @brief 累计调整次数
+
+public:
+    explicit FrameGovernor(Settings settings);
+    FrameGovernor();
+
+    FrameGovernor(const FrameGovernor&) = delete;
+    FrameGovernor& operator=(const FrameGovernor&) = delete;
+    FrameGovernor(FrameGovernor&&) = delete;
+    FrameGovernor& operator=(FrameGovernor&&) = delete;
+
+    /**
+     * @brief 注册画质旋钮。同名旋钮曾被移除过时（如切换场景），从移除时的档位起步，
+     *        避免新场景以最高画质重新开始、又要经历一次降级。
+     * @param max_level 最省的档位（档位数 - 1）。
+     * @param apply 档位改变时的回调，注册时立即以初始档位调用一次。
+     * @param owner 所有者，removeKnobs(owner) 时一并移除。
+     */
+    KnobId addKnob(std::string name, int priority, int max_level, std::function<void(int level)> apply, const void* owner = nullptr);
+    void removeKnob(KnobId id);
+    void removeKnobs(const void* owner);
+
+    /**
+     * @brief 每帧调用一次。
+     * @param work_seconds 本帧工作时间（不含帧率限制和垂直同步等待）。
+     * @param frame_seconds 本帧实际帧间隔。
+     */
+    void addFrame(float work_seconds, float frame_seconds);
+
+    void setTargetFPS(int fps);
+    void setEnabled(bool enabled);                  ///< @brief 关闭时所有旋钮恢复到最高画质
+    void reset();                                   ///< @brief 清空窗口（如切换场景、窗口恢复后），不改变档位
+
+    [[nodiscard]] bool isEnabled() const { return enabled_; }
+    [[nodiscard]] float getBudgetMs() const;
+    [[nodiscard]] float getWorkP90Ms() const { return work_p90_ms_; }
+    [[nodiscard]] float getFrameP90Ms() const { return frame_p90_ms_; }
+    [[nodiscard]] Load getLoad() const { return load_; }
+    [[nodiscard]] const std::vector<QualityKnob>& getKnobs() const { return knobs_; }
+    [[nodiscard]] int getTotalLevel() const;        ///< @brief 所有旋钮档位之和，0 表示最高画质
+    [[nodiscard]] int getMaxTotalLevel() const;
+    [[nodiscard]] std::size_t getDecisionCount() const { return decision_count_; }
+    [[nodiscard]] const GovernorDecision* getLastDecision() const;      ///< @brief 没有调整过时返回 nullptr
+
+    /**
+     * @brief 最近的调整记录（从旧到新，最多 DECISION_HISTORY 条）。
+     */
+    [[nodiscard]] std::vector<GovernorDecision> getDecisions() const;
+
+private:
+    void evaluate();
+    bool step(int direction);       ///< @brief 1 降一档，-1 升一档；没有可调的旋钮时返回 false
+    void setLevel(QualityKnob& knob, int level);
+    void clearSamples();
+};
+
+} // namespace engine::core
+
+#endif //SUNNYLAND_FRAME_GOVERNOR_H
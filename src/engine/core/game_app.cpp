@@ -3,9 +3,19 @@
 //
 
 #include "game_app.h"
+#include "config.h"
 #include "time.h"
+#include "event_bus.h"
+#include "coroutine.h"
+#include "frame_governor.h"
 #include "../resource/resource_manager.h"
+#include "../render/perf_overlay.h"
+#include "../render/virtual_canvas.h"
+#include "../scene/scene_manager.h"
+#include "../utils/startup_timeline.h"
+#include <algorithm>
 #include <SDL3/SDL.h>
+#include <SDL3_mixer/SDL_mixer.h>
 #include <spdlog/spdlog.h>
 
 namespace engine::core {
@@ -25,15 +35,33 @@ void GameApp::run() {
         return;
     }
 
-    time_->setTargetFPS(144); // 设置目标帧率为144FPS
+    time_->setTargetFPS(config_->target_fps_);
 
     while (is_running_) {
-        time_->update();
+        const bool resumed = updateQuietState();
+        if (isIdle()) {
+            waitIdle();
+            continue;
+        }
+
+        // 刚离开静态状态时，空闲期间阻塞的时间不计入本帧，也不再经过帧率限制等待
+        if (resumed) {
+            time_->resumeFrame();
+        } else {
+            time_->update();
+        }
         float delta_time = time_->getDeltaTime();
 
         handleEvents();
-        update(delta_time);
+        if (isFrozen()) {
+            // 未启用 idle_throttle 时，暂停期间仍逐帧渲染，只是不推进游戏逻辑
+            perf_overlay_->update(time_->getUnscaledDeltaTime(), time_->getTargetFPS(), *resource_manager_);
+        } else {
+            update(delta_time);
+        }
         render();
+        frame_governor_->addFrame(frame_work_time_, time_->getUnscaledDeltaTime());
+        reportStartup();
 
         //spdlog::info("delta_time: {}  fps: {}", delta_time,1.0 / delta_time);
     }
@@ -42,47 +70,219 @@ void GameApp::run() {
 }
 
 bool GameApp::init() {
-    spdlog::trace("初始化 GameApp ...");
+    SPDLOG_TRACE("初始化 GameApp ...");
+    engine::utils::StartupSpan span("GameApp::init");
 
+    if (!initConfig()) { return false; }
     if (!initSDL()) { return false; }
+    presentFirstFrame();
+    if (!initCanvas()) { return false; }
     if (!initTime()) { return false; }
-    if (!initResourceManager()) { return false; }
-
-    // 测试资源管理器
-    testResourceManager();
+    if (!initFrameGovernor()) { return false; }
+    if (!initEventBus()) { return false; }
+    if (!initScheduler()) { return false; }
+    if (!initResourceManager()) { return false; }   // 音频在后台初始化，字体在首次使用时初始化
+    if (!initSceneManager()) { return false; }
+    if (!initPerfOverlay()) { return false; }
 
     is_running_ = true;
-    spdlog::trace("GameApp 初始化成功。");
+    SPDLOG_TRACE("GameApp 初始化成功。");
     return true;
 }
 
 void GameApp::handleEvents() {
     SDL_Event event;
     while (SDL_PollEvent(&event)) {
-        if (event.type == SDL_EVENT_QUIT) {
+        handleEvent(event);
+    }
+}
+
+void GameApp::handleEvent(SDL_Event& event) {
+    switch (event.type) {
+        case SDL_EVENT_QUIT:
             is_running_ = false;
+            return;
+        case SDL_EVENT_WINDOW_FOCUS_GAINED:
+            focused_ = true;
+            break;
+        case SDL_EVENT_WINDOW_FOCUS_LOST:
+            focused_ = false;
+            break;
+        case SDL_EVENT_WINDOW_MINIMIZED:
+            minimized_ = true;
+            break;
+        case SDL_EVENT_WINDOW_RESTORED:
+        case SDL_EVENT_WINDOW_MAXIMIZED:
+            minimized_ = false;
+            break;
+        default:
+            break;
+    }
+    if (event.type >= SDL_EVENT_WINDOW_FIRST && event.type <= SDL_EVENT_WINDOW_LAST) {
+        needs_redraw_ = true;       // 曝光、尺寸变化、恢复等都需要重绘
+    }
+
+    if (event.type == SDL_EVENT_KEY_DOWN && !event.key.repeat) {
+        if (event.key.key == SDLK_F3) {
+            perf_overlay_->toggle();
+            needs_redraw_ = true;
+            return;
+        }
+        if (std::ranges::find(pause_keys_, event.key.key) != pause_keys_.end()) {
+            setPaused(!paused_);
+            return;
         }
     }
+
+    // 冻结期间场景不接收输入
+    if (isFrozen()) {
+        return;
+    }
+    canvas_->convertEvent(event);
+    scene_manager_->handleEvent(event);
+    needs_redraw_ = true;
 }
 
-void GameApp::update(float dt) {
+void GameApp::waitIdle() {
+    if (needs_redraw_ && !minimized_) {
+        render();
+        needs_redraw_ = false;
+    }
+    reportStartup();
+
+    // 阻塞等待事件。超时后回到主循环重新检查状态（如后台加载开始后场景不再空闲）
+    SDL_Event event;
+    const int timeout_ms = minimized_ ? config_->idle_timeout_ms_ * 4 : config_->idle_timeout_ms_;
+    if (!SDL_WaitEventTimeout(&event, timeout_ms)) {
+        return;
+    }
+    handleEvent(event);
+    while (SDL_PollEvent(&event)) {
+        handleEvent(event);
+    }
 
+    // 空闲的场景（菜单等）没有被冻结：收到输入后推进一帧，让场景响应
+    if (is_running_ && !isFrozen()) {
+        time_->resumeFrame();
+        update(time_->getDeltaTime());
+        needs_redraw_ = true;
+    }
+}
+
+bool GameApp::updateQuietState() {
+    const bool quiet = isQuiet();
+    if (quiet == quiet_) {
+        return false;
+    }
+    quiet_ = quiet;
+    if (quiet) {
+        quiet_cpu_.restart();
+        idle_renders_ = 0;
+        needs_redraw_ = true;
+        SPDLOG_DEBUG("画面进入静态状态（{}）。", isIdle() ? "事件驱动" : "逐帧循环");
+        return false;
+    }
+    spdlog::info("画面离开静态状态：持续 {:.1f} s，渲染 {} 次，CPU 占用 {:.1f}%（idle_throttle {}）。",
+                 quiet_cpu_.getElapsedSeconds(), idle_renders_, quiet_cpu_.getUsagePercent(),
+                 config_->idle_throttle_ ? "开" : "关");
+    // 空闲期间的帧时间不让帧时间调节器看到
+    frame_governor_->reset();
+    return true;
+}
+
+void GameApp::reportStartup() {
+    // 后台的音频初始化结束后输出一次启动时间线
+    if (!startup_reported_ && !resource_manager_->isAudioPending()) {
+        startup_reported_ = true;
+        engine::utils::StartupTimeline::mark("启动完成（音频就绪）");
+        engine::utils::StartupTimeline::report();
+    }
+}
+
+void GameApp::setPaused(bool paused) {
+    if (paused_ == paused) {
+        return;
+    }
+    paused_ = paused;
+    needs_redraw_ = true;
+    spdlog::info(paused ? "游戏已暂停。" : "游戏继续。");
+}
+
+bool GameApp::isFrozen() const {
+    return paused_ || minimized_ || (!focused_ && config_->pause_on_focus_loss_);
+}
+
+bool GameApp::isQuiet() const {
+    return isFrozen() || scene_manager_->isIdle();
+}
+
+bool GameApp::isIdle() const {
+    return config_->idle_throttle_ && isQuiet();
+}
+
+void GameApp::update(float dt) {
+    scene_manager_->update(dt);
+    event_bus_->dispatch();     // 本帧 update 中发布的游戏事件在这里成批分发
+    scheduler_->update(dt);     // 在分发之后恢复协程，waitEvent() 当帧就能收到事件
+    perf_overlay_->update(time_->getUnscaledDeltaTime(), time_->getTargetFPS(), *resource_manager_);
 }
 
 void GameApp::render() {
+    // 场景画在低分辨率画布上，再一次性整数倍放大到窗口
+    canvas_->begin();
+    scene_manager_->render(sdl_renderer_);
+    canvas_->present();
+    if (paused_) {
+        renderPauseOverlay();
+    }
+    ++idle_renders_;
 
+    // 性能面板最后绘制，覆盖在所有内容之上（按窗口分辨率绘制，保证文字清晰）
+    perf_overlay_->render(sdl_renderer_);
+    frame_work_time_ = time_->getFrameWorkTime();   // 不计入提交时的垂直同步等待
+    SDL_RenderPresent(sdl_renderer_);
 }
 
 void GameApp::close() {
+    // 场景持有资源的引用，必须先于资源管理器销毁
+    if (scene_manager_) {
+        scene_manager_.reset();
+    }
+
+    if (perf_overlay_) {
+        perf_overlay_.reset();
+    }
+
+    if (frame_governor_) {
+        frame_governor_.reset();
+    }
+
+    if (canvas_) {
+        canvas_.reset();
+    }
+
     if (resource_manager_) {
         resource_manager_.reset();
     }
 
+    // 调度器持有事件总线的订阅，必须先于事件总线销毁
+    if (scheduler_) {
+        scheduler_.reset();
+    }
+
+    if (event_bus_) {
+        event_bus_.reset();
+    }
+
     if (time_) {
         time_.reset();
     }
 
-    spdlog::trace("关闭 GameApp ...");
+    if (config_) {
+        config_.reset();
+    }
+
+    SPDLOG_TRACE("关闭 GameApp ...");
     if (sdl_renderer_) {
         SDL_DestroyRenderer(sdl_renderer_);
         sdl_renderer_ = nullptr;
@@ -91,6 +291,7 @@ void GameApp::close() {
         SDL_DestroyWindow(window_);
         window_ = nullptr;
     }
+    MIX_Quit();
     SDL_Quit();
     is_running_ = false;
 }
@@ -99,23 +300,79 @@ bool GameApp::initSDL() {
     // 设置音频输出器为 PulseAudio 和 ALSA，优先使用 PulseAudio
     SDL_SetHint(SDL_HINT_AUDIO_DRIVER, "pulseaudio,alsa");
 
-    if (!SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO)) {
-        spdlog::error("SDL 初始化失败! SDL错误: {}", SDL_GetError());
-        return false;
+    {
+        engine::utils::StartupSpan span("SDL_Init(VIDEO)");
+        if (!SDL_Init(SDL_INIT_VIDEO)) {
+            spdlog::error("SDL 初始化失败! SDL错误: {}", SDL_GetError());
+            return false;
+        }
+    }
+    // SDL 子系统只能在主线程初始化；耗时的打开音频设备由 AudioManager 在后台线程完成。
+    // 失败时不中止启动，AudioManager 随后创建失败，游戏没有声音
+    {
+        engine::utils::StartupSpan span("SDL_InitSubSystem(AUDIO) + MIX_Init");
+        if (!SDL_InitSubSystem(SDL_INIT_AUDIO)) {
+            spdlog::error("SDL 音频子系统初始化失败! SDL错误: {}", SDL_GetError());
+        } else if (!MIX_Init()) {
+            spdlog::error("SDL_mixer 初始化失败! SDL错误: {}", SDL_GetError());
+        }
     }
 
-    window_ = SDL_CreateWindow("SunnyLand", 1280, 720, SDL_WINDOW_RESIZABLE);
+    {
+        engine::utils::StartupSpan span("创建窗口");
+        window_ = SDL_CreateWindow(config_->window_title_.c_str(), config_->window_width_, config_->window_height_,
+                                   config_->window_resizable_ ? SDL_WINDOW_RESIZABLE : 0);
+    }
     if (window_ == nullptr) {
         spdlog::error("无法创建窗口! SDL错误: {}", SDL_GetError());
         return false;
     }
 
-    sdl_renderer_ = SDL_CreateRenderer(window_, nullptr);
+    {
+        engine::utils::StartupSpan span("创建渲染器");
+        sdl_renderer_ = SDL_CreateRenderer(window_, nullptr);
+    }
     if (sdl_renderer_ == nullptr) {
         spdlog::error("无法创建渲染器! SDL错误: {}", SDL_GetError());
         return false;
     }
-    spdlog::trace("SDL 初始化成功。");
+    if (!SDL_SetRenderVSync(sdl_renderer_, config_->vsync_enabled_ ? 1 : SDL_RENDERER_VSYNC_DISABLED)) {
+        spdlog::warn("无法设置垂直同步: {}", SDL_GetError());
+    }
+
+    // 暂停键取自 config.json 的 pause 动作，鼠标按键等非键盘名称忽略
+    if (const auto it = config_->input_mappings_.find("pause"); it != config_->input_mappings_.end()) {
+        for (const auto& name : it->second) {
+            if (const auto key = SDL_GetKeyFromName(name.c_str()); key != SDLK_UNKNOWN) {
+                pause_keys_.push_back(key);
+            }
+        }
+    }
+    SPDLOG_TRACE("SDL 初始化成功。");
+    return true;
+}
+
+bool GameApp::initConfig() {
+    try {
+        config_ = std::make_unique<Config>();
+    } catch (const std::exception& e) {
+        spdlog::error("初始化配置失败: {}", e.what());
+        return false;
+    }
+    config_->loadFromFile("assets/config.json");    // 读取失败时使用默认配置
+    SPDLOG_TRACE("配置初始化成功。");
+    return true;
+}
+
+bool GameApp::initCanvas() {
+    try {
+        canvas_ = std::make_unique<engine::render::VirtualCanvas>(
+            sdl_renderer_, glm::ivec2(config_->logical_width_, config_->logical_height_));
+    } catch (const std::exception& e) {
+        spdlog::error("初始化虚拟画布失败: {}", e.what());
+        return false;
+    }
+    SPDLOG_TRACE("虚拟画布初始化成功。");
     return true;
 }
 
@@ -126,31 +383,110 @@ bool GameApp::initTime() {
         spdlog::error("初始化时间管理失败: {}", e.what());
         return false;
     }
-    spdlog::trace("时间管理初始化成功。");
+    SPDLOG_TRACE("时间管理初始化成功。");
     return true;
 }
 
+bool GameApp::initFrameGovernor() {
+    try {
+        FrameGovernor::Settings settings;
+        settings.target_fps = config_->target_fps_;
+        frame_governor_ = std::make_unique<FrameGovernor>(settings);
+    } catch (const std::exception& e) {
+        spdlog::error("初始化帧时间调节器失败: {}", e.what());
+        return false;
+    }
+    frame_governor_->setEnabled(config_->adaptive_quality_);
+    SPDLOG_TRACE("帧时间调节器初始化成功。");
+    return true;
+}
+
+bool GameApp::initEventBus() {
+    try {
+        event_bus_ = std::make_unique<engine::core::EventBus>();
+    } catch (const std::exception& e) {
+        spdlog::error("初始化事件总线失败: {}", e.what());
+        return false;
+    }
+    SPDLOG_TRACE("事件总线初始化成功。");
+    return true;
+}
+
+bool GameApp::initScheduler() {
+    try {
+        scheduler_ = std::make_unique<engine::core::CoroutineScheduler>(*event_bus_);
+    } catch (const std::exception& e) {
+        spdlog::error("初始化协程调度器失败: {}", e.what());
+        return false;
+    }
+    SPDLOG_TRACE("协程调度器初始化成功。");
+    return true;
+}
 
 bool GameApp::initResourceManager() {
+    engine::utils::StartupSpan span("资源管理器");
     try {
         resource_manager_ = std::make_unique<engine::resource::ResourceManager>(sdl_renderer_);
     } catch (const std::exception& e) {
         spdlog::error("初始化资源管理器失败: {}", e.what());
         return false;
     }
-    spdlog::trace("资源管理器初始化成功。");
+    SPDLOG_TRACE("资源管理器初始化成功。");
     return true;
 }
 
-void GameApp::testResourceManager()
-{
-    resource_manager_->getTexture("assets/textures/Actors/eagle-attack.png");
-    resource_manager_->getFont("assets/fonts/VonwaonBitmap-16px.ttf", 16);
-    resource_manager_->getSound("assets/audio/button_click.wav");
+bool GameApp::initSceneManager() {
+    engine::utils::StartupSpan span("场景管理器");
+    try {
+        scene_manager_ = std::make_unique<engine::scene::SceneManager>(*resource_manager_, *event_bus_, *frame_governor_, *scheduler_, *canvas_);
+    } catch (const std::exception& e) {
+        spdlog::error("初始化场景管理器失败: {}", e.what());
+        return false;
+    }
+    SPDLOG_TRACE("场景管理器初始化成功。");
+    return true;
+}
+
+bool GameApp::initPerfOverlay() {
+    try {
+        perf_overlay_ = std::make_unique<engine::render::PerfOverlay>();
+        perf_overlay_->setGovernor(frame_governor_.get());
+    } catch (const std::exception& e) {
+        spdlog::error("初始化性能面板失败: {}", e.what());
+        return false;
+    }
+    SPDLOG_TRACE("性能面板初始化成功，按 F3 切换显示。");
+    return true;
+}
+
+void GameApp::presentFirstFrame() {
+    // 窗口一出现就有内容，不必等资源管理器等子系统
+    SDL_SetRenderDrawColor(sdl_renderer_, 0, 0, 0, 255);
+    SDL_RenderClear(sdl_renderer_);
+    SDL_RenderPresent(sdl_renderer_);
+    engine::utils::StartupTimeline::mark("首帧");
+    spdlog::info("首帧已显示（自进程启动 {:.1f} ms）。", engine::utils::StartupTimeline::getElapsedMs());
+}
 
-    resource_manager_->unloadTexture("assets/textures/Actors/eagle-attack.png");
-    resource_manager_->unloadFont("assets/fonts/VonwaonBitmap-16px.ttf", 16);
-    resource_manager_->unloadSound("assets/audio/button_click.wav");
+void GameApp::renderPauseOverlay() {
+    // 在放大后的画面上压暗并居中显示提示，用内置 8x8 字体放大 PAUSE_TEXT_SCALE 倍，无需加载字体
+    constexpr float PAUSE_TEXT_SCALE = 3.0f;
+    constexpr const char* PAUSE_TEXT = "PAUSED";
+    int width = 0;
+    int height = 0;
+    SDL_GetRenderOutputSize(sdl_renderer_, &width, &height);
+
+    const SDL_FRect screen{0.0f, 0.0f, static_cast<float>(width), static_cast<float>(height)};
+    SDL_SetRenderDrawBlendMode(sdl_renderer_, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(sdl_renderer_, 0, 0, 0, 128);
+    SDL_RenderFillRect(sdl_renderer_, &screen);
+
+    const float text_width = 8.0f * static_cast<float>(SDL_strlen(PAUSE_TEXT));
+    SDL_SetRenderScale(sdl_renderer_, PAUSE_TEXT_SCALE, PAUSE_TEXT_SCALE);
+    SDL_SetRenderDrawColor(sdl_renderer_, 255, 255, 255, 255);
+    SDL_RenderDebugText(sdl_renderer_, (screen.w / PAUSE_TEXT_SCALE - text_width) * 0.5f,
+                        (screen.h / PAUSE_TEXT_SCALE - 8.0f) * 0.5f, PAUSE_TEXT);
+    SDL_SetRenderScale(sdl_renderer_, 1.0f, 1.0f);
 }
 
 }
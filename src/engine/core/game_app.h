@@ -4,28 +4,65 @@
 
 #ifndef SUNNYLAND_GAME_APP_H
 #define SUNNYLAND_GAME_APP_H
+#include "../utils/cpu_usage.h"
 #include <memory>
+#include <vector>
+#include <SDL3/SDL_keycode.h>
 
 struct SDL_Window;
 struct SDL_Renderer;
+union SDL_Event;
 
 namespace engine::resource {
     class ResourceManager;
 }
 
+namespace engine::render {
+    class PerfOverlay;
+    class VirtualCanvas;
+}
+
+namespace engine::scene {
+    class SceneManager;
+}
+
 namespace engine::core {
 
+class Config;
 class Time;
+class EventBus;
+class FrameGovernor;
+class CoroutineScheduler;
 
 class GameApp final {
 private:
     SDL_Window* window_ = nullptr;
     SDL_Renderer* sdl_renderer_ = nullptr;
     bool is_running_ = false;
+    bool startup_reported_ = false;     ///< @brief 启动时间线是否已输出（等后台音频初始化结束后输出一次）
+
+    float frame_work_time_ = 0.0f;          ///< @brief 本帧提交前的工作时间（秒）
+
+    // 暂停与空闲状态
+    bool paused_ = false;                   ///< @brief 玩家按下暂停键（config.json 中的 pause 动作）
+    bool focused_ = true;
+    bool minimized_ = false;
+    bool quiet_ = false;                    ///< @brief 上一次循环时是否处于静态状态（用于统计 CPU 占用）
+    bool needs_redraw_ = true;              ///< @brief 空闲时只有画面变化（输入、窗口曝光、暂停切换等）才重绘
+    int idle_renders_ = 0;                  ///< @brief 本次静态状态中的渲染次数
+    std::vector<SDL_Keycode> pause_keys_;
+    engine::utils::CpuMeter quiet_cpu_;     ///< @brief 本次静态状态开始以来的 CPU 占用
 
     // 引擎组件
+    std::unique_ptr<engine::core::Config> config_;
     std::unique_ptr<engine::core::Time> time_;
+    std::unique_ptr<engine::core::FrameGovernor> frame_governor_;   ///< @brief 帧时间超出预算时逐档降低画质
+    std::unique_ptr<engine::render::VirtualCanvas> canvas_;         ///< @brief 低分辨率画布，场景画在上面再整数倍放大
+    std::unique_ptr<engine::core::EventBus> event_bus_;         ///< @brief 游戏事件总线，每帧 update 之后分发
+    std::unique_ptr<engine::core::CoroutineScheduler> scheduler_;   ///< @brief 游戏脚本 / AI 协程，事件分发之后恢复
     std::unique_ptr<engine::resource::ResourceManager> resource_manager_;
+    std::unique_ptr<engine::scene::SceneManager> scene_manager_;
+    std::unique_ptr<engine::render::PerfOverlay> perf_overlay_;     ///< @brief 性能面板，F3 切换显示
 
 public:
     GameApp();
@@ -45,18 +82,31 @@ public:
 private:
     [[nodiscard]] bool init();
     void handleEvents();
+    void handleEvent(SDL_Event& event);
+    void waitIdle();            ///< @brief 空闲时：需要时重绘一次，然后阻塞等待事件
+    bool updateQuietState();    ///< @brief 进入/离开静态状态时记录日志和 CPU 占用，刚离开时返回 true
+    void reportStartup();
+    void setPaused(bool paused);
+    [[nodiscard]] bool isFrozen() const;    ///< @brief 游戏逻辑是否停止（暂停、最小化、失去焦点）
+    [[nodiscard]] bool isQuiet() const;     ///< @brief 画面是否静止（冻结，或栈顶场景空闲）
+    [[nodiscard]] bool isIdle() const;      ///< @brief 是否改为按事件驱动的空闲循环（isQuiet() 且启用了 idle_throttle）
     void update(float dt);
     void render();
     void close();
 
     // 各模块的初始化/创建函数，在init()中调用
+    bool initConfig();
     bool initSDL();
     bool initTime();
+    bool initFrameGovernor();
+    bool initCanvas();
+    bool initEventBus();
+    bool initScheduler();
     bool initResourceManager();
-
-    // 测试用函数
-    void testResourceManager();
-
+    bool initSceneManager();
+    bool initPerfOverlay();
+    void presentFirstFrame();   ///< @brief 渲染器就绪后立即显示一帧，不等待其余子系统
+    void renderPauseOverlay();
 };
 
 
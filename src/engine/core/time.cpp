@@ -10,7 +10,7 @@ namespace engine::core {
 Time::Time() {
     last_time_ = SDL_GetTicksNS();
     frame_start_time_ = last_time_;
-    spdlog::trace("Time 初始化。Last time: {}", last_time_);
+    SPDLOG_TRACE("Time 初始化。Last time: {}", last_time_);
 }
 
 void Time::update() {
@@ -38,6 +38,12 @@ void Time::limitFrameRate(float current_delta_time) {
     delta_time_ = static_cast<double>(SDL_GetTicksNS() - last_time_) / 1000000000.0;
 }
 
+void Time::resumeFrame() {
+    frame_start_time_ = SDL_GetTicksNS();
+    last_time_ = frame_start_time_;
+    delta_time_ = target_frame_time_ > 0.0 ? target_frame_time_ : 1.0 / 60.0;
+}
+
 float Time::getDeltaTime() const {
     return static_cast<float>(delta_time_ * time_scale_);
 }
@@ -46,6 +52,10 @@ float Time::getUnscaledDeltaTime() const {
     return static_cast<float>(delta_time_);
 }
 
+float Time::getFrameWorkTime() const {
+    return static_cast<float>(SDL_GetTicksNS() - last_time_) / 1'000'000'000.0f;
+}
+
 void Time::setTimeScale(double scale) {
     time_scale_ = scale;
 }
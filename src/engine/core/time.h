@@ -33,6 +33,14 @@ public:
      */
     void update();
 
+    /**
+     * @brief 长时间阻塞（如空闲等待事件）之后代替 update() 开始新的一帧。
+     *
+     * delta_time 取目标帧时间（不限帧率时取 1/60 秒），阻塞的时间不计入；不经过帧率限制，
+     * 否则 update() 会看到接近 0 的帧间时间并多等待一整帧，给唤醒后的输入增加延迟。
+     */
+    void resumeFrame();
+
     /**
      * @brief 获取当前帧的 delta_time（秒），已经应用时间缩放
      */
@@ -43,6 +51,10 @@ public:
      */
     [[nodiscard]] float getUnscaledDeltaTime() const;
 
+    /**
+     * @brief 获取本帧从 update() 返回到现在的耗时（秒），即不含帧率限制等待的工作时间
+     */
+    [[nodiscard]] float getFrameWorkTime() const;
 
     /**
      * @brief 设置时间缩放因子，默认值为 1.0（正常速度）
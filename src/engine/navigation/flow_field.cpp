@@ -0,0 +1,200 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#include "flow_field.h"
+#include <algorithm>
+#include <functional>
+#include <spdlog/spdlog.h>
+
+namespace engine::navigation {
+
+namespace {
+
+glm::vec2 safeNormalize(const glm::vec2& v) {
+    const float length = glm::length(v);
+    return length > 1e-4f ? v / length : glm::vec2(0.0f);
+}
+
+} // namespace
+
+FlowField::FlowField(const NavigationGrid& grid, NavAgentType agent_type, int cluster_size, int max_nodes_per_update)
+    : grid_(grid), agent_type_(agent_type), cluster_size_(std::max(cluster_size, 1)),
+      max_nodes_per_update_(std::max(max_nodes_per_update, 1)) {
+}
+
+void FlowField::setTarget(const glm::vec2& world_pos) {
+    target_position_ = world_pos;
+    if (!grid_.isValid()) {
+        return;
+    }
+    const auto map_size = grid_.getMapSize();
+    const auto cell = glm::clamp(grid_.worldToCell(world_pos), glm::ivec2(0), map_size - 1);
+    requested_cluster_ = cell / cluster_size_;
+    // 计算进行中不打断：重新开始会丢掉已展开的节点，目标持续跨簇时流场永远算不完
+    if (!building_ && requested_cluster_ != target_cluster_) {
+        target_cluster_ = requested_cluster_;
+        beginBuild();
+    }
+}
+
+bool FlowField::update() {
+    if (!building_) {
+        return false;
+    }
+    for (int expanded = 0; expanded < max_nodes_per_update_ && !heap_.empty(); ++expanded) {
+        std::pop_heap(heap_.begin(), heap_.end(), std::greater<>{});
+        const auto entry = heap_.back();
+        heap_.pop_back();
+        if (entry.cost > building_costs_[entry.cell]) {
+            continue;   // 过期条目：该格已经以更低的代价展开过
+        }
+        ++current_build_nodes_;
+        if (agent_type_ == NavAgentType::Flyer) {
+            expandFlyer(entry.cell, entry.cost);
+        } else {
+            for (auto* edge = grid_.reverseEdgesBegin(entry.cell); edge != grid_.reverseEdgesEnd(entry.cell); ++edge) {
+                relax(edge->cell, entry.cell, entry.cost + edge->cost, edge->move);
+            }
+        }
+    }
+    if (!heap_.empty()) {
+        return false;
+    }
+
+    // 计算完成，一次性切换到新流场；旧缓冲区留作下一轮计算复用
+    steps_.swap(building_steps_);
+    costs_.swap(building_costs_);
+    active_cluster_ = target_cluster_;
+    building_ = false;
+    ready_ = true;
+    ++generation_;
+    last_build_nodes_ = current_build_nodes_;
+    SPDLOG_TRACE("流场计算完成：目标簇 ({}, {})，展开节点 {}", active_cluster_.x, active_cluster_.y, last_build_nodes_);
+
+    // 计算期间目标已移到别的簇：接着为最新的簇计算
+    if (requested_cluster_ != target_cluster_) {
+        target_cluster_ = requested_cluster_;
+        beginBuild();
+    }
+    return true;
+}
+
+void FlowField::complete() {
+    while (building_) {
+        update();
+    }
+}
+
+NavDirection FlowField::query(const glm::vec2& world_pos) const {
+    const auto cell = lookupCell(world_pos);
+    if (cell == UNREACHABLE) {
+        return {};
+    }
+    const auto& step = steps_[cell];
+    NavDirection result;
+    result.move = step.move;
+    if (step.next == cell) {
+        result.move = NavMove::Arrived;
+        result.waypoint = target_position_;
+    } else {
+        result.waypoint = grid_.cellCenter(step.next);
+    }
+    result.direction = safeNormalize(result.waypoint - world_pos);
+    return result;
+}
+
+std::uint32_t FlowField::getCost(int x, int y) const {
+    if (!ready_ || !grid_.inBounds(x, y)) {
+        return UNREACHABLE;
+    }
+    return costs_[grid_.cellIndex(x, y)];
+}
+
+void FlowField::beginBuild() {
+    const auto cell_count = grid_.getCellCount();
+    building_costs_.assign(cell_count, UNREACHABLE);
+    building_steps_.assign(cell_count, Step{});
+    heap_.clear();
+    current_build_nodes_ = 0;
+    building_ = true;
+
+    // 簇内所有可达格都是起点
+    const auto map_size = grid_.getMapSize();
+    const glm::ivec2 begin = target_cluster_ * cluster_size_;
+    const glm::ivec2 end = glm::min(begin + cluster_size_, map_size);
+    for (int y = begin.y; y < end.y; ++y) {
+        for (int x = begin.x; x < end.x; ++x) {
+            const auto cell = grid_.cellIndex(x, y);
+            if (isNode(cell)) {
+                building_costs_[cell] = 0;
+                building_steps_[cell] = {cell, NavMove::Arrived};
+                heap_.push_back({0, cell});
+            }
+        }
+    }
+    std::make_heap(heap_.begin(), heap_.end(), std::greater<>{});
+}
+
+void FlowField::relax(std::uint32_t from, std::uint32_t to, std::uint32_t cost, NavMove move) {
+    if (cost >= building_costs_[from]) {
+        return;
+    }
+    building_costs_[from] = cost;
+    building_steps_[from] = {to, move};
+    heap_.push_back({cost, from});
+    std::push_heap(heap_.begin(), heap_.end(), std::greater<>{});
+}
+
+void FlowField::expandFlyer(std::uint32_t cell, std::uint32_t cost) {
+    const auto coord = grid_.cellCoord(cell);
+    const auto open = [this](int x, int y) {
+        return grid_.inBounds(x, y) && isNode(grid_.cellIndex(x, y));
+    };
+    for (int dy = -1; dy <= 1; ++dy) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            if (dx == 0 && dy == 0) {
+                continue;
+            }
+            const int nx = coord.x + dx;
+            const int ny = coord.y + dy;
+            if (!open(nx, ny)) {
+                continue;
+            }
+            const bool diagonal = dx != 0 && dy != 0;
+            if (diagonal && (!open(coord.x + dx, coord.y) || !open(coord.x, coord.y + dy))) {
+                continue;   // 不允许贴着墙角斜穿
+            }
+            relax(grid_.cellIndex(nx, ny), cell, cost + (diagonal ? 14 : 10), NavMove::Fly);
+        }
+    }
+}
+
+bool FlowField::isNode(std::uint32_t cell) const {
+    const auto flags = grid_.getFlags(cell);
+    if (agent_type_ == NavAgentType::Walker) {
+        return (flags & tile_flag::STANDABLE) != 0;
+    }
+    return (flags & (tile_flag::SOLID | tile_flag::SLOPE)) == 0;
+}
+
+std::uint32_t FlowField::lookupCell(const glm::vec2& world_pos) const {
+    if (!ready_) {
+        return UNREACHABLE;
+    }
+    const auto cell = grid_.worldToCell(world_pos);
+    // 行走单位在跳跃/下落途中所在的格子可能不是节点，退而查询正下方一格
+    const int probe_count = agent_type_ == NavAgentType::Walker ? 2 : 1;
+    for (int i = 0; i < probe_count; ++i) {
+        if (!grid_.inBounds(cell.x, cell.y + i)) {
+            continue;
+        }
+        const auto index = grid_.cellIndex(cell.x, cell.y + i);
+        if (costs_[index] != UNREACHABLE) {
+            return index;
+        }
+    }
+    return UNREACHABLE;
+}
+
+} // namespace engine::navigation
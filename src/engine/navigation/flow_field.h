@@ -0,0 +1,137 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#ifndef SUNNYLAND_FLOW_FIELD_H
+#define SUNNYLAND_FLOW_FIELD_H
+
+#include "navigation_grid.h"
+#include <cstdint>      // 用于 std::uint32_t
+#include <limits>       // 用于 std::numeric_limits
+#include <vector>       // 用于 std::vector
+#include <glm/glm.hpp>
+
+namespace engine::navigation {
+
+enum class NavAgentType : std::uint8_t { Walker, Flyer };
+
+/**
+ * @brief 查询结果：下一步朝哪里走、做什么动作。
+ */
+struct NavDirection {
+    glm::vec2 direction{0.0f};      ///< @brief 指向下一个路点的单位向量
+    glm::vec2 waypoint{0.0f};       ///< @brief 下一个格子中心的世界坐标（Arrived 时为目标位置）
+    NavMove move = NavMove::None;   ///< @brief None 表示当前位置不可达目标
+};
+
+/**
+ * @brief 指向一个共享目标（如玩家）的流场，所有追踪该目标的敌人共用一份。
+ *
+ * - 目标按 cluster_size x cluster_size 个图块量化：目标在同一个簇内移动时流场保持不变，
+ *   只有跨簇时才重新计算。计算进行中目标再次跨簇时不会从头重来，只记下最新的目标簇，
+ *   本轮完成后再开始下一轮，因此目标在簇边界来回移动时流场仍能持续更新；簇内的所有可达格都作为起点（代价为 0），进入目标簇的单位
+ *   得到 NavMove::Arrived，由游戏层直接朝目标位置移动。
+ * - 重新计算是分帧进行的 Dijkstra：update() 每次最多展开 max_nodes_per_update 个节点，
+ *   完成前查询继续使用上一份流场，完成后一次性切换，单帧开销有上限。
+ * - query() 只做一次坐标换算和数组读取，O(1)，适合几百个单位每帧查询。
+ */
+class FlowField final {
+public:
+    static constexpr std::uint32_t UNREACHABLE = std::numeric_limits<std::uint32_t>::max();
+
+private:
+    struct Step {
+        std::uint32_t next = UNREACHABLE;   ///< @brief 下一个格子，簇内格子为自身
+        NavMove move = NavMove::None;
+    };
+
+    struct HeapEntry {
+        std::uint32_t cost;
+        std::uint32_t cell;
+        bool operator>(const HeapEntry& other) const { return cost > other.cost; }
+    };
+
+    const NavigationGrid& grid_;
+    NavAgentType agent_type_;
+    int cluster_size_;
+    int max_nodes_per_update_;
+
+    glm::vec2 target_position_{0.0f};
+    glm::ivec2 requested_cluster_{-1};      ///< @brief 最近一次 setTarget() 所在的目标簇
+    glm::ivec2 target_cluster_{-1};         ///< @brief 正在计算（或最近一次计算）的流场所对应的目标簇
+    glm::ivec2 active_cluster_{-1};         ///< @brief 已生效流场所对应的目标簇
+
+    // --- 已生效的流场 ---
+    std::vector<Step> steps_;
+    std::vector<std::uint32_t> costs_;
+
+    // --- 正在分帧计算的流场 ---
+    std::vector<Step> building_steps_;
+    std::vector<std::uint32_t> building_costs_;
+    std::vector<HeapEntry> heap_;
+    bool building_ = false;
+    bool ready_ = false;
+
+    // --- 统计 ---
+    std::uint32_t generation_ = 0;          ///< @brief 每完成一次计算加 1
+    std::uint32_t last_build_nodes_ = 0;    ///< @brief 上一次完整计算展开的节点数
+    std::uint32_t current_build_nodes_ = 0;
+
+public:
+    /**
+     * @brief 构造函数。
+     * @param grid 共享的导航网格，生命周期必须长于流场。
+     * @param agent_type 行走单位使用平台图，飞行单位使用 8 邻域网格。
+     * @param cluster_size 目标量化的簇大小（图块）。
+     * @param max_nodes_per_update update() 单次最多展开的节点数。
+     */
+    FlowField(const NavigationGrid& grid, NavAgentType agent_type, int cluster_size = 8, int max_nodes_per_update = 4096);
+
+    FlowField(const FlowField&) = delete;
+    FlowField& operator=(const FlowField&) = delete;
+    FlowField(FlowField&&) = delete;
+    FlowField& operator=(FlowField&&) = delete;
+
+    /**
+     * @brief 更新目标位置（每帧调用即可）。目标跨簇时开始新一轮分帧计算；已有计算在进行时排队到其完成后。
+     */
+    void setTarget(const glm::vec2& world_pos);
+
+    /**
+     * @brief 推进正在进行的计算。目标不变时没有任何开销。
+     * @return 本次调用完成了一份新流场时返回 true。
+     */
+    bool update();
+
+    /**
+     * @brief 在分帧计算未完成时强制算完（如关卡刚加载、还没有可用流场时）。
+     */
+    void complete();
+
+    /**
+     * @brief 查询某个世界坐标处应当朝哪个方向移动。
+     */
+    [[nodiscard]] NavDirection query(const glm::vec2& world_pos) const;
+
+    /**
+     * @brief 获取某格到目标簇的代价，不可达时为 UNREACHABLE。
+     */
+    [[nodiscard]] std::uint32_t getCost(int x, int y) const;
+
+    [[nodiscard]] bool isReady() const { return ready_; }
+    [[nodiscard]] bool isBuilding() const { return building_; }
+    [[nodiscard]] std::uint32_t getGeneration() const { return generation_; }
+    [[nodiscard]] std::uint32_t getLastBuildNodes() const { return last_build_nodes_; }
+    [[nodiscard]] NavAgentType getAgentType() const { return agent_type_; }
+
+private:
+    void beginBuild();
+    void relax(std::uint32_t from, std::uint32_t to, std::uint32_t cost, NavMove move);
+    void expandFlyer(std::uint32_t cell, std::uint32_t cost);
+    [[nodiscard]] bool isNode(std::uint32_t cell) const;
+    [[nodiscard]] std::uint32_t lookupCell(const glm::vec2& world_pos) const;
+};
+
+} // namespace engine::navigation
+
+#endif //SUNNYLAND_FLOW_FIELD_H
@@ -0,0 +1,285 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#include "navigation_grid.h"
+#include <algorithm>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+namespace engine::navigation {
+
+namespace {
+
+constexpr std::uint8_t SUPPORT_BELOW = tile_flag::SOLID | tile_flag::ONE_WAY | tile_flag::SLOPE | tile_flag::LADDER;
+
+struct ForwardEdge {
+    std::uint32_t from = 0;
+    NavEdge edge;
+};
+
+bool loadJson(const std::string& path, nlohmann::json& out) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        spdlog::error("无法打开文件: {}", path);
+        return false;
+    }
+    try {
+        file >> out;
+    } catch (const nlohmann::json::parse_error& e) {
+        spdlog::error("解析 JSON 文件 '{}' 失败: {}", path, e.what());
+        return false;
+    }
+    return true;
+}
+
+// 返回子节点的引用；不存在时返回一个静态空数组（json::value() 返回副本，不能用于保存指针）
+const nlohmann::json& childArray(const nlohmann::json& json, const char* key) {
+    static const nlohmann::json empty = nlohmann::json::array();
+    auto it = json.find(key);
+    return it != json.end() ? *it : empty;
+}
+
+const nlohmann::json* findTileLayer(const nlohmann::json& layers_json, const std::string& name) {
+    for (const auto& layer : layers_json) {
+        const std::string type = layer.value("type", "");
+        if (type == "tilelayer" && layer.value("name", "") == name) {
+            return &layer;
+        }
+        if (type == "group") {
+            if (const auto* found = findTileLayer(childArray(layer, "layers"), name)) {
+                return found;
+            }
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+bool NavigationGrid::loadFromMap(const std::string& map_path, const std::string& layer_name, WalkerSettings settings) {
+    engine::scene::TileTable tiles;
+    if (!tiles.compile(map_path)) {
+        return false;
+    }
+    return loadFromMap(map_path, tiles, layer_name, settings);
+}
+
+bool NavigationGrid::loadFromMap(const std::string& map_path, const engine::scene::TileTable& tiles, const std::string& layer_name,
+                                 WalkerSettings settings) {
+    nlohmann::json map_json;
+    if (!loadJson(map_path, map_json)) {
+        return false;
+    }
+    const auto* layer = findTileLayer(childArray(map_json, "layers"), layer_name);
+    if (!layer) {
+        spdlog::error("地图 '{}' 中找不到图块层 '{}'", map_path, layer_name);
+        return false;
+    }
+
+    const glm::ivec2 map_size{layer->value("width", 0), layer->value("height", 0)};
+    const glm::ivec2 tile_size{map_json.value("tilewidth", 16), map_json.value("tileheight", 16)};
+    const auto& data = childArray(*layer, "data");
+    if (data.size() != static_cast<std::size_t>(map_size.x) * map_size.y) {
+        spdlog::error("图块层 '{}' 的数据大小与尺寸不符（不支持压缩或无限地图）", layer_name);
+        return false;
+    }
+
+    std::vector<std::uint8_t> flags(data.size(), 0);
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        flags[i] = tiles.getFlags(data[i].get<std::uint32_t>());
+    }
+    if (!build(map_size, tile_size, std::move(flags), settings)) {
+        return false;
+    }
+    spdlog::info("导航网格构建完成: {} ({}x{}，行走边 {} 条)", map_path, map_size.x, map_size.y, reverse_edges_.size());
+    return true;
+}
+
+bool NavigationGrid::build(glm::ivec2 map_size, glm::ivec2 tile_size, std::vector<std::uint8_t> flags, WalkerSettings settings) {
+    // 后续所有按坐标的访问都依赖 flags 与尺寸一致，不一致时清空网格（isValid() 为 false）
+    if (map_size.x <= 0 || map_size.y <= 0 || tile_size.x <= 0 || tile_size.y <= 0 ||
+        flags.size() != static_cast<std::size_t>(map_size.x) * static_cast<std::size_t>(map_size.y)) {
+        spdlog::error("导航网格构建失败：尺寸 {}x{}（图块 {}x{}）与属性数据大小 {} 不符", map_size.x, map_size.y, tile_size.x,
+                      tile_size.y, flags.size());
+        map_size_ = glm::ivec2(0);
+        flags_.clear();
+        reverse_offsets_.clear();
+        reverse_edges_.clear();
+        return false;
+    }
+    map_size_ = map_size;
+    tile_size_ = tile_size;
+    flags_ = std::move(flags);
+    walker_settings_ = settings;
+    markStandable();
+    buildWalkerGraph();
+    return true;
+}
+
+glm::ivec2 NavigationGrid::worldToCell(const glm::vec2& world_pos) const {
+    return glm::ivec2(glm::floor(world_pos / glm::vec2(tile_size_)));
+}
+
+glm::vec2 NavigationGrid::cellCenter(std::uint32_t index) const {
+    return (glm::vec2(cellCoord(index)) + 0.5f) * glm::vec2(tile_size_);
+}
+
+bool NavigationGrid::isPassable(int x, int y) const {
+    return (getFlags(x, y) & tile_flag::SOLID) == 0;
+}
+
+bool NavigationGrid::hasClearance(int x, int y) const {
+    for (int i = 0; i < walker_settings_.agent_height; ++i) {
+        if (!isPassable(x, y - i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void NavigationGrid::markStandable() {
+    for (int y = 0; y < map_size_.y; ++y) {
+        for (int x = 0; x < map_size_.x; ++x) {
+            auto& flags = flags_[cellIndex(x, y)];
+            flags &= static_cast<std::uint8_t>(~tile_flag::STANDABLE);
+            // 地图底边以外视为无支撑：掉出地图的路线不可用
+            const bool supported = (flags & (tile_flag::SLOPE | tile_flag::LADDER)) != 0 ||
+                                   (y + 1 < map_size_.y && (getFlags(x, y + 1) & SUPPORT_BELOW) != 0);
+            if (supported && hasClearance(x, y)) {
+                flags |= tile_flag::STANDABLE;
+            }
+        }
+    }
+}
+
+int NavigationGrid::findLanding(int x, int start_y) const {
+    const int max_y = std::min(map_size_.y, start_y + walker_settings_.max_fall_height + 1);
+    for (int y = start_y; y < max_y; ++y) {
+        if (!isPassable(x, y)) {
+            return -1;
+        }
+        if (getFlags(x, y) & tile_flag::STANDABLE) {
+            return y;
+        }
+    }
+    return -1;
+}
+
+void NavigationGrid::collectWalkerEdges(int x, int y, std::vector<NavEdge>& out) const {
+    const auto standable = [this](int cx, int cy) {
+        return inBounds(cx, cy) && (getFlags(cx, cy) & tile_flag::STANDABLE) != 0;
+    };
+    const auto add = [&](int tx, int ty, int cost, NavMove move) {
+        if (getFlags(tx, ty) & tile_flag::HAZARD) {
+            cost += walker_settings_.hazard_cost;
+        }
+        out.push_back({cellIndex(tx, ty), static_cast<std::uint16_t>(std::min(cost, 0xFFFF)), move});
+    };
+    const bool on_slope = (getFlags(x, y) & tile_flag::SLOPE) != 0;
+
+    for (const int dx : {-1, 1}) {
+        const int nx = x + dx;
+        // 行走：同一行，或沿斜坡上下一格
+        if (standable(nx, y)) {
+            add(nx, y, 10, NavMove::Walk);
+        } else if (isPassable(nx, y)) {
+            // 走出边缘后下落
+            if (const int landing = findLanding(nx, y + 1); landing >= 0) {
+                add(nx, landing, 10 + 4 * (landing - y), NavMove::Fall);
+            }
+        }
+        if (standable(nx, y - 1) && hasClearance(x, y - 1) &&
+            (on_slope || (getFlags(nx, y - 1) & tile_flag::SLOPE))) {
+            add(nx, y - 1, 14, NavMove::Walk);
+        }
+        if (standable(nx, y + 1) && isPassable(nx, y) &&
+            (on_slope || (getFlags(nx, y + 1) & tile_flag::SLOPE))) {
+            add(nx, y + 1, 14, NavMove::Walk);
+        }
+    }
+
+    // 从单向平台上跳下
+    if (getFlags(x, y + 1) & tile_flag::ONE_WAY) {
+        if (const int landing = findLanding(x, y + 1); landing >= 0) {
+            add(x, landing, 10 + 4 * (landing - y), NavMove::Fall);
+        }
+    }
+
+    // 攀爬：梯子格之间上下移动，或从梯子顶端站立处向下
+    if ((getFlags(x, y) & tile_flag::LADDER) && standable(x, y - 1)) {
+        add(x, y - 1, 12, NavMove::Climb);
+    }
+    if ((getFlags(x, y + 1) & tile_flag::LADDER) && standable(x, y + 1)) {
+        add(x, y + 1, 12, NavMove::Climb);
+    }
+
+    // 跳跃：先竖直上升 h 格（单向平台可穿过），再水平移动 dx 格落到可站立的格子上
+    for (int h = 0; h <= walker_settings_.max_jump_height; ++h) {
+        if (h > 0 && !isPassable(x, y - h - walker_settings_.agent_height + 1)) {
+            break;      // 头顶被挡住，更高的跳跃也不可能
+        }
+        for (int dx = -walker_settings_.max_jump_distance; dx <= walker_settings_.max_jump_distance; ++dx) {
+            if ((h == 0 && std::abs(dx) < 2) || (h > 0 && dx == 0 && !(getFlags(x, y - h + 1) & tile_flag::ONE_WAY))) {
+                continue;   // 平地相邻由行走处理；原地向上只有穿过单向平台时才有意义
+            }
+            const int tx = x + dx;
+            const int ty = y - h;
+            if (!standable(tx, ty)) {
+                continue;
+            }
+            bool clear = true;
+            const int step = dx > 0 ? 1 : -1;
+            for (int cx = x; clear && cx != tx; cx += step) {
+                clear = hasClearance(cx + step, ty);
+            }
+            if (clear) {
+                add(tx, ty, 15 + 10 * (std::abs(dx) + h), NavMove::Jump);
+            }
+        }
+    }
+}
+
+void NavigationGrid::buildWalkerGraph() {
+    const auto cell_count = static_cast<std::uint32_t>(flags_.size());
+    std::vector<ForwardEdge> forward;
+    forward.reserve(cell_count);
+    std::vector<NavEdge> edges;
+
+    for (int y = 0; y < map_size_.y; ++y) {
+        for (int x = 0; x < map_size_.x; ++x) {
+            const auto from = cellIndex(x, y);
+            if (!(flags_[from] & tile_flag::STANDABLE)) {
+                continue;
+            }
+            edges.clear();
+            collectWalkerEdges(x, y, edges);
+            // 同一目标可能同时有行走和跳跃等多条边，只保留代价最小的一条
+            std::sort(edges.begin(), edges.end(), [](const NavEdge& a, const NavEdge& b) {
+                return a.cell != b.cell ? a.cell < b.cell : a.cost < b.cost;
+            });
+            for (std::size_t i = 0; i < edges.size(); ++i) {
+                if (i == 0 || edges[i].cell != edges[i - 1].cell) {
+                    forward.push_back({from, edges[i]});
+                }
+            }
+        }
+    }
+
+    // 按目标格计数后前缀和，得到反向边的 CSR 布局
+    reverse_offsets_.assign(cell_count + 1, 0);
+    for (const auto& f : forward) {
+        ++reverse_offsets_[f.edge.cell + 1];
+    }
+    for (std::uint32_t i = 0; i < cell_count; ++i) {
+        reverse_offsets_[i + 1] += reverse_offsets_[i];
+    }
+    reverse_edges_.resize(forward.size());
+    std::vector<std::uint32_t> cursor(reverse_offsets_.begin(), reverse_offsets_.end() - 1);
+    for (const auto& f : forward) {
+        reverse_edges_[cursor[f.edge.cell]++] = {f.from, f.edge.cost, f.edge.move};
+    }
+}
+
+} // namespace engine::navigation
@@ -0,0 +1,126 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#ifndef SUNNYLAND_NAVIGATION_GRID_H
+#define SUNNYLAND_NAVIGATION_GRID_H
+
+#include "../scene/tile_table.h"
+#include <cstdint>      // 用于 std::uint8_t
+#include <string>       // 用于 std::string
+#include <vector>       // 用于 std::vector
+#include <glm/glm.hpp>
+
+namespace engine::navigation {
+
+/**
+ * @brief 图块的导航属性位：前五位与 scene::tile_flag 相同（由 TileTable 从图块集属性得出），其余为导航派生属性。
+ */
+namespace tile_flag {
+inline constexpr std::uint8_t SOLID = engine::scene::tile_flag::SOLID;      ///< @brief 实心，不可进入
+inline constexpr std::uint8_t ONE_WAY = engine::scene::tile_flag::ONE_WAY;  ///< @brief 单向平台（unisolid），可从下方穿过、站在上面
+inline constexpr std::uint8_t HAZARD = engine::scene::tile_flag::HAZARD;    ///< @brief 危险图块，可通行但代价很高
+inline constexpr std::uint8_t LADDER = engine::scene::tile_flag::LADDER;
+inline constexpr std::uint8_t SLOPE = engine::scene::tile_flag::SLOPE;
+inline constexpr std::uint8_t STANDABLE = 1u << 7;  ///< @brief 派生属性：行走单位可以停留在此格
+}
+
+enum class NavMove : std::uint8_t { None, Walk, Jump, Fall, Climb, Fly, Arrived };
+
+/**
+ * @brief 行走单位（青蛙、负鼠等）的移动能力，决定平台图中有哪些边。单位均为图块。
+ */
+struct WalkerSettings {
+    int agent_height = 1;           ///< @brief 单位高度，站立格上方需要留出的空间
+    int max_jump_height = 3;
+    int max_jump_distance = 2;      ///< @brief 单次跳跃的最大水平距离
+    int max_fall_height = 16;       ///< @brief 超过这个高度的落差不会被当作可走的路线
+    int hazard_cost = 200;          ///< @brief 进入危险图块的额外代价（直线移动一格为 10）
+};
+
+/**
+ * @brief 平台图中的一条边。NavigationGrid 只保存反向边（指向某节点的所有边），供流场从目标反向扩展。
+ */
+struct NavEdge {
+    std::uint32_t cell = 0;         ///< @brief 边的另一端（反向边中为出发格）
+    std::uint16_t cost = 0;
+    NavMove move = NavMove::None;
+};
+
+/**
+ * @brief 关卡加载时从图块层构建的静态导航数据，所有 FlowField 共享。
+ *
+ * - 每个格子一个字节的属性位（tile_flag），飞行单位直接在这张网格上做 8 邻域扩展；
+ * - 行走单位使用预先计算好的平台图：节点是可站立的格子，边是行走、跳跃、下落、攀爬，
+ *   以 CSR（偏移表 + 连续边数组）的形式存储反向边，流场扩展时只做顺序读取。
+ */
+class NavigationGrid final {
+private:
+    glm::ivec2 map_size_{0};
+    glm::ivec2 tile_size_{16};
+    std::vector<std::uint8_t> flags_;
+    WalkerSettings walker_settings_;
+
+    std::vector<std::uint32_t> reverse_offsets_;    ///< @brief 格子 i 的反向边为 reverse_edges_[offsets[i], offsets[i + 1])
+    std::vector<NavEdge> reverse_edges_;
+
+public:
+    NavigationGrid() = default;
+
+    /**
+     * @brief 从 Tiled 地图（.tmj）构建导航数据。
+     * @param map_path 地图文件路径。
+     * @param layer_name 参与导航的图块层名称。
+     * @param settings 行走单位的移动能力。
+     * @return 地图或图块层无法读取时返回 false。
+     */
+    bool loadFromMap(const std::string& map_path, const std::string& layer_name = "main", WalkerSettings settings = {});
+
+    /**
+     * @brief 同上，但使用已编译好的图块表（与渲染、碰撞共用同一份，避免重复解析图块集）。
+     */
+    bool loadFromMap(const std::string& map_path, const engine::scene::TileTable& tiles, const std::string& layer_name = "main",
+                     WalkerSettings settings = {});
+
+    /**
+     * @brief 直接从属性网格构建（用于程序生成的地图）。flags 按行优先排列，只需包含原始属性位。
+     * @return 尺寸无效或 flags 的大小不等于 map_size.x * map_size.y 时返回 false，网格被清空。
+     */
+    bool build(glm::ivec2 map_size, glm::ivec2 tile_size, std::vector<std::uint8_t> flags, WalkerSettings settings = {});
+
+    [[nodiscard]] bool isValid() const { return !flags_.empty(); }
+    [[nodiscard]] glm::ivec2 getMapSize() const { return map_size_; }
+    [[nodiscard]] glm::ivec2 getTileSize() const { return tile_size_; }
+    [[nodiscard]] std::size_t getCellCount() const { return flags_.size(); }
+    [[nodiscard]] std::size_t getWalkerEdgeCount() const { return reverse_edges_.size(); }
+    [[nodiscard]] const WalkerSettings& getWalkerSettings() const { return walker_settings_; }
+
+    [[nodiscard]] bool inBounds(int x, int y) const { return x >= 0 && y >= 0 && x < map_size_.x && y < map_size_.y; }
+    [[nodiscard]] std::uint32_t cellIndex(int x, int y) const { return static_cast<std::uint32_t>(y * map_size_.x + x); }
+    [[nodiscard]] glm::ivec2 cellCoord(std::uint32_t index) const {
+        return {static_cast<int>(index) % map_size_.x, static_cast<int>(index) / map_size_.x};
+    }
+    [[nodiscard]] std::uint8_t getFlags(int x, int y) const { return inBounds(x, y) ? flags_[cellIndex(x, y)] : tile_flag::SOLID; }
+    [[nodiscard]] std::uint8_t getFlags(std::uint32_t index) const { return flags_[index]; }
+
+    [[nodiscard]] glm::ivec2 worldToCell(const glm::vec2& world_pos) const;
+    [[nodiscard]] glm::vec2 cellCenter(std::uint32_t index) const;
+
+    /**
+     * @brief 获取指向格子 index 的所有行走边（出发格、代价、动作）。
+     */
+    [[nodiscard]] const NavEdge* reverseEdgesBegin(std::uint32_t index) const { return reverse_edges_.data() + reverse_offsets_[index]; }
+    [[nodiscard]] const NavEdge* reverseEdgesEnd(std::uint32_t index) const { return reverse_edges_.data() + reverse_offsets_[index + 1]; }
+
+private:
+    [[nodiscard]] bool isPassable(int x, int y) const;
+    [[nodiscard]] bool hasClearance(int x, int y) const;
+    void markStandable();
+    void buildWalkerGraph();
+    void collectWalkerEdges(int x, int y, std::vector<NavEdge>& out) const;
+    int findLanding(int x, int start_y) const;      ///< @brief 从 start_y 开始沿 x 列向下找落脚格，找不到返回 -1
+};
+
+} // namespace engine::navigation
+
+#endif //SUNNYLAND_NAVIGATION_GRID_H
@@ -0,0 +1,390 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#include "animation.h"
+#include "../utils/log.h"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+namespace engine::render {
+
+namespace {
+
+constexpr float DEFAULT_FRAME_DURATION_MS = 100.0f;   // 未指定 duration 时每帧的时长（毫秒）
+constexpr float MIN_FRAME_DURATION = 0.001f;          // 防止 0 时长帧导致 update 死循环（秒）
+
+std::string makeClipKey(const std::string& texture_path, const std::string& name) {
+    return texture_path + "#" + name;
+}
+
+// 把 .tsj 中的相对图片路径解析为与 ResourceManager 一致的工程相对路径
+std::string resolvePath(const std::filesystem::path& base_dir, const std::string& relative_path) {
+    return (base_dir / relative_path).lexically_normal().generic_string();
+}
+
+} // namespace
+
+// --- AnimationLibrary ---
+
+AnimationLibrary::AnimationLibrary() {
+    event_names_.emplace_back();    // 0 号事件保留为“无事件”
+}
+
+bool AnimationLibrary::loadTileset(const std::string& tileset_path) {
+    std::ifstream file(tileset_path);
+    if (!file.is_open()) {
+        spdlog::error("无法打开图块集文件: {}", tileset_path);
+        return false;
+    }
+
+    nlohmann::json json;
+    try {
+        file >> json;
+    } catch (const nlohmann::json::parse_error& e) {
+        spdlog::error("解析图块集文件 '{}' 失败: {}", tileset_path, e.what());
+        return false;
+    }
+
+    const auto base_dir = std::filesystem::path(tileset_path).parent_path();
+    const int tile_width = json.value("tilewidth", 0);
+    const int tile_height = json.value("tileheight", 0);
+    const int columns = json.value("columns", 0);
+    const std::string tileset_image = json.contains("image")
+        ? resolvePath(base_dir, json["image"].get<std::string>()) : std::string{};
+
+    [[maybe_unused]] const auto clip_count_before = clips_.size();    // 仅用于调试日志
+    std::vector<AnimationFrame> frames;     // 复用的临时缓冲区，仅在加载期分配
+
+    for (const auto& tile : json.value("tiles", nlohmann::json::array())) {
+        const int tile_id = tile.value("id", 0);
+
+        // 1. 自定义属性 "animation"：单张精灵图上按 行/列 切分的多个片段
+        for (const auto& property : tile.value("properties", nlohmann::json::array())) {
+            if (property.value("name", "") != "animation") {
+                continue;
+            }
+            const std::string texture_path = tile.contains("image")
+                ? resolvePath(base_dir, tile["image"].get<std::string>()) : tileset_image;
+            const auto frame_width = static_cast<float>(tile.value("width", tile_width));
+            const auto frame_height = static_cast<float>(tile.value("height", tile_height));
+
+            nlohmann::json clips_json;
+            try {
+                clips_json = nlohmann::json::parse(property.value("value", "{}"));
+            } catch (const nlohmann::json::parse_error& e) {
+                spdlog::warn("图块集 '{}' 中图块 {} 的 animation 属性解析失败: {}", tileset_path, tile_id, e.what());
+                continue;
+            }
+
+            for (const auto& [clip_name, clip_json] : clips_json.items()) {
+                const float duration = clip_json.value("duration", DEFAULT_FRAME_DURATION_MS) / 1000.0f;
+                const auto row = static_cast<float>(clip_json.value("row", 0));
+                const auto events_json = clip_json.value("events", nlohmann::json::object());
+
+                frames.clear();
+                for (const auto& column : clip_json.value("frames", nlohmann::json::array())) {
+                    AnimationFrame frame;
+                    frame.source_rect = {column.get<float>() * frame_width, row * frame_height, frame_width, frame_height};
+                    frame.duration = duration;
+                    const auto event_it = events_json.find(std::to_string(frames.size()));
+                    if (event_it != events_json.end()) {
+                        frame.event_id = registerEvent(event_it->get<std::string>());
+                    }
+                    frames.push_back(frame);
+                }
+                addClip(texture_path, clip_name, frames, clip_json.value("loop", true));
+            }
+        }
+
+        // 2. Tiled 原生图块动画：帧来自同一图块集的网格，片段名为图块 ID
+        if (tile.contains("animation") && columns > 0) {
+            frames.clear();
+            for (const auto& frame_json : tile["animation"]) {
+                const int frame_tile = frame_json.value("tileid", 0);
+                AnimationFrame frame;
+                frame.source_rect = {static_cast<float>((frame_tile % columns) * tile_width),
+                                     static_cast<float>((frame_tile / columns) * tile_height),
+                                     static_cast<float>(tile_width),
+                                     static_cast<float>(tile_height)};
+                frame.duration = frame_json.value("duration", DEFAULT_FRAME_DURATION_MS) / 1000.0f;
+                frames.push_back(frame);
+            }
+            addClip(tileset_image, std::to_string(tile_id), frames);
+        }
+    }
+
+    SPDLOG_DEBUG("从图块集 '{}' 烘焙了 {} 个动画片段，帧表共 {} 帧。",
+                  tileset_path, clips_.size() - clip_count_before, frames_.size());
+    return true;
+}
+
+ClipId AnimationLibrary::addClip(const std::string& texture_path, const std::string& name,
+                                 std::span<const AnimationFrame> frames, bool loop) {
+    auto key = makeClipKey(texture_path, name);
+    if (auto it = clip_ids_.find(key); it != clip_ids_.end()) {
+        spdlog::warn("动画片段 '{}' 已存在，忽略重复添加。", key);
+        return it->second;
+    }
+    if (frames.empty()) {
+        spdlog::warn("动画片段 '{}' 没有任何帧，已忽略。", key);
+        return INVALID_CLIP;
+    }
+
+    AnimationClip clip;
+    clip.first_frame = static_cast<std::uint32_t>(frames_.size());
+    clip.frame_count = static_cast<std::uint32_t>(frames.size());
+    clip.texture_id = internTexture(texture_path);
+    clip.loop = loop;
+    for (auto frame : frames) {
+        frame.duration = std::max(frame.duration, MIN_FRAME_DURATION);
+        clip.total_duration += frame.duration;
+        frames_.push_back(frame);
+    }
+
+    const auto id = static_cast<ClipId>(clips_.size());
+    clips_.push_back(clip);
+    clip_ids_.emplace(std::move(key), id);
+    return id;
+}
+
+std::uint32_t AnimationLibrary::registerEvent(std::string_view name) {
+    std::string key(name);
+    if (auto it = event_ids_.find(key); it != event_ids_.end()) {
+        return it->second;
+    }
+    const auto id = static_cast<std::uint32_t>(event_names_.size());
+    event_names_.push_back(key);
+    event_ids_.emplace(std::move(key), id);
+    return id;
+}
+
+ClipId AnimationLibrary::findClip(const std::string& texture_path, const std::string& name) const {
+    auto it = clip_ids_.find(makeClipKey(texture_path, name));
+    return it != clip_ids_.end() ? it->second : INVALID_CLIP;
+}
+
+void AnimationLibrary::clear() {
+    frames_.clear();
+    clips_.clear();
+    texture_paths_.clear();
+    clip_ids_.clear();
+    texture_ids_.clear();
+    event_ids_.clear();
+    event_names_.resize(1);
+}
+
+std::uint32_t AnimationLibrary::internTexture(const std::string& texture_path) {
+    if (auto it = texture_ids_.find(texture_path); it != texture_ids_.end()) {
+        return it->second;
+    }
+    const auto id = static_cast<std::uint32_t>(texture_paths_.size());
+    texture_paths_.push_back(texture_path);
+    texture_ids_.emplace(texture_path, id);
+    return id;
+}
+
+// --- AnimationSystem ---
+
+AnimationSystem::AnimationSystem(const AnimationLibrary& library, std::size_t capacity) : library_(library) {
+    clip_ids_.reserve(capacity);
+    frame_indices_.reserve(capacity);
+    frame_times_.reserve(capacity);
+    speeds_.reserve(capacity);
+    finished_.reserve(capacity);
+    visible_.reserve(capacity);
+    dense_to_handle_.reserve(capacity);
+    handle_to_dense_.reserve(capacity);
+    generations_.reserve(capacity);
+    event_capacity_ = std::max<std::size_t>(capacity, 64);
+    events_.reserve(event_capacity_);
+    pending_events_.reserve(event_capacity_);
+}
+
+AnimationHandle AnimationSystem::create(ClipId clip, float speed) {
+    if (clip >= library_.getClipCount()) {
+        spdlog::error("创建动画实例失败: 无效的片段 ID {}", clip);
+        return INVALID_ANIMATION;
+    }
+
+    std::uint32_t slot;
+    if (!free_slots_.empty()) {
+        slot = free_slots_.back();
+        free_slots_.pop_back();
+    } else {
+        slot = static_cast<std::uint32_t>(handle_to_dense_.size());
+        handle_to_dense_.push_back(0);
+        generations_.push_back(1);
+    }
+    const auto handle = (static_cast<AnimationHandle>(generations_[slot]) << 32) | slot;
+
+    const auto index = static_cast<std::uint32_t>(clip_ids_.size());
+    handle_to_dense_[slot] = index;
+    clip_ids_.push_back(clip);
+    frame_indices_.push_back(library_.getClip(clip).first_frame);
+    frame_times_.push_back(0.0f);
+    speeds_.push_back(speed);
+    finished_.push_back(0);
+    visible_.push_back(1);
+    dense_to_handle_.push_back(handle);
+    queueFirstFrameEvent(index);
+    return handle;
+}
+
+void AnimationSystem::destroy(AnimationHandle handle) {
+    if (!isAlive(handle)) {
+        SPDLOG_DEBUG("忽略对已失效动画句柄的 destroy: {:#x}", handle);
+        return;
+    }
+    const auto index = denseIndex(handle);
+    const auto last = static_cast<std::uint32_t>(clip_ids_.size() - 1);
+
+    // 与末尾元素交换后弹出，保持数组紧密
+    if (index != last) {
+        clip_ids_[index] = clip_ids_[last];
+        frame_indices_[index] = frame_indices_[last];
+        frame_times_[index] = frame_times_[last];
+        speeds_[index] = speeds_[last];
+        finished_[index] = finished_[last];
+        visible_[index] = visible_[last];
+        dense_to_handle_[index] = dense_to_handle_[last];
+        handle_to_dense_[handleSlot(dense_to_handle_[index])] = index;
+    }
+    clip_ids_.pop_back();
+    frame_indices_.pop_back();
+    frame_times_.pop_back();
+    speeds_.pop_back();
+    finished_.pop_back();
+    visible_.pop_back();
+    dense_to_handle_.pop_back();
+
+    // 代数加 1 使旧句柄失效；跳过 0，保证句柄不会等于 INVALID_ANIMATION
+    const auto slot = handleSlot(handle);
+    if (++generations_[slot] == 0) {
+        generations_[slot] = 1;
+    }
+    free_slots_.push_back(slot);
+}
+
+void AnimationSystem::play(AnimationHandle handle, ClipId clip, bool restart) {
+    if (!isAlive(handle) || clip >= library_.getClipCount()) {
+        SPDLOG_DEBUG("忽略 play: 句柄 {:#x} 已失效或片段 ID {} 无效", handle, clip);
+        return;
+    }
+    const auto index = denseIndex(handle);
+    if (clip_ids_[index] == clip && !restart) {
+        return;
+    }
+    clip_ids_[index] = clip;
+    frame_indices_[index] = library_.getClip(clip).first_frame;
+    frame_times_[index] = 0.0f;
+    finished_[index] = 0;
+    queueFirstFrameEvent(index);
+}
+
+void AnimationSystem::setSpeed(AnimationHandle handle, float speed) {
+    if (isAlive(handle)) {
+        speeds_[denseIndex(handle)] = speed;
+    }
+}
+
+void AnimationSystem::setVisible(AnimationHandle handle, bool visible) {
+    if (isAlive(handle)) {
+        visible_[denseIndex(handle)] = visible ? 1 : 0;
+    }
+}
+
+bool AnimationSystem::isAlive(AnimationHandle handle) const {
+    const auto slot = handleSlot(handle);
+    return slot < generations_.size() && generations_[slot] == static_cast<std::uint32_t>(handle >> 32);
+}
+
+void AnimationSystem::pushEvent(std::vector<AnimationEvent>& events, AnimationHandle handle, std::uint32_t event_id) {
+    // 不超出预留容量，保证 update() 不分配内存；大量实例同一帧触发事件时宁可丢弃
+    if (events.size() < event_capacity_) {
+        events.push_back({handle, event_id});
+    } else {
+        ++dropped_events_;
+    }
+}
+
+void AnimationSystem::queueFirstFrameEvent(std::uint32_t dense_index) {
+    // 首帧不是由 update() 的推进进入的，其事件单独排队，否则从不触发
+    const auto event_id = library_.getFrames()[frame_indices_[dense_index]].event_id;
+    if (event_id != 0) {
+        pushEvent(pending_events_, dense_to_handle_[dense_index], event_id);
+    }
+}
+
+void AnimationSystem::update(float delta_time) {
+    // 上一帧的事件作废；create()/play() 排队的首帧事件排在本帧事件之前
+    events_.clear();
+    events_.swap(pending_events_);
+
+    const AnimationFrame* frames = library_.getFrames().data();
+    const std::size_t count = clip_ids_.size();
+    const std::uint32_t interval = offscreen_interval_;
+    const std::uint32_t phase = frame_counter_++ % interval;
+    const float offscreen_step = delta_time * static_cast<float>(interval);
+    for (std::size_t i = 0; i < count; ++i) {
+        float step = delta_time;
+        if (!visible_[i] && interval > 1) {
+            if (i % interval != phase) {
+                continue;       // 屏幕外：本帧不轮到这一组
+            }
+            step = offscreen_step;
+        }
+        float time = frame_times_[i] + step * speeds_[i];
+        std::uint32_t frame = frame_indices_[i];
+        if (time < frames[frame].duration) {   // 绝大多数实例在这里就结束了
+            frame_times_[i] = time;
+            continue;
+        }
+
+        const AnimationClip& clip = library_.getClip(clip_ids_[i]);
+        const std::uint32_t end_frame = clip.first_frame + clip.frame_count;
+        if (clip.loop && time >= clip.total_duration) {
+            time = std::fmod(time, clip.total_duration);  // 跳过整圈（例如长时间卡顿后），整圈中的事件不再补发
+        }
+        while (time >= frames[frame].duration) {
+            time -= frames[frame].duration;
+            if (++frame == end_frame) {
+                if (!clip.loop) {
+                    frame = end_frame - 1;
+                    time = 0.0f;
+                    finished_[i] = 1;
+                    break;
+                }
+                frame = clip.first_frame;
+            }
+            if (frames[frame].event_id != 0) {
+                pushEvent(events_, dense_to_handle_[i], frames[frame].event_id);
+            }
+        }
+        frame_times_[i] = time;
+        frame_indices_[i] = frame;
+    }
+
+    if (dropped_events_ > 0) {
+        SUNNYLAND_LOG_EVERY(spdlog::level::warn, 1000, "动画事件超出容量 {}，本帧丢弃 {} 个", event_capacity_, dropped_events_);
+        dropped_events_ = 0;
+    }
+}
+
+const SDL_FRect& AnimationSystem::getSourceRect(AnimationHandle handle) const {
+    return library_.getFrames()[frame_indices_[denseIndex(handle)]].source_rect;
+}
+
+ClipId AnimationSystem::getClip(AnimationHandle handle) const {
+    return clip_ids_[denseIndex(handle)];
+}
+
+bool AnimationSystem::isFinished(AnimationHandle handle) const {
+    return finished_[denseIndex(handle)] != 0;
+}
+
+} // namespace engine::render
@@ -0,0 +1,196 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#ifndef SUNNYLAND_ANIMATION_H
+#define SUNNYLAND_ANIMATION_H
+
+#include <cstdint>       // 用于 std::uint32_t
+#include <span>          // 用于 std::span
+#include <string>        // 用于 std::string
+#include <string_view>   // 用于 std::string_view
+#include <unordered_map> // 用于 std::unordered_map
+#include <vector>        // 用于 std::vector
+#include <SDL3/SDL_rect.h>
+
+namespace engine::render {
+
+using ClipId = std::uint32_t;             ///< @brief 动画片段在 AnimationLibrary 中的下标
+using AnimationHandle = std::uint64_t;    ///< @brief AnimationSystem 中播放实例的稳定句柄：高 32 位为代数，低 32 位为句柄槽位
+
+inline constexpr ClipId INVALID_CLIP = 0xFFFFFFFFu;
+inline constexpr AnimationHandle INVALID_ANIMATION = 0;
+
+/**
+ * @brief 烘焙后的单帧数据，所有片段的帧连续存放在同一张帧表中。
+ */
+struct AnimationFrame {
+    SDL_FRect source_rect{};        ///< @brief 帧在纹理中的源矩形
+    float duration = 0.1f;          ///< @brief 帧持续时间（秒）
+    std::uint32_t event_id = 0;     ///< @brief 进入该帧时触发的事件 ID（0 表示无事件）
+};
+
+/**
+ * @brief 动画片段，只记录它在帧表中的区间，不持有任何帧数据。
+ */
+struct AnimationClip {
+    std::uint32_t first_frame = 0;  ///< @brief 片段第一帧在帧表中的下标
+    std::uint32_t frame_count = 0;  ///< @brief 片段帧数
+    std::uint32_t texture_id = 0;   ///< @brief 片段所用纹理在 AnimationLibrary 纹理路径表中的下标
+    float total_duration = 0.0f;    ///< @brief 片段总时长（秒）
+    bool loop = true;               ///< @brief 是否循环播放
+};
+
+/**
+ * @brief 动画帧事件，在 AnimationSystem::update() 中产生，下次 update() 前有效。
+ *        create()/play() 进入的第一帧带事件时，该事件出现在随后一次 update() 的事件列表开头。
+ */
+struct AnimationEvent {
+    AnimationHandle handle = INVALID_ANIMATION; ///< @brief 触发事件的播放实例
+    std::uint32_t event_id = 0;                 ///< @brief 事件 ID，可通过 AnimationLibrary::getEventName() 查询名称
+};
+
+/**
+ * @brief 在加载期把 Tiled 图块集（.tsj）中的动画数据烘焙成扁平的帧表和片段表。
+ *
+ * 支持两种来源：
+ * - 图块自定义属性 "animation"（JSON 字符串，如 actor.tsj 中的 {"idle": {"duration": 200, "row": 0, "frames": [0,1,2]}}），
+ *   可选字段 "loop"（默认 true）和 "events"（{"帧序号": "事件名"}）。
+ * - Tiled 原生的图块动画（tiles[].animation 中的 tileid/duration 列表），片段名为图块 ID（如 "12"）。
+ *
+ * 名称查找只应在加载期使用，运行期请保存 ClipId。
+ */
+class AnimationLibrary final {
+private:
+    std::vector<AnimationFrame> frames_;            ///< @brief 所有片段共享的扁平帧表
+    std::vector<AnimationClip> clips_;              ///< @brief 片段表，下标即 ClipId
+    std::vector<std::string> texture_paths_;        ///< @brief 纹理路径表，下标即 AnimationClip::texture_id
+    std::vector<std::string> event_names_;          ///< @brief 事件名称表，下标即事件 ID（0 号保留为空事件）
+
+    std::unordered_map<std::string, ClipId> clip_ids_;          ///< @brief "纹理路径#片段名" -> ClipId
+    std::unordered_map<std::string, std::uint32_t> texture_ids_;
+    std::unordered_map<std::string, std::uint32_t> event_ids_;
+
+public:
+    AnimationLibrary();
+
+    // 动画库在加载完成后只读，由各个 AnimationSystem 通过引用共享，禁止拷贝和移动
+    AnimationLibrary(const AnimationLibrary&) = delete;
+    AnimationLibrary& operator=(const AnimationLibrary&) = delete;
+    AnimationLibrary(AnimationLibrary&&) = delete;
+    AnimationLibrary& operator=(AnimationLibrary&&) = delete;
+
+    /**
+     * @brief 从 Tiled 图块集文件中烘焙所有动画片段。
+     * @param tileset_path .tsj 文件路径，图块中引用的图片路径会相对于它解析。
+     * @return 成功返回 true；文件无法读取或解析失败返回 false。
+     */
+    bool loadTileset(const std::string& tileset_path);
+
+    /**
+     * @brief 添加一个片段。frames 中的 event_id 必须已通过 registerEvent() 注册。
+     * @return 新片段的 ClipId；若同名片段已存在则返回已有的 ClipId。
+     */
+    ClipId addClip(const std::string& texture_path, const std::string& name,
+                   std::span<const AnimationFrame> frames, bool loop = true);
+
+    std::uint32_t registerEvent(std::string_view name);     ///< @brief 注册事件名称，返回事件 ID（重复注册返回同一 ID）
+
+    [[nodiscard]] ClipId findClip(const std::string& texture_path, const std::string& name) const;  ///< @brief 按纹理路径和片段名查找，未找到返回 INVALID_CLIP
+    [[nodiscard]] const AnimationClip& getClip(ClipId id) const { return clips_[id]; }
+    [[nodiscard]] const std::string& getTexturePath(ClipId id) const { return texture_paths_[clips_[id].texture_id]; }
+    [[nodiscard]] const std::string& getEventName(std::uint32_t event_id) const { return event_names_[event_id]; }
+
+    [[nodiscard]] std::span<const AnimationFrame> getFrames() const { return frames_; }
+    [[nodiscard]] std::size_t getClipCount() const { return clips_.size(); }
+
+    void clear();   ///< @brief 清空所有片段（已创建的 AnimationSystem 实例会随之失效）
+
+private:
+    std::uint32_t internTexture(const std::string& texture_path);
+};
+
+/**
+ * @brief 以 SoA 形式保存所有播放实例的状态，并在每帧一次性批量推进。
+ *
+ * 实例数据在连续数组中紧密排列（删除时与末尾交换），update() 只做数组遍历和帧表下标运算，
+ * 不做任何查找或内存分配（事件缓冲区按容量预留，单帧超出容量的事件被丢弃并记录警告）。
+ * 句柄在实例销毁前保持稳定；句柄带代数，销毁后旧句柄失效，即使槽位已被复用，destroy()/play() 等也会忽略它。
+ */
+class AnimationSystem final {
+private:
+    const AnimationLibrary& library_;
+
+    // --- 稠密 SoA 数据，下标为稠密下标 ---
+    std::vector<ClipId> clip_ids_;                  ///< @brief 当前播放的片段
+    std::vector<std::uint32_t> frame_indices_;      ///< @brief 当前帧在帧表中的绝对下标
+    std::vector<float> frame_times_;                ///< @brief 当前帧已播放的时间（秒）
+    std::vector<float> speeds_;                     ///< @brief 播放速度倍率，0 表示暂停
+    std::vector<std::uint8_t> finished_;            ///< @brief 非循环片段是否已播放完毕
+    std::vector<std::uint8_t> visible_;             ///< @brief 是否在屏幕内，屏幕外的实例按 offscreen_interval_ 降频更新
+    std::vector<AnimationHandle> dense_to_handle_;  ///< @brief 稠密下标 -> 句柄
+
+    // --- 句柄间接层，下标为句柄槽位 ---
+    std::vector<std::uint32_t> handle_to_dense_;    ///< @brief 句柄槽位 -> 稠密下标
+    std::vector<std::uint32_t> generations_;        ///< @brief 句柄槽位的当前代数，销毁时加 1
+    std::vector<std::uint32_t> free_slots_;         ///< @brief 可复用的句柄槽位
+
+    std::vector<AnimationEvent> events_;            ///< @brief 本帧产生的帧事件
+    std::vector<AnimationEvent> pending_events_;    ///< @brief create()/play() 产生的首帧事件，下次 update() 时并入 events_
+    std::size_t event_capacity_ = 0;                ///< @brief 每帧最多保留的事件数（两个事件缓冲区的预留容量）
+    std::size_t dropped_events_ = 0;                ///< @brief 本帧因超出容量被丢弃的事件数
+    std::uint32_t offscreen_interval_ = 1;          ///< @brief 屏幕外实例每隔几帧更新一次（1 表示每帧）
+    std::uint32_t frame_counter_ = 0;
+
+public:
+    /**
+     * @brief 构造函数。
+     * @param library 动画库，生命周期必须长于本系统。
+     * @param capacity 预留的实例数量，超过后数组会扩容。
+     */
+    explicit AnimationSystem(const AnimationLibrary& library, std::size_t capacity = 1024);
+
+    AnimationSystem(const AnimationSystem&) = delete;
+    AnimationSystem& operator=(const AnimationSystem&) = delete;
+    AnimationSystem(AnimationSystem&&) = delete;
+    AnimationSystem& operator=(AnimationSystem&&) = delete;
+
+    AnimationHandle create(ClipId clip, float speed = 1.0f);    ///< @brief 创建播放实例并从第一帧开始播放
+    void destroy(AnimationHandle handle);                       ///< @brief 销毁播放实例；已失效的句柄被忽略
+
+    void play(AnimationHandle handle, ClipId clip, bool restart = false);   ///< @brief 切换片段；片段相同且 restart 为 false 时不做任何事
+    void setSpeed(AnimationHandle handle, float speed);
+    void setVisible(AnimationHandle handle, bool visible);     ///< @brief 由渲染方根据视口裁剪结果设置，默认可见
+    [[nodiscard]] bool isAlive(AnimationHandle handle) const;  ///< @brief 句柄是否仍指向一个未销毁的实例
+
+    /**
+     * @brief 屏幕外实例的更新间隔（帧）。间隔为 n 时，屏幕外实例错开分成 n 组，每帧只推进其中一组，
+     *        步长为 n 倍的帧间时间，动画进度保持不变，但帧事件可能延后最多 n - 1 帧。
+     */
+    void setOffscreenInterval(std::uint32_t frames) { offscreen_interval_ = frames > 0 ? frames : 1; }
+    [[nodiscard]] std::uint32_t getOffscreenInterval() const { return offscreen_interval_; }
+
+    /**
+     * @brief 批量推进所有实例，并重新填充本帧的事件列表。
+     * @param delta_time 帧间时间（秒），通常为 Time::getDeltaTime()。
+     */
+    void update(float delta_time);
+
+    // 以下查询要求句柄有效（isAlive() 为 true），不做检查
+    [[nodiscard]] const SDL_FRect& getSourceRect(AnimationHandle handle) const;
+    [[nodiscard]] ClipId getClip(AnimationHandle handle) const;
+    [[nodiscard]] bool isFinished(AnimationHandle handle) const;
+
+    [[nodiscard]] std::span<const AnimationEvent> getEvents() const { return events_; }   ///< @brief 上一次 update() 中产生的帧事件
+    [[nodiscard]] std::size_t size() const { return clip_ids_.size(); }
+
+private:
+    [[nodiscard]] static std::uint32_t handleSlot(AnimationHandle handle) { return static_cast<std::uint32_t>(handle); }
+    [[nodiscard]] std::uint32_t denseIndex(AnimationHandle handle) const { return handle_to_dense_[handleSlot(handle)]; }
+    void pushEvent(std::vector<AnimationEvent>& events, AnimationHandle handle, std::uint32_t event_id);
+    void queueFirstFrameEvent(std::uint32_t dense_index);
+};
+
+} // namespace engine::render
+
+#endif //SUNNYLAND_ANIMATION_H
@@ -0,0 +1,99 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#include "camera.h"
+#include <algorithm>
+#include <cmath>
+#include <spdlog/spdlog.h>
+
+namespace engine::render {
+
+Camera::Camera(glm::vec2 viewport_size, glm::vec2 position, std::optional<engine::utils::Rect> limit_bounds)
+    : viewport_size_(viewport_size), position_(position), limit_bounds_(std::move(limit_bounds)) {
+    clampPosition();
+    SPDLOG_TRACE("Camera 初始化成功，视口大小: {}x{}", viewport_size_.x, viewport_size_.y);
+}
+
+void Camera::update(float delta_time) {
+    if (!target_) {
+        return;
+    }
+    const glm::vec2 desired = *target_ - viewport_size_ * 0.5f;
+    if (smooth_speed_ <= 0.0f) {
+        position_ = desired;
+    } else {
+        // 指数平滑：与帧率无关，且不会越过目标
+        const float t = 1.0f - std::exp(-smooth_speed_ * delta_time);
+        position_ += (desired - position_) * t;
+        // 距离足够近时直接对齐，避免像素画在亚像素位置来回抖动
+        if (glm::distance(position_, desired) < 0.5f) {
+            position_ = desired;
+        }
+    }
+    clampPosition();
+}
+
+void Camera::move(glm::vec2 offset) {
+    position_ += offset;
+    clampPosition();
+}
+
+glm::vec2 Camera::worldToScreen(glm::vec2 world_pos) const {
+    return world_pos - position_;
+}
+
+glm::vec2 Camera::worldToScreenWithParallax(glm::vec2 world_pos, glm::vec2 scroll_factor) const {
+    return world_pos - position_ * scroll_factor;
+}
+
+glm::vec2 Camera::screenToWorld(glm::vec2 screen_pos) const {
+    return screen_pos + position_;
+}
+
+ViewRect Camera::getViewRect(glm::vec2 scroll_factor, float margin) const {
+    const glm::vec2 min = position_ * scroll_factor - glm::vec2(margin);
+    const glm::vec2 max = position_ * scroll_factor + viewport_size_ + glm::vec2(margin);
+    return {min.x, min.y, max.x, max.y};
+}
+
+TileRange Camera::getVisibleTileRange(glm::ivec2 tile_size, glm::ivec2 map_size, glm::vec2 scroll_factor) const {
+    if (tile_size.x <= 0 || tile_size.y <= 0) {
+        return {};
+    }
+    const ViewRect view = getViewRect(scroll_factor);
+    TileRange range;
+    range.begin_x = std::max(0, static_cast<int>(std::floor(view.min_x / static_cast<float>(tile_size.x))));
+    range.begin_y = std::max(0, static_cast<int>(std::floor(view.min_y / static_cast<float>(tile_size.y))));
+    range.end_x = std::min(map_size.x, static_cast<int>(std::ceil(view.max_x / static_cast<float>(tile_size.x))));
+    range.end_y = std::min(map_size.y, static_cast<int>(std::ceil(view.max_y / static_cast<float>(tile_size.y))));
+    return range;
+}
+
+void Camera::setPosition(glm::vec2 position) {
+    position_ = position;
+    clampPosition();
+}
+
+void Camera::setViewportSize(glm::vec2 viewport_size) {
+    viewport_size_ = viewport_size;
+    clampPosition();
+}
+
+void Camera::setLimitBounds(std::optional<engine::utils::Rect> limit_bounds) {
+    limit_bounds_ = std::move(limit_bounds);
+    clampPosition();
+}
+
+void Camera::clampPosition() {
+    if (!limit_bounds_.has_value()) {
+        return;
+    }
+    const auto& bounds = limit_bounds_.value();
+    const glm::vec2 min_pos = bounds.position;
+    // 关卡比视口小时，max 会小于 min，此时把相机固定在关卡左上角
+    const glm::vec2 max_pos = glm::max(min_pos, bounds.position + bounds.size - viewport_size_);
+    position_ = glm::clamp(position_, min_pos, max_pos);
+}
+
+} // namespace engine::render
@@ -0,0 +1,116 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#ifndef SUNNYLAND_CAMERA_H
+#define SUNNYLAND_CAMERA_H
+
+#include <optional>     // 用于 std::optional
+#include <glm/glm.hpp>
+#include "../utils/math.h"
+
+namespace engine::render {
+
+/**
+ * @brief 可见区域（世界坐标下的 AABB），由 Camera 每次查询时算好，供各渲染器共享做剔除。
+ *
+ * 只包含四个浮点数，按值传递；所有测试都是内联的比较运算，应在任何逐对象绘制工作之前调用。
+ */
+struct ViewRect {
+    float min_x = 0.0f;
+    float min_y = 0.0f;
+    float max_x = 0.0f;
+    float max_y = 0.0f;
+
+    [[nodiscard]] bool contains(float x, float y) const {
+        return x >= min_x && x < max_x && y >= min_y && y < max_y;
+    }
+    [[nodiscard]] bool intersects(float x, float y, float w, float h) const {
+        return x < max_x && x + w > min_x && y < max_y && y + h > min_y;
+    }
+    [[nodiscard]] bool intersects(const engine::utils::Rect& rect) const {
+        return intersects(rect.position.x, rect.position.y, rect.size.x, rect.size.y);
+    }
+    [[nodiscard]] bool intersectsCircle(float x, float y, float radius) const {
+        return x + radius > min_x && x - radius < max_x && y + radius > min_y && y - radius < max_y;
+    }
+};
+
+/**
+ * @brief 可见的图块范围，半开区间 [begin, end)，已裁剪到地图尺寸内。
+ */
+struct TileRange {
+    int begin_x = 0;
+    int begin_y = 0;
+    int end_x = 0;
+    int end_y = 0;
+
+    [[nodiscard]] bool empty() const { return begin_x >= end_x || begin_y >= end_y; }
+};
+
+/**
+ * @brief 相机：负责世界坐标与屏幕坐标的转换、平滑跟随、关卡边界限制和可见区域查询。
+ *
+ * position 为视口左上角在世界中的坐标。视差层使用 Tiled 的约定：
+ * 屏幕坐标 = 世界坐标 - 相机位置 * 视差因子（因子为 1 时随相机正常移动，为 0 时固定在屏幕上）。
+ */
+class Camera final {
+private:
+    glm::vec2 viewport_size_;                               ///< @brief 视口大小（像素）
+    glm::vec2 position_;                                    ///< @brief 视口左上角的世界坐标
+    std::optional<engine::utils::Rect> limit_bounds_;       ///< @brief 相机移动范围（通常为关卡大小），为空表示不限制
+    const glm::vec2* target_ = nullptr;                     ///< @brief 跟随目标的世界坐标（非拥有指针），为空表示不跟随
+    float smooth_speed_ = 5.0f;                             ///< @brief 跟随平滑系数，越大越快，<= 0 表示立即到位
+
+public:
+    /**
+     * @brief 构造函数。
+     * @param viewport_size 视口大小（像素）。
+     * @param position 初始位置（视口左上角）。
+     * @param limit_bounds 可选的移动范围。
+     */
+    explicit Camera(glm::vec2 viewport_size,
+                    glm::vec2 position = glm::vec2(0.0f),
+                    std::optional<engine::utils::Rect> limit_bounds = std::nullopt);
+
+    void update(float delta_time);          ///< @brief 向跟随目标平滑移动，并限制在边界内
+    void move(glm::vec2 offset);            ///< @brief 平移相机（会限制在边界内）
+
+    [[nodiscard]] glm::vec2 worldToScreen(glm::vec2 world_pos) const;                                        ///< @brief 世界坐标 -> 屏幕坐标
+    [[nodiscard]] glm::vec2 worldToScreenWithParallax(glm::vec2 world_pos, glm::vec2 scroll_factor) const;   ///< @brief 带视差因子的世界坐标 -> 屏幕坐标
+    [[nodiscard]] glm::vec2 screenToWorld(glm::vec2 screen_pos) const;                                       ///< @brief 屏幕坐标 -> 世界坐标
+
+    /**
+     * @brief 获取可见区域，用于剔除。
+     * @param scroll_factor 视差因子，对视差层查询时传入该层的因子。
+     * @param margin 向外扩展的边距（像素），用于容纳超出自身包围盒绘制的对象。
+     */
+    [[nodiscard]] ViewRect getViewRect(glm::vec2 scroll_factor = glm::vec2(1.0f), float margin = 0.0f) const;
+
+    /**
+     * @brief 获取可见的图块范围，图块渲染器只需遍历该范围。
+     * @param tile_size 图块大小（像素）。
+     * @param map_size 地图大小（图块数），结果会被裁剪到 [0, map_size)。
+     * @param scroll_factor 图块层的视差因子。
+     */
+    [[nodiscard]] TileRange getVisibleTileRange(glm::ivec2 tile_size, glm::ivec2 map_size,
+                                                glm::vec2 scroll_factor = glm::vec2(1.0f)) const;
+
+    void setPosition(glm::vec2 position);
+    void setViewportSize(glm::vec2 viewport_size);
+    void setLimitBounds(std::optional<engine::utils::Rect> limit_bounds);
+    void setTarget(const glm::vec2* target) { target_ = target; }
+    void setSmoothSpeed(float smooth_speed) { smooth_speed_ = smooth_speed; }
+
+    [[nodiscard]] const glm::vec2& getPosition() const { return position_; }
+    [[nodiscard]] const glm::vec2& getViewportSize() const { return viewport_size_; }
+    [[nodiscard]] const std::optional<engine::utils::Rect>& getLimitBounds() const { return limit_bounds_; }
+    [[nodiscard]] glm::vec2 getCenter() const { return position_ + viewport_size_ * 0.5f; }
+
+private:
+    void clampPosition();   ///< @brief 把相机位置限制在 limit_bounds_ 内
+};
+
+} // namespace engine::render
+
+#endif //SUNNYLAND_CAMERA_H
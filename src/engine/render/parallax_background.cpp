@@ -0,0 +1,128 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#include "parallax_background.h"
+#include "camera.h"
+#include "../resource/resource_manager.h"
+#include "../utils/metrics.h"
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <SDL3/SDL_render.h>
+#include <spdlog/spdlog.h>
+
+namespace engine::render {
+
+glm::vec2 readParallaxFactor(const nlohmann::json& layer_json) {
+    return {layer_json.value("parallaxx", 1.0f), layer_json.value("parallaxy", 1.0f)};
+}
+
+bool ParallaxBackground::loadFromMap(const std::string& map_path, engine::resource::ResourceManager& resource_manager) {
+    std::ifstream file(map_path);
+    if (!file.is_open()) {
+        spdlog::error("无法打开地图文件: {}", map_path);
+        return false;
+    }
+    nlohmann::json json;
+    try {
+        file >> json;
+    } catch (const nlohmann::json::parse_error& e) {
+        spdlog::error("解析地图文件 '{}' 失败: {}", map_path, e.what());
+        return false;
+    }
+
+    layers_.clear();
+    const auto map_dir = std::filesystem::path(map_path).parent_path().generic_string();
+    loadLayers(json.value("layers", nlohmann::json::array()), map_dir, glm::vec2(1.0f), glm::vec2(0.0f), resource_manager);
+    SPDLOG_DEBUG("从地图 '{}' 加载了 {} 个视差层。", map_path, layers_.size());
+    return true;
+}
+
+void ParallaxBackground::loadLayers(const nlohmann::json& layers_json, const std::string& map_dir, glm::vec2 parent_factor,
+                                    glm::vec2 parent_offset, engine::resource::ResourceManager& resource_manager) {
+    for (const auto& layer_json : layers_json) {
+        if (!layer_json.value("visible", true)) {
+            continue;   // 如 ref 参考图层
+        }
+        const std::string type = layer_json.value("type", "");
+        const glm::vec2 factor = parent_factor * readParallaxFactor(layer_json);
+        const glm::vec2 offset = parent_offset + glm::vec2(layer_json.value("offsetx", 0.0f), layer_json.value("offsety", 0.0f));
+
+        if (type == "group") {
+            loadLayers(layer_json.value("layers", nlohmann::json::array()), map_dir, factor, offset, resource_manager);
+            continue;
+        }
+        if (type != "imagelayer" || layer_json.value("image", "").empty()) {
+            continue;
+        }
+
+        ParallaxLayer layer;
+        layer.name = layer_json.value("name", "");
+        layer.texture_path = (std::filesystem::path(map_dir) / layer_json["image"].get<std::string>()).lexically_normal().generic_string();
+        layer.texture = resource_manager.getTexture(layer.texture_path);
+        if (!layer.texture) {
+            spdlog::error("视差层 '{}' 的纹理加载失败: {}", layer.name, layer.texture_path);
+            continue;
+        }
+        layer.texture_size = resource_manager.getTextureSize(layer.texture_path);
+        layer.offset = offset;
+        layer.scroll_factor = factor;
+        layer.repeat = {layer_json.value("repeatx", false), layer_json.value("repeaty", false)};
+        layer.opacity = layer_json.value("opacity", 1.0f);
+        layers_.push_back(std::move(layer));
+    }
+}
+
+void ParallaxBackground::render(SDL_Renderer* renderer, const Camera& camera) const {
+    const glm::vec2 viewport = camera.getViewportSize();
+
+    // 超出层数限制时，跳过底图之后、最近 max_layers_ - 1 层之前的中间层
+    const std::size_t skip_end = layers_.size() > max_layers_ ? layers_.size() - (max_layers_ - 1) : 1;
+    for (std::size_t i = 0; i < layers_.size(); ++i) {
+        if (i > 0 && i < skip_end) {
+            continue;
+        }
+        const auto& layer = layers_[i];
+        const glm::vec2 size = layer.texture_size;
+        if (size.x <= 0.0f || size.y <= 0.0f) {
+            continue;
+        }
+        const glm::vec2 origin = camera.worldToScreenWithParallax(layer.offset, layer.scroll_factor);
+
+        // 平铺方向：从视口左/上边缘之前最近的一个副本开始；非平铺方向：只有一个副本
+        float start_x = origin.x, end_x = origin.x + size.x;
+        if (layer.repeat.x) {
+            start_x = std::fmod(origin.x, size.x);
+            if (start_x > 0.0f) start_x -= size.x;
+            end_x = viewport.x;
+        }
+        float start_y = origin.y, end_y = origin.y + size.y;
+        if (layer.repeat.y) {
+            start_y = std::fmod(origin.y, size.y);
+            if (start_y > 0.0f) start_y -= size.y;
+            end_y = viewport.y;
+        }
+        // 整层在屏幕外，直接跳过
+        if (start_x >= viewport.x || end_x <= 0.0f || start_y >= viewport.y || end_y <= 0.0f) {
+            continue;
+        }
+
+        SDL_SetTextureAlphaModFloat(layer.texture, layer.opacity);
+        // 预乘 alpha 的纹理（烘焙纹理）颜色也要按透明度缩放，否则半透明层会发亮
+        SDL_BlendMode blend_mode = SDL_BLENDMODE_BLEND;
+        if (SDL_GetTextureBlendMode(layer.texture, &blend_mode) && blend_mode == SDL_BLENDMODE_BLEND_PREMULTIPLIED) {
+            SDL_SetTextureColorModFloat(layer.texture, layer.opacity, layer.opacity, layer.opacity);
+        }
+        for (float y = start_y; y < end_y; y += size.y) {
+            for (float x = start_x; x < end_x; x += size.x) {
+                const SDL_FRect dest{std::round(x), std::round(y), size.x, size.y};
+                SDL_RenderTexture(renderer, layer.texture, nullptr, &dest);
+                engine::utils::Metrics::add(engine::utils::Metric::DrawCalls);
+            }
+        }
+    }
+}
+
+} // namespace engine::render
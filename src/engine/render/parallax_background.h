@@ -0,0 +1,81 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#ifndef SUNNYLAND_PARALLAX_BACKGROUND_H
+#define SUNNYLAND_PARALLAX_BACKGROUND_H
+
+#include <cstdint>  // 用于 SIZE_MAX
+#include <string>   // 用于 std::string
+#include <vector>   // 用于 std::vector
+#include <glm/glm.hpp>
+#include <nlohmann/json_fwd.hpp>
+
+struct SDL_Renderer;
+struct SDL_Texture;
+
+namespace engine::resource {
+class ResourceManager;
+}
+
+namespace engine::render {
+
+class Camera;
+
+/**
+ * @brief 从 Tiled 图片层（imagelayer）读取的一个视差层。
+ */
+struct ParallaxLayer {
+    std::string name;                       ///< @brief 图层名（如 far、mid）
+    std::string texture_path;               ///< @brief 工程相对的图片路径
+    SDL_Texture* texture = nullptr;         ///< @brief 非拥有指针，由 ResourceManager 管理
+    glm::vec2 texture_size{0.0f};
+    glm::vec2 offset{0.0f};                 ///< @brief 图层偏移（offsetx/offsety）
+    glm::vec2 scroll_factor{1.0f};          ///< @brief 视差因子（parallaxx/parallaxy）
+    glm::bvec2 repeat{false, false};        ///< @brief 是否平铺（repeatx/repeaty）
+    float opacity = 1.0f;
+};
+
+/**
+ * @brief 读取 Tiled 图层的视差因子（parallaxx/parallaxy，缺省为 1）。图块层和对象层同样适用。
+ */
+[[nodiscard]] glm::vec2 readParallaxFactor(const nlohmann::json& layer_json);
+
+/**
+ * @brief 视差背景：管理一张地图中所有可见的图片层，并按相机位置绘制。
+ *
+ * 绘制时只遍历与视口相交的平铺副本，完全在屏幕外的图层不会产生任何绘制调用。
+ */
+class ParallaxBackground final {
+private:
+    std::vector<ParallaxLayer> layers_;     ///< @brief 按地图中的顺序（从远到近）存放
+    std::size_t max_layers_ = SIZE_MAX;     ///< @brief 最多绘制的层数，由画质调节降低
+
+public:
+    ParallaxBackground() = default;
+
+    /**
+     * @brief 从 .tmj 地图中加载所有可见的图片层（包括分组内的图层，视差因子逐级相乘）。
+     * @return 成功返回 true；文件无法读取或解析失败返回 false。
+     */
+    bool loadFromMap(const std::string& map_path, engine::resource::ResourceManager& resource_manager);
+
+    void render(SDL_Renderer* renderer, const Camera& camera) const;    ///< @brief 按顺序绘制所有视差层
+    void clear() { layers_.clear(); }
+
+    /**
+     * @brief 限制绘制的层数（画质调节）。始终保留最远的底图，其余从最近的层开始保留，省去中间的装饰层。
+     */
+    void setMaxLayers(std::size_t max_layers) { max_layers_ = max_layers > 0 ? max_layers : 1; }
+    [[nodiscard]] std::size_t getMaxLayers() const { return max_layers_; }
+
+    [[nodiscard]] const std::vector<ParallaxLayer>& getLayers() const { return layers_; }
+
+private:
+    void loadLayers(const nlohmann::json& layers_json, const std::string& map_dir, glm::vec2 parent_factor,
+                    glm::vec2 parent_offset, engine::resource::ResourceManager& resource_manager);
+};
+
+} // namespace engine::render
+
+#endif //SUNNYLAND_PARALLAX_BACKGROUND_H
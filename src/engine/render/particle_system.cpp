@@ -0,0 +1,256 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#include "particle_system.h"
+#include "camera.h"
+#include "../resource/resource_manager.h"
+#include "../utils/metrics.h"
+#include <algorithm>
+#include <spdlog/spdlog.h>
+
+namespace engine::render {
+
+namespace {
+
+// xorshift32，返回 [0, 1) 的浮点数。比 <random> 的分布对象轻得多，发射大量粒子时足够用
+float nextRandom(std::uint32_t& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return static_cast<float>(state >> 8) * (1.0f / 16777216.0f);
+}
+
+float randomRange(std::uint32_t& state, float min, float max) {
+    return min + (max - min) * nextRandom(state);
+}
+
+SDL_FColor lerpColor(const SDL_FColor& a, const SDL_FColor& b, float t) {
+    return {a.r + (b.r - a.r) * t, a.g + (b.g - a.g) * t, a.b + (b.b - a.b) * t, a.a + (b.a - a.a) * t};
+}
+
+} // namespace
+
+// --- ParticlePool ---
+
+ParticlePool::ParticlePool(ParticleEmitterDesc desc, SDL_Texture* texture)
+    : desc_(std::move(desc)), texture_(texture), limit_(desc_.capacity) {
+    const std::size_t capacity = desc_.capacity;
+    pos_x_.resize(capacity);
+    pos_y_.resize(capacity);
+    vel_x_.resize(capacity);
+    vel_y_.resize(capacity);
+    age_.resize(capacity);
+    age_rate_.resize(capacity);
+
+    if (texture_) {
+        float width = 0.0f, height = 0.0f;
+        SDL_GetTextureSize(texture_, &width, &height);
+        SDL_BlendMode blend_mode = SDL_BLENDMODE_BLEND;
+        premultiplied_ = SDL_GetTextureBlendMode(texture_, &blend_mode) && blend_mode == SDL_BLENDMODE_BLEND_PREMULTIPLIED;
+        if (desc_.source_rect.w <= 0.0f || desc_.source_rect.h <= 0.0f) {
+            desc_.source_rect = {0.0f, 0.0f, width, height};
+        }
+        if (width > 0.0f && height > 0.0f) {
+            uv_rect_ = {desc_.source_rect.x / width, desc_.source_rect.y / height,
+                        desc_.source_rect.w / width, desc_.source_rect.h / height};
+        }
+    }
+}
+
+void ParticlePool::emit(glm::vec2 position, std::uint32_t count, std::uint32_t& rng_state) {
+    const std::uint32_t free_slots = limit_ > count_ ? limit_ - count_ : 0;
+    if (count > free_slots) {
+        dropped_ += count - free_slots;
+        count = free_slots;
+    }
+
+    for (std::uint32_t i = count_; i < count_ + count; ++i) {
+        pos_x_[i] = position.x;
+        pos_y_[i] = position.y;
+        vel_x_[i] = randomRange(rng_state, desc_.velocity_min.x, desc_.velocity_max.x);
+        vel_y_[i] = randomRange(rng_state, desc_.velocity_min.y, desc_.velocity_max.y);
+        age_[i] = 0.0f;
+        age_rate_[i] = 1.0f / std::max(randomRange(rng_state, desc_.lifetime_min, desc_.lifetime_max), 0.001f);
+    }
+    count_ += count;
+}
+
+void ParticlePool::update(float delta_time) {
+    const std::uint32_t count = count_;
+    const float gravity_x = desc_.gravity.x * delta_time;
+    const float gravity_y = desc_.gravity.y * delta_time;
+
+    // 1. 积分：纯逐元素运算、无分支，各数组互不别名，编译器可直接向量化
+    float* __restrict pos_x = pos_x_.data();
+    float* __restrict pos_y = pos_y_.data();
+    float* __restrict vel_x = vel_x_.data();
+    float* __restrict vel_y = vel_y_.data();
+    float* __restrict age = age_.data();
+    float* __restrict age_rate = age_rate_.data();
+    for (std::uint32_t i = 0; i < count; ++i) {
+        vel_x[i] += gravity_x;
+        vel_y[i] += gravity_y;
+        pos_x[i] += vel_x[i] * delta_time;
+        pos_y[i] += vel_y[i] * delta_time;
+        age[i] += age_rate[i] * delta_time;
+    }
+
+    // 2. 压缩：死亡粒子与末尾存活粒子交换后移除，不保证顺序
+    std::uint32_t live = count;
+    for (std::uint32_t i = 0; i < live;) {
+        if (age[i] < 1.0f) {
+            ++i;
+            continue;
+        }
+        --live;
+        pos_x[i] = pos_x[live];
+        pos_y[i] = pos_y[live];
+        vel_x[i] = vel_x[live];
+        vel_y[i] = vel_y[live];
+        age[i] = age[live];
+        age_rate[i] = age_rate[live];
+    }
+    count_ = live;
+}
+
+void ParticlePool::appendVertices(std::vector<SDL_Vertex>& vertices, glm::vec2 camera_offset, const ViewRect& view) const {
+    const float u0 = uv_rect_.x, v0 = uv_rect_.y;
+    const float u1 = uv_rect_.x + uv_rect_.w, v1 = uv_rect_.y + uv_rect_.h;
+    const float size_delta = desc_.size_end - desc_.size_start;
+
+    // 先按最大数量扩展再顺序写入，避免逐个 push_back 的容量检查；写完后截掉被剔除的部分
+    const std::size_t first = vertices.size();
+    vertices.resize(first + static_cast<std::size_t>(count_) * 4);
+    SDL_Vertex* const begin = vertices.data() + first;
+    SDL_Vertex* out = begin;
+
+    for (std::uint32_t i = 0; i < count_; ++i) {
+        const float t = age_[i];
+        const float half = (desc_.size_start + size_delta * t) * 0.5f;
+        if (!view.intersectsCircle(pos_x_[i], pos_y_[i], half)) {
+            continue;
+        }
+        const float x = pos_x_[i] - camera_offset.x;
+        const float y = pos_y_[i] - camera_offset.y;
+        SDL_FColor color = lerpColor(desc_.color_start, desc_.color_end, t);
+        if (premultiplied_) {
+            color = {color.r * color.a, color.g * color.a, color.b * color.a, color.a};
+        }
+
+        out[0] = {{x - half, y - half}, color, {u0, v0}};
+        out[1] = {{x + half, y - half}, color, {u1, v0}};
+        out[2] = {{x + half, y + half}, color, {u1, v1}};
+        out[3] = {{x - half, y + half}, color, {u0, v1}};
+        out += 4;
+    }
+    vertices.resize(first + static_cast<std::size_t>(out - begin));
+}
+
+// --- ParticleSystem ---
+
+ParticleSystem::ParticleSystem(engine::resource::ResourceManager& resource_manager)
+    : resource_manager_(resource_manager) {
+    SPDLOG_TRACE("ParticleSystem 构造成功。");
+}
+
+EmitterId ParticleSystem::registerEmitter(const ParticleEmitterDesc& desc) {
+    SDL_Texture* texture = resource_manager_.getTexture(desc.texture_path);
+    if (!texture) {
+        spdlog::error("粒子发射器纹理加载失败: {}，该发射器的粒子将不会被绘制。", desc.texture_path);
+    }
+
+    const auto id = static_cast<EmitterId>(pools_.size());
+    pools_.emplace_back(desc, texture);
+    pools_.back().setLimit(static_cast<std::uint32_t>(static_cast<float>(desc.capacity) * capacity_scale_));
+
+    // 按纹理排序，使相同纹理的粒子池在渲染时相邻，从而合并为一次提交
+    draw_order_.push_back(id);
+    std::ranges::stable_sort(draw_order_, {}, [this](EmitterId e) { return pools_[e].getTexture(); });
+
+    // 顶点与索引缓冲区按所有粒子池的总容量预留，渲染期间不再分配
+    std::size_t total_capacity = 0;
+    for (const auto& pool : pools_) {
+        total_capacity += pool.getCapacity();
+    }
+    vertices_.reserve(total_capacity * 4);
+    const std::size_t old_quads = indices_.size() / 6;
+    indices_.resize(total_capacity * 6);
+    for (std::size_t quad = old_quads; quad < total_capacity; ++quad) {
+        const int base = static_cast<int>(quad * 4);
+        int* index = &indices_[quad * 6];
+        index[0] = base;     index[1] = base + 1; index[2] = base + 2;
+        index[3] = base;     index[4] = base + 2; index[5] = base + 3;
+    }
+
+    SPDLOG_DEBUG("注册粒子发射器 {}：纹理 '{}'，容量 {}。", id, desc.texture_path, desc.capacity);
+    return id;
+}
+
+void ParticleSystem::emit(EmitterId emitter, glm::vec2 position, std::uint32_t count) {
+    pools_[emitter].emit(position, count, rng_state_);
+}
+
+void ParticleSystem::setCapacityScale(float scale) {
+    capacity_scale_ = std::clamp(scale, 0.0f, 1.0f);
+    for (auto& pool : pools_) {
+        pool.setLimit(static_cast<std::uint32_t>(static_cast<float>(pool.getCapacity()) * capacity_scale_));
+    }
+}
+
+void ParticleSystem::update(float delta_time) {
+    for (auto& pool : pools_) {
+        pool.update(delta_time);
+    }
+}
+
+void ParticleSystem::render(SDL_Renderer* renderer, const Camera& camera) {
+    const glm::vec2 camera_offset = camera.getPosition();
+    const ViewRect view = camera.getViewRect();
+    draw_calls_ = 0;
+    vertices_.clear();
+    SDL_Texture* batch_texture = nullptr;
+
+    for (const EmitterId id : draw_order_) {
+        const auto& pool = pools_[id];
+        if (pool.getCount() == 0 || !pool.getTexture()) {
+            continue;
+        }
+        if (pool.getTexture() != batch_texture) {
+            flush(renderer, batch_texture);
+            batch_texture = pool.getTexture();
+        }
+        pool.appendVertices(vertices_, camera_offset, view);
+    }
+    flush(renderer, batch_texture);
+}
+
+void ParticleSystem::clear() {
+    for (auto& pool : pools_) {
+        pool.clear();
+    }
+}
+
+std::uint32_t ParticleSystem::getLiveCount() const {
+    std::uint32_t count = 0;
+    for (const auto& pool : pools_) {
+        count += pool.getCount();
+    }
+    return count;
+}
+
+void ParticleSystem::flush(SDL_Renderer* renderer, SDL_Texture* texture) {
+    if (vertices_.empty()) {
+        return;
+    }
+    const auto vertex_count = static_cast<int>(vertices_.size());
+    const int index_count = vertex_count / 4 * 6;
+    if (!SDL_RenderGeometry(renderer, texture, vertices_.data(), vertex_count, indices_.data(), index_count)) {
+        spdlog::error("粒子几何体提交失败: {}", SDL_GetError());
+    }
+    ++draw_calls_;
+    engine::utils::Metrics::add(engine::utils::Metric::DrawCalls);
+    vertices_.clear();
+}
+
+} // namespace engine::render
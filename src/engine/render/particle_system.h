@@ -0,0 +1,142 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#ifndef SUNNYLAND_PARTICLE_SYSTEM_H
+#define SUNNYLAND_PARTICLE_SYSTEM_H
+
+#include <algorithm> // 用于 std::min
+#include <cstdint>  // 用于 std::uint32_t
+#include <string>   // 用于 std::string
+#include <vector>   // 用于 std::vector
+#include <SDL3/SDL_render.h>
+#include <glm/glm.hpp>
+
+namespace engine::resource {
+class ResourceManager;
+}
+
+namespace engine::render {
+
+class Camera;
+struct ViewRect;
+
+using EmitterId = std::uint32_t;    ///< @brief 发射器类型在 ParticleSystem 中的下标
+
+/**
+ * @brief 发射器类型描述。同一类型的所有粒子共享这些参数，单个粒子只保存随时间变化的状态。
+ */
+struct ParticleEmitterDesc {
+    std::string texture_path;                   ///< @brief 粒子纹理（如 assets/textures/FX 下的特效图）
+    SDL_FRect source_rect{0, 0, 0, 0};          ///< @brief 纹理中的源矩形，宽高为 0 表示整张纹理
+    std::uint32_t capacity = 4096;              ///< @brief 粒子池容量，满后新粒子会被丢弃
+    float lifetime_min = 0.5f;                  ///< @brief 寿命范围（秒）
+    float lifetime_max = 1.0f;
+    glm::vec2 velocity_min{-20.0f, -60.0f};     ///< @brief 初速度范围（像素/秒）
+    glm::vec2 velocity_max{20.0f, -20.0f};
+    glm::vec2 gravity{0.0f, 98.0f};             ///< @brief 恒定加速度（像素/秒²）
+    float size_start = 8.0f;                    ///< @brief 出生与消亡时的边长（像素），按寿命线性插值
+    float size_end = 2.0f;
+    SDL_FColor color_start{1.0f, 1.0f, 1.0f, 1.0f};  ///< @brief 出生与消亡时的颜色，按寿命线性插值
+    SDL_FColor color_end{1.0f, 1.0f, 1.0f, 0.0f};
+};
+
+/**
+ * @brief 单一发射器类型的固定容量粒子池，以 SoA 形式存储。
+ *
+ * 容量在构造时一次性分配，之后的发射、更新、压缩都不再分配内存。
+ * 更新核心只包含无分支的逐元素浮点运算，便于编译器自动向量化（SIMD）；
+ * 死亡粒子在单独的压缩步骤中与末尾交换移除，存活粒子始终位于 [0, count) 区间。
+ */
+class ParticlePool final {
+private:
+    ParticleEmitterDesc desc_;
+    SDL_Texture* texture_ = nullptr;    ///< @brief 非拥有指针，由 ResourceManager 管理
+    SDL_FRect uv_rect_{0, 0, 1, 1};     ///< @brief 归一化的纹理坐标矩形
+    bool premultiplied_ = false;        ///< @brief 纹理为预乘 alpha（烘焙纹理），顶点颜色也需预乘
+
+    std::vector<float> pos_x_, pos_y_;
+    std::vector<float> vel_x_, vel_y_;
+    std::vector<float> age_;            ///< @brief 归一化年龄 [0, 1)，达到 1 即死亡
+    std::vector<float> age_rate_;       ///< @brief 每秒增长的归一化年龄（1 / 寿命）
+    std::uint32_t count_ = 0;
+    std::uint32_t limit_ = 0;           ///< @brief 存活粒子上限（不超过容量），由画质调节降低
+    std::uint32_t dropped_ = 0;         ///< @brief 因池满而被丢弃的粒子数（累计）
+
+public:
+    ParticlePool(ParticleEmitterDesc desc, SDL_Texture* texture);
+
+    ParticlePool(ParticlePool&&) = default;     // 允许存放在 std::vector 中
+    ParticlePool& operator=(ParticlePool&&) = default;
+    ParticlePool(const ParticlePool&) = delete;
+    ParticlePool& operator=(const ParticlePool&) = delete;
+
+    void emit(glm::vec2 position, std::uint32_t count, std::uint32_t& rng_state);  ///< @brief 在 position 处发射 count 个粒子
+    void update(float delta_time);      ///< @brief 积分所有粒子并压缩掉死亡粒子
+
+    /**
+     * @brief 把可见的存活粒子写成四边形顶点，追加到 vertices 末尾（调用方负责预留容量）。
+     * @param camera_offset 世界坐标到屏幕坐标的平移量（通常为相机左上角位置）。
+     * @param view 世界坐标下的可见区域，区域外的粒子不生成顶点。
+     */
+    void appendVertices(std::vector<SDL_Vertex>& vertices, glm::vec2 camera_offset, const ViewRect& view) const;
+
+    void clear() { count_ = 0; }
+    void setLimit(std::uint32_t limit) { limit_ = std::min(limit, desc_.capacity); }    ///< @brief 已存活的粒子不受影响，自然消亡
+
+    [[nodiscard]] SDL_Texture* getTexture() const { return texture_; }
+    [[nodiscard]] std::uint32_t getCount() const { return count_; }
+    [[nodiscard]] std::uint32_t getCapacity() const { return desc_.capacity; }
+    [[nodiscard]] std::uint32_t getLimit() const { return limit_; }
+    [[nodiscard]] std::uint32_t getDroppedCount() const { return dropped_; }
+};
+
+/**
+ * @brief 粒子系统：管理多种发射器类型的粒子池，并按纹理合批提交几何体。
+ *
+ * 每帧渲染时，使用同一纹理的所有粒子池被合并为一次 SDL_RenderGeometry 调用；
+ * 顶点和索引缓冲区按总容量预先分配，渲染期间不发生内存分配。
+ */
+class ParticleSystem final {
+private:
+    engine::resource::ResourceManager& resource_manager_;
+    std::vector<ParticlePool> pools_;       ///< @brief 下标即 EmitterId
+    std::vector<EmitterId> draw_order_;     ///< @brief 按纹理排序的池下标，便于合批
+    std::vector<SDL_Vertex> vertices_;      ///< @brief 每帧复用的顶点缓冲区
+    std::vector<int> indices_;              ///< @brief 预先生成的四边形索引（容量内不变）
+    std::uint32_t rng_state_ = 0x9E3779B9u; ///< @brief xorshift32 随机数状态
+    std::uint32_t draw_calls_ = 0;          ///< @brief 上一帧的几何体提交次数
+    float capacity_scale_ = 1.0f;           ///< @brief 各粒子池存活上限占容量的比例
+
+public:
+    explicit ParticleSystem(engine::resource::ResourceManager& resource_manager);
+
+    ParticleSystem(const ParticleSystem&) = delete;
+    ParticleSystem& operator=(const ParticleSystem&) = delete;
+    ParticleSystem(ParticleSystem&&) = delete;
+    ParticleSystem& operator=(ParticleSystem&&) = delete;
+
+    /**
+     * @brief 注册一种发射器类型并分配它的粒子池。
+     * @return 发射器 ID；纹理加载失败时仍会注册（粒子不会被绘制）。
+     */
+    EmitterId registerEmitter(const ParticleEmitterDesc& desc);
+
+    void emit(EmitterId emitter, glm::vec2 position, std::uint32_t count);  ///< @brief 发射粒子，超出容量的部分会被丢弃
+    void update(float delta_time);                                          ///< @brief 更新所有粒子池
+    void render(SDL_Renderer* renderer, const Camera& camera);              ///< @brief 按纹理合批绘制所有可见的存活粒子
+    void clear();                                                           ///< @brief 清除所有存活粒子，保留已注册的发射器
+    void setCapacityScale(float scale);     ///< @brief 把各粒子池的存活上限设为容量的 scale 倍（0~1），用于画质调节
+    [[nodiscard]] float getCapacityScale() const { return capacity_scale_; }
+
+    [[nodiscard]] std::uint32_t getLiveCount() const;
+    [[nodiscard]] std::uint32_t getDrawCalls() const { return draw_calls_; }
+    [[nodiscard]] const ParticlePool& getPool(EmitterId emitter) const { return pools_[emitter]; }
+
+private:
+    void flush(SDL_Renderer* renderer, SDL_Texture* texture);   ///< @brief 提交当前顶点缓冲区并清空
+};
+
+} // namespace engine::render
+
+#endif //SUNNYLAND_PARTICLE_SYSTEM_H
@@ -0,0 +1,185 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#include "perf_overlay.h"
+#include "../core/frame_governor.h"
+#include "../resource/resource_manager.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <SDL3/SDL_render.h>
+#include <SDL3/SDL_timer.h>
+
+namespace engine::render {
+
+namespace {
+
+constexpr float PANEL_X = 8.0f;
+constexpr float PANEL_Y = 8.0f;
+constexpr float MIN_PANEL_WIDTH = 240.0f;
+constexpr float PADDING = 6.0f;
+constexpr float GLYPH_WIDTH = 8.0f;      // SDL_RenderDebugText 的字符为 8x8
+constexpr float LINE_HEIGHT = 10.0f;
+constexpr float GRAPH_HEIGHT = 64.0f;
+
+float hitRate(std::uint64_t hits, std::uint64_t misses) {
+    const auto total = hits + misses;
+    return total > 0 ? 100.0f * static_cast<float>(hits) / static_cast<float>(total) : 100.0f;
+}
+
+const char* loadName(engine::core::FrameGovernor::Load load) {
+    switch (load) {
+        case engine::core::FrameGovernor::Load::Over: return "over";
+        case engine::core::FrameGovernor::Load::Ok: return "ok";
+        case engine::core::FrameGovernor::Load::Spare: return "spare";
+        default: return "-";
+    }
+}
+
+} // namespace
+
+PerfOverlay::PerfOverlay() {
+    // 从当前计数开始统计，避免第一帧把启动阶段的分配和加载都算进去
+    engine::utils::Metrics::snapshot(previous_);
+    window_start_ = previous_;
+    window_history_.fill(previous_);
+}
+
+void PerfOverlay::update(float frame_seconds, int target_fps, const engine::resource::ResourceManager& resource_manager) {
+    using engine::utils::Metric;
+
+    const float frame_ms = frame_seconds * 1000.0f;
+    frame_ms_[history_head_] = frame_ms;
+    history_head_ = (history_head_ + 1) % HISTORY_SIZE;
+    history_count_ = std::min(history_count_ + 1, HISTORY_SIZE);
+    target_ms_ = target_fps > 0 ? 1000.0f / static_cast<float>(target_fps) : 0.0f;
+
+    engine::utils::MetricsSnapshot now;
+    engine::utils::Metrics::snapshot(now);
+    last_frame_draw_calls_ = now[Metric::DrawCalls] - previous_[Metric::DrawCalls];
+    last_frame_allocations_ = now[Metric::Allocations] - previous_[Metric::Allocations];
+    previous_ = now;
+
+    window_time_ += frame_seconds;
+    ++window_frames_;
+    window_max_ms_ = std::max(window_max_ms_, frame_ms);
+    if (window_time_ >= TEXT_REFRESH_INTERVAL) {
+        if (visible_) {
+            refreshText(resource_manager, now);
+        }
+        window_history_[window_history_head_] = now;
+        window_history_head_ = (window_history_head_ + 1) % HIT_RATE_WINDOWS;
+        window_start_ = now;
+        cpu_meter_.restart();
+        window_time_ = 0.0;
+        window_frames_ = 0;
+        window_max_ms_ = 0.0f;
+    }
+}
+
+void PerfOverlay::render(SDL_Renderer* renderer) {
+    if (!visible_ || !renderer) {
+        return;
+    }
+    const Uint64 start = SDL_GetPerformanceCounter();
+
+    SDL_BlendMode previous_blend = SDL_BLENDMODE_NONE;
+    SDL_GetRenderDrawBlendMode(renderer, &previous_blend);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+
+    // 文字长度随数值变化（如纹理数、画质调整的名称），按最长的一行确定宽度，避免文字画到面板外
+    std::size_t longest_line = 0;
+    for (const auto& line : lines_) {
+        longest_line = std::max(longest_line, std::strlen(line.data()));
+    }
+    const float panel_width = std::max(MIN_PANEL_WIDTH, GLYPH_WIDTH * static_cast<float>(longest_line) + PADDING * 2.0f);
+    const float text_height = LINE_COUNT * LINE_HEIGHT;
+    const SDL_FRect panel{PANEL_X, PANEL_Y, panel_width, PADDING * 3.0f + text_height + GRAPH_HEIGHT};
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 170);
+    SDL_RenderFillRect(renderer, &panel);
+
+    // 曲线的纵轴上限为目标帧时间的两倍（不限帧率时为 33.3ms），目标线位于正中
+    const SDL_FRect graph{PANEL_X + PADDING, PANEL_Y + PADDING * 2.0f + text_height, panel_width - PADDING * 2.0f, GRAPH_HEIGHT};
+    const float scale_ms = target_ms_ > 0.0f ? target_ms_ * 2.0f : 1000.0f / 30.0f;
+    const float bottom = graph.y + graph.h;
+    if (target_ms_ > 0.0f) {
+        const float y = bottom - graph.h * 0.5f;
+        SDL_SetRenderDrawColor(renderer, 90, 200, 90, 200);
+        SDL_RenderLine(renderer, graph.x, y, graph.x + graph.w, y);
+    }
+
+    const float step = graph.w / static_cast<float>(HISTORY_SIZE - 1);
+    const int oldest = (history_head_ - history_count_ + HISTORY_SIZE) % HISTORY_SIZE;
+    for (int i = 0; i < history_count_; ++i) {
+        const float ms = frame_ms_[(oldest + i) % HISTORY_SIZE];
+        const float x = graph.x + step * static_cast<float>(HISTORY_SIZE - history_count_ + i);
+        points_[i] = {x, bottom - graph.h * std::min(ms / scale_ms, 1.0f)};
+    }
+    if (history_count_ > 1) {
+        SDL_SetRenderDrawColor(renderer, 255, 210, 60, 255);
+        SDL_RenderLines(renderer, points_.data(), history_count_);
+    }
+
+    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+    for (int i = 0; i < LINE_COUNT; ++i) {
+        if (lines_[i][0] != '\0') {
+            SDL_RenderDebugText(renderer, PANEL_X + PADDING, PANEL_Y + PADDING + LINE_HEIGHT * static_cast<float>(i), lines_[i].data());
+        }
+    }
+
+    SDL_SetRenderDrawBlendMode(renderer, previous_blend);
+    last_draw_ms_ = static_cast<float>(SDL_GetPerformanceCounter() - start) * 1000.0f /
+                    static_cast<float>(SDL_GetPerformanceFrequency());
+}
+
+void PerfOverlay::refreshText(const engine::resource::ResourceManager& resource_manager, const engine::utils::MetricsSnapshot& now) {
+    using engine::utils::Metric;
+    using engine::utils::Metrics;
+
+    const double frames = std::max(window_frames_, 1);
+    const double avg_ms = window_time_ * 1000.0 / frames;
+    const double fps = window_time_ > 0.0 ? frames / window_time_ : 0.0;
+    const int target_fps = target_ms_ > 0.0f ? static_cast<int>(1000.0f / target_ms_ + 0.5f) : 0;
+    const auto delta = [&](Metric metric) { return now[metric] - window_start_[metric]; };
+    // 命中率取最近 HIT_RATE_WINDOWS 个窗口（window_history_ 中最旧的一份到现在）
+    const auto& hit_rate_start = window_history_[window_history_head_];
+    const auto windowHitRate = [&](Metric hits, Metric misses) {
+        return hitRate(now[hits] - hit_rate_start[hits], now[misses] - hit_rate_start[misses]);
+    };
+
+    std::snprintf(lines_[0].data(), LINE_LENGTH, "FPS %6.1f / %d   avg %.2f ms  max %.2f ms",
+                  fps, target_fps, avg_ms, window_max_ms_);
+    std::snprintf(lines_[1].data(), LINE_LENGTH, "draw calls %llu   (avg %.1f)",
+                  static_cast<unsigned long long>(last_frame_draw_calls_), static_cast<double>(delta(Metric::DrawCalls)) / frames);
+    if (Metrics::isAllocationTrackingEnabled()) {
+        std::snprintf(lines_[2].data(), LINE_LENGTH, "alloc/frame %llu   (avg %.1f, %.1f KB)",
+                      static_cast<unsigned long long>(last_frame_allocations_),
+                      static_cast<double>(delta(Metric::Allocations)) / frames,
+                      static_cast<double>(delta(Metric::AllocatedBytes)) / frames / 1024.0);
+    } else {
+        std::snprintf(lines_[2].data(), LINE_LENGTH, "alloc/frame n/a (SUNNYLAND_TRACK_ALLOCATIONS off)");
+    }
+    std::snprintf(lines_[3].data(), LINE_LENGTH, "textures %zu  hit %.1f%%   fonts %zu  hit %.1f%%",
+                  resource_manager.getTextureCount(),
+                  windowHitRate(Metric::TextureCacheHits, Metric::TextureCacheMisses),
+                  resource_manager.getFontCount(),
+                  windowHitRate(Metric::FontCacheHits, Metric::FontCacheMisses));
+    std::snprintf(lines_[4].data(), LINE_LENGTH, "sounds %zu (baked %llu)  music %zu  hit %.1f%%  load %.1f ms",
+                  resource_manager.getSoundCount(), static_cast<unsigned long long>(now[Metric::BakedAudioLoads]),
+                  resource_manager.getMusicCount(),
+                  windowHitRate(Metric::AudioCacheHits, Metric::AudioCacheMisses),
+                  static_cast<double>(now[Metric::AudioLoadMicros]) / 1000.0);
+    std::snprintf(lines_[5].data(), LINE_LENGTH, "overlay %.3f ms   cpu %.1f%%", last_draw_ms_, cpu_meter_.getUsagePercent());
+    if (governor_ && governor_->isEnabled()) {
+        const auto* last = governor_->getLastDecision();
+        std::snprintf(lines_[6].data(), LINE_LENGTH, "quality -%d/%d %-5s p90 %.1f/%.1f ms  %s %s%d",
+                      governor_->getTotalLevel(), governor_->getMaxTotalLevel(), loadName(governor_->getLoad()),
+                      governor_->getWorkP90Ms(), governor_->getFrameP90Ms(),
+                      last ? last->knob.c_str() : "", last ? "->" : "", last ? last->to_level : 0);
+    } else {
+        std::snprintf(lines_[6].data(), LINE_LENGTH, "quality fixed (adaptive_quality off)");
+    }
+}
+
+} // namespace engine::render
@@ -0,0 +1,103 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#ifndef SUNNYLAND_PERF_OVERLAY_H
+#define SUNNYLAND_PERF_OVERLAY_H
+
+#include "../utils/cpu_usage.h"
+#include "../utils/metrics.h"
+#include <array>        // 用于 std::array
+#include <SDL3/SDL_rect.h>
+
+struct SDL_Renderer;
+
+namespace engine::resource {
+class ResourceManager;
+}
+
+namespace engine::core {
+class FrameGovernor;
+}
+
+namespace engine::render {
+
+/**
+ * @brief 运行时性能面板（默认 F3 切换）：帧时间曲线、FPS 与目标帧率、绘制调用、
+ *        资源缓存驻留数量与最近约 1 秒的命中率、每帧内存分配次数、进程 CPU 占用率，以及 FrameGovernor 的画质档位和最近一次调整。
+ *
+ * 为了能在正式测试中常开，绘制开销被严格限制：
+ * - update() 每帧只读取一次计数器快照并写入环形缓冲区；
+ * - 文字每 TEXT_REFRESH_INTERVAL 秒用 snprintf 格式化到固定缓冲区，绘制时不分配内存；
+ * - 曲线一次 SDL_RenderLines，文字用 SDL_RenderDebugText（内置 8x8 字体，无需加载字体），面板宽度随最长的一行变化。
+ * 面板自身的绘制耗时也会显示出来，便于确认开销。
+ */
+class PerfOverlay final {
+private:
+    static constexpr int HISTORY_SIZE = 180;                ///< @brief 曲线保留的帧数
+    static constexpr int LINE_COUNT = 7;
+    static constexpr int LINE_LENGTH = 72;
+    static constexpr double TEXT_REFRESH_INTERVAL = 0.25;   ///< @brief 文字刷新间隔（秒），同时也是平均值的统计窗口
+    static constexpr int HIT_RATE_WINDOWS = 4;              ///< @brief 命中率跨越的统计窗口数（约 1 秒），累计值会掩盖近期的变化
+
+    bool visible_ = false;
+    const engine::core::FrameGovernor* governor_ = nullptr;     ///< @brief 可选，为空时不显示画质一行
+
+    // --- 帧时间历史（环形缓冲区） ---
+    std::array<float, HISTORY_SIZE> frame_ms_{};
+    int history_head_ = 0;      ///< @brief 下一次写入的位置
+    int history_count_ = 0;
+    std::array<SDL_FPoint, HISTORY_SIZE> points_{};
+    float target_ms_ = 0.0f;
+
+    // --- 计数器 ---
+    engine::utils::MetricsSnapshot previous_{};     ///< @brief 上一帧结束时的快照
+    engine::utils::MetricsSnapshot window_start_{}; ///< @brief 当前统计窗口开始时的快照
+    std::array<engine::utils::MetricsSnapshot, HIT_RATE_WINDOWS> window_history_{};  ///< @brief 最近几个统计窗口开始时的快照（环形）
+    int window_history_head_ = 0;                   ///< @brief 最旧的一份，也是下一次写入的位置
+    std::uint64_t last_frame_draw_calls_ = 0;
+    std::uint64_t last_frame_allocations_ = 0;
+
+    // --- 统计窗口 ---
+    double window_time_ = 0.0;
+    int window_frames_ = 0;
+    float window_max_ms_ = 0.0f;
+    engine::utils::CpuMeter cpu_meter_;     ///< @brief 统计窗口内的进程 CPU 占用率
+
+    // --- 预先格式化好的文字 ---
+    std::array<std::array<char, LINE_LENGTH>, LINE_COUNT> lines_{};
+    float last_draw_ms_ = 0.0f;     ///< @brief 上一次 render() 的 CPU 耗时
+
+public:
+    PerfOverlay();
+
+    PerfOverlay(const PerfOverlay&) = delete;
+    PerfOverlay& operator=(const PerfOverlay&) = delete;
+    PerfOverlay(PerfOverlay&&) = delete;
+    PerfOverlay& operator=(PerfOverlay&&) = delete;
+
+    void toggle() { visible_ = !visible_; }
+    void setVisible(bool visible) { visible_ = visible; }
+    [[nodiscard]] bool isVisible() const { return visible_; }
+    void setGovernor(const engine::core::FrameGovernor* governor) { governor_ = governor; }
+
+    /**
+     * @brief 每帧调用一次（隐藏时也需要调用，以保证打开面板时有完整的历史）。
+     * @param frame_seconds 上一帧的真实耗时（未缩放）。
+     * @param target_fps 目标帧率，0 表示不限制。
+     * @param resource_manager 用于读取缓存驻留数量。
+     */
+    void update(float frame_seconds, int target_fps, const engine::resource::ResourceManager& resource_manager);
+
+    /**
+     * @brief 在所有游戏内容之后、SDL_RenderPresent 之前调用。隐藏时直接返回。
+     */
+    void render(SDL_Renderer* renderer);
+
+private:
+    void refreshText(const engine::resource::ResourceManager& resource_manager, const engine::utils::MetricsSnapshot& now);
+};
+
+} // namespace engine::render
+
+#endif //SUNNYLAND_PERF_OVERLAY_H
@@ -0,0 +1,38 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#include "quality_knobs.h"
+#include "animation.h"
+#include "parallax_background.h"
+#include "particle_system.h"
+#include <array>        // 用于 std::array
+#include <cstdint>      // 用于 SIZE_MAX
+
+namespace engine::render {
+
+namespace {
+
+constexpr std::array<float, 4> PARTICLE_SCALES = {1.0f, 0.6f, 0.35f, 0.15f};
+constexpr std::array<std::uint32_t, 4> OFFSCREEN_INTERVALS = {1, 2, 4, 8};
+constexpr std::array<std::size_t, 4> PARALLAX_LAYERS = {SIZE_MAX, 3, 2, 1};
+
+} // namespace
+
+engine::core::KnobId addParticleKnob(engine::core::FrameGovernor& governor, ParticleSystem& particles, const void* owner) {
+    return governor.addKnob("particles", engine::core::knob_priority::PARTICLES, static_cast<int>(PARTICLE_SCALES.size()) - 1,
+                            [&particles](int level) { particles.setCapacityScale(PARTICLE_SCALES[level]); }, owner);
+}
+
+engine::core::KnobId addAnimationKnob(engine::core::FrameGovernor& governor, AnimationSystem& animations, const void* owner) {
+    return governor.addKnob("offscreen_animation", engine::core::knob_priority::OFFSCREEN_ANIMATION,
+                            static_cast<int>(OFFSCREEN_INTERVALS.size()) - 1,
+                            [&animations](int level) { animations.setOffscreenInterval(OFFSCREEN_INTERVALS[level]); }, owner);
+}
+
+engine::core::KnobId addParallaxKnob(engine::core::FrameGovernor& governor, ParallaxBackground& background, const void* owner) {
+    return governor.addKnob("parallax", engine::core::knob_priority::PARALLAX, static_cast<int>(PARALLAX_LAYERS.size()) - 1,
+                            [&background](int level) { background.setMaxLayers(PARALLAX_LAYERS[level]); }, owner);
+}
+
+} // namespace engine::render
@@ -0,0 +1,26 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#ifndef SUNNYLAND_QUALITY_KNOBS_H
+#define SUNNYLAND_QUALITY_KNOBS_H
+
+#include "../core/frame_governor.h"
+
+namespace engine::render {
+
+class ParticleSystem;
+class AnimationSystem;
+class ParallaxBackground;
+
+/**
+ * @brief 把渲染系统注册为 FrameGovernor 的画质旋钮。通常在场景 init() 中调用，owner 传场景自身，
+ *        场景 clean() 之后 SceneManager 会移除它注册的所有旋钮；系统的生命周期必须长于旋钮。
+ */
+engine::core::KnobId addParticleKnob(engine::core::FrameGovernor& governor, ParticleSystem& particles, const void* owner);        ///< @brief 粒子上限：100% / 60% / 35% / 15%
+engine::core::KnobId addAnimationKnob(engine::core::FrameGovernor& governor, AnimationSystem& animations, const void* owner);     ///< @brief 屏幕外动画：每 1 / 2 / 4 / 8 帧更新一次
+engine::core::KnobId addParallaxKnob(engine::core::FrameGovernor& governor, ParallaxBackground& background, const void* owner);  ///< @brief 视差层：全部 / 3 / 2 / 1 层
+
+} // namespace engine::render
+
+#endif //SUNNYLAND_QUALITY_KNOBS_H
@@ -0,0 +1,108 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#include "virtual_canvas.h"
+#include "../utils/metrics.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <SDL3/SDL_events.h>
+#include <SDL3/SDL_render.h>
+#include <SDL3/SDL_video.h>
+#include <spdlog/spdlog.h>
+
+namespace engine::render {
+
+VirtualCanvas::VirtualCanvas(SDL_Renderer* renderer, glm::ivec2 logical_size)
+    : renderer_(renderer), logical_size_(glm::max(logical_size, glm::ivec2(1))) {
+    if (!renderer_) {
+        throw std::runtime_error("VirtualCanvas 错误: 渲染器指针为空。");
+    }
+    texture_ = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, logical_size_.x, logical_size_.y);
+    if (!texture_) {
+        throw std::runtime_error("VirtualCanvas 错误: SDL_CreateTexture 失败: " + std::string(SDL_GetError()));
+    }
+    SDL_SetTextureScaleMode(texture_, SDL_SCALEMODE_NEAREST);
+    SDL_SetTextureBlendMode(texture_, SDL_BLENDMODE_NONE);     // 画布不透明，放大时不需要混合
+    spdlog::info("虚拟画布: {}x{}", logical_size_.x, logical_size_.y);
+}
+
+VirtualCanvas::~VirtualCanvas() {
+    if (texture_) {
+        SDL_DestroyTexture(texture_);
+    }
+}
+
+void VirtualCanvas::begin() {
+    SDL_SetRenderTarget(renderer_, texture_);
+    SDL_SetRenderDrawColor(renderer_, 0, 0, 0, 255);
+    SDL_RenderClear(renderer_);
+}
+
+void VirtualCanvas::present() {
+    SDL_SetRenderTarget(renderer_, nullptr);
+    updateDestRect();
+    SDL_SetRenderDrawColor(renderer_, 0, 0, 0, 255);
+    SDL_RenderClear(renderer_);
+    SDL_RenderTexture(renderer_, texture_, nullptr, &dest_rect_);
+    engine::utils::Metrics::add(engine::utils::Metric::DrawCalls);
+}
+
+void VirtualCanvas::updateDestRect() {
+    int output_w = 0;
+    int output_h = 0;
+    SDL_GetCurrentRenderOutputSize(renderer_, &output_w, &output_h);
+    SDL_Window* window = SDL_GetRenderWindow(renderer_);
+    const float density = window ? SDL_GetWindowPixelDensity(window) : 0.0f;
+    pixel_density_ = density > 0.0f ? density : 1.0f;
+
+    // 取能完整放下画布的最大整数倍；窗口比画布还小时只能按比例缩小
+    const float fit = std::min(static_cast<float>(output_w) / static_cast<float>(logical_size_.x),
+                               static_cast<float>(output_h) / static_cast<float>(logical_size_.y));
+    scale_ = fit >= 1.0f ? std::floor(fit) : std::max(fit, 0.0f);
+
+    const float width = static_cast<float>(logical_size_.x) * scale_;
+    const float height = static_cast<float>(logical_size_.y) * scale_;
+    dest_rect_ = {std::floor((static_cast<float>(output_w) - width) * 0.5f),
+                  std::floor((static_cast<float>(output_h) - height) * 0.5f), width, height};
+}
+
+glm::vec2 VirtualCanvas::windowToCanvas(glm::vec2 window_pos) const {
+    if (scale_ <= 0.0f) {
+        return glm::vec2(0.0f);
+    }
+    return (window_pos * pixel_density_ - glm::vec2(dest_rect_.x, dest_rect_.y)) / scale_;
+}
+
+void VirtualCanvas::convertEvent(SDL_Event& event) const {
+    switch (event.type) {
+        case SDL_EVENT_MOUSE_MOTION: {
+            const auto position = windowToCanvas({event.motion.x, event.motion.y});
+            event.motion.x = position.x;
+            event.motion.y = position.y;
+            const float rel_scale = scale_ > 0.0f ? pixel_density_ / scale_ : 1.0f;
+            event.motion.xrel *= rel_scale;
+            event.motion.yrel *= rel_scale;
+            break;
+        }
+        case SDL_EVENT_MOUSE_BUTTON_DOWN:
+        case SDL_EVENT_MOUSE_BUTTON_UP: {
+            const auto position = windowToCanvas({event.button.x, event.button.y});
+            event.button.x = position.x;
+            event.button.y = position.y;
+            break;
+        }
+        case SDL_EVENT_MOUSE_WHEEL: {
+            const auto position = windowToCanvas({event.wheel.mouse_x, event.wheel.mouse_y});
+            event.wheel.mouse_x = position.x;
+            event.wheel.mouse_y = position.y;
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+} // namespace engine::render
@@ -0,0 +1,71 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#ifndef SUNNYLAND_VIRTUAL_CANVAS_H
+#define SUNNYLAND_VIRTUAL_CANVAS_H
+
+#include <glm/glm.hpp>
+#include <SDL3/SDL_rect.h>
+
+struct SDL_Renderer;
+struct SDL_Texture;
+union SDL_Event;
+
+namespace engine::render {
+
+/**
+ * @brief 固定低分辨率的虚拟画布：整个场景先画到 logical_size 大小的渲染目标纹理上，
+ *        再用一次最近邻、整数倍的放大绘制到窗口中央，四周留黑边。
+ *
+ * 美术资源是 16px 像素画，按窗口原生分辨率绘制只会白白增加填充率和顶点开销；
+ * 在画布上绘制时，开销随放大倍数的平方下降，而且任何窗口尺寸下每个像素都是等大的方块。
+ * 窗口小于画布时退化为非整数缩小。
+ *
+ * SDL3 的逻辑分辨率（SDL_SetRenderLogicalPresentation）只对坐标做缩放，仍按窗口分辨率光栅化，
+ * 达不到降低填充率的目的，因此这里显式使用渲染目标。
+ */
+class VirtualCanvas final {
+private:
+    SDL_Renderer* renderer_ = nullptr;      ///< @brief 非拥有指针
+    SDL_Texture* texture_ = nullptr;
+    glm::ivec2 logical_size_;
+    SDL_FRect dest_rect_{};                 ///< @brief 上一次 present() 时画布在窗口中的位置（像素）
+    float scale_ = 1.0f;                    ///< @brief 上一次 present() 时的放大倍数
+    float pixel_density_ = 1.0f;            ///< @brief 窗口坐标到像素的比例，HiDPI 窗口上大于 1
+
+public:
+    /**
+     * @brief 构造函数，创建画布纹理。
+     * @throws std::runtime_error 渲染器不支持渲染目标或纹理创建失败时。
+     */
+    VirtualCanvas(SDL_Renderer* renderer, glm::ivec2 logical_size);
+    ~VirtualCanvas();
+
+    VirtualCanvas(const VirtualCanvas&) = delete;
+    VirtualCanvas& operator=(const VirtualCanvas&) = delete;
+    VirtualCanvas(VirtualCanvas&&) = delete;
+    VirtualCanvas& operator=(VirtualCanvas&&) = delete;
+
+    void begin();       ///< @brief 把渲染目标切换到画布并清屏，之后的绘制都以画布像素为单位
+    void present();     ///< @brief 切回窗口，清出黑边并把画布放大绘制到窗口中央（不调用 SDL_RenderPresent）
+
+    /**
+     * @brief 把鼠标事件中的窗口坐标换算为画布坐标，场景收到的坐标与绘制坐标一致。
+     *
+     * 事件坐标以窗口坐标（点）为单位，而黑边和放大倍数以像素计算，HiDPI 窗口上先乘以像素密度再换算。
+     */
+    void convertEvent(SDL_Event& event) const;
+    [[nodiscard]] glm::vec2 windowToCanvas(glm::vec2 window_pos) const;
+
+    [[nodiscard]] glm::ivec2 getLogicalSize() const { return logical_size_; }
+    [[nodiscard]] const SDL_FRect& getDestRect() const { return dest_rect_; }
+    [[nodiscard]] float getScale() const { return scale_; }
+
+private:
+    void updateDestRect();
+};
+
+} // namespace engine::render
+
+#endif //SUNNYLAND_VIRTUAL_CANVAS_H
@@ -3,90 +3,135 @@
 //
 
 #include "audio_manager.h"
+#include "baked_audio.h"
+#include "../utils/binary_stream.h"
+#include "../utils/log.h"
+#include "../utils/metrics.h"
 #include <spdlog/spdlog.h>
+#include <filesystem>
 #include <stdexcept>
 
 namespace engine::resource {
 AudioManager::AudioManager() {
-    // 1. 初始化 SDL 音频子系统 (SDL3_mixer 依赖它)
+    // SDL 音频子系统和 SDL_mixer 必须已由主线程初始化（SDL_InitSubSystem 只能在主线程调用），这里只打开设备，
+    // 因此构造函数可以在后台线程执行
     if (!SDL_WasInit(SDL_INIT_AUDIO)) {
-        if (!SDL_Init(SDL_INIT_AUDIO)) {
-            throw std::runtime_error("AudioManager 错误: SDL_Init(AUDIO) 失败: " + std::string(SDL_GetError()));
-        }
+        throw std::runtime_error("AudioManager 错误: SDL 音频子系统未初始化。");
     }
-    // 2. 初始化 SDL_mixer
-    MIX_Init();
     MIX_Mixer* raw_mixer = MIX_CreateMixerDevice(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, nullptr);
     if (!raw_mixer) {
         throw std::runtime_error("AudioManager 错误: MIX_CreateMixerDevice 失败: " + std::string(SDL_GetError()));
     }
     mixer_.reset(raw_mixer);
-    spdlog::debug("当前使用的音频驱动: {}", SDL_GetCurrentAudioDriver());
+    MIX_GetMixerFormat(raw_mixer, &mixer_spec_);
+    SPDLOG_DEBUG("当前使用的音频驱动: {}，混音格式 {} {} Hz {} 声道", SDL_GetCurrentAudioDriver(),
+                  SDL_GetAudioFormatName(mixer_spec_.format), mixer_spec_.freq, mixer_spec_.channels);
 
     // 可以加入 track
 
-    spdlog::trace("AudioManager 构造成功。");
+    SPDLOG_TRACE("AudioManager 构造成功。");
 }
 
 
 AudioManager::~AudioManager() {
     // 停止所有播放
-    spdlog::debug("停止所有播放");
+    SPDLOG_DEBUG("停止所有播放");
     if (mixer_) {
         MIX_PauseAllTracks(mixer_.get());
     }
 
     if (!sounds_.empty()) {
-        spdlog::debug("AudioManager sounds_ 不为空，调用 clearSounds 处理清理逻辑。");
+        SPDLOG_DEBUG("AudioManager sounds_ 不为空，调用 clearSounds 处理清理逻辑。");
         clearSounds();       // 调用 clearSounds 处理清理逻辑
     }
     if (!music_.empty()) {
-        spdlog::debug("AudioManager music_ 不为空，调用 clearMusic 处理清理逻辑。");
+        SPDLOG_DEBUG("AudioManager music_ 不为空，调用 clearMusic 处理清理逻辑。");
         clearMusic();        // 调用 clearMusic 处理清理逻辑
     }
     //MIX_Quit();
-    spdlog::trace("AudioManager 析构成功。");
+    SPDLOG_TRACE("AudioManager 析构成功。");
 }
 
 MIX_Audio* AudioManager::loadSound(const std::string& file_path) {
     // 首先检查缓存
     auto it = sounds_.find(file_path);
     if (it != sounds_.end()) {
+        engine::utils::Metrics::add(engine::utils::Metric::AudioCacheHits);
         return it->second.get();
     }
 
     // 缓存中不存在，则加载音效
-    spdlog::debug("正在加载音效：{}", file_path);
+    engine::utils::Metrics::add(engine::utils::Metric::AudioCacheMisses);
+    SPDLOG_DEBUG("正在加载音效：{}", file_path);
     // SDL3_mixer 加载函数统一为 MIX_LoadAudio
     // 参数3: predecode (true=预解码为PCM，加载慢但播放快；false=流式解码，省内存)
     // 对于音效建议 true，长音乐建议 false。这里为了通用简单设为 true，
     // 如果你有长音乐文件，建议根据文件扩展名或单独的接口来区分。
-    MIX_Audio* raw_sound = MIX_LoadAudio(mixer_.get(), file_path.c_str(), true);
+    // 优先使用离线烘焙的 .slpcm，没有或已过期时再解码源文件
+    const Uint64 start_ns = SDL_GetTicksNS();
+    MIX_Audio* raw_sound = loadBakedSound(file_path);
+    const bool baked = raw_sound != nullptr;
     if (!raw_sound) {
-        spdlog::error("加载音效 '{}' 失败：{}", file_path, SDL_GetError());
+        raw_sound = MIX_LoadAudio(mixer_.get(), file_path.c_str(), true);
+    }
+    if (!raw_sound) {
+        SUNNYLAND_LOG_EVERY(spdlog::level::err, 1000, "加载音效 '{}' 失败：{}", file_path, SDL_GetError());
         return nullptr;
     }
+    const Uint64 elapsed_us = (SDL_GetTicksNS() - start_ns) / 1000;
+    engine::utils::Metrics::add(engine::utils::Metric::AudioLoadMicros, elapsed_us);
+    if (baked) {
+        engine::utils::Metrics::add(engine::utils::Metric::BakedAudioLoads);
+    }
 
     // 使用 unique_ptr 存储到缓存中
     sounds_.emplace(file_path, std::unique_ptr<MIX_Audio, SDLAudioDeleter>(raw_sound));
-    spdlog::debug("成功加载并缓存音效：{}", file_path);
+    SPDLOG_DEBUG("成功加载并缓存音效：{}（{}，{:.2f} ms）", file_path, baked ? "烘焙 PCM" : "解码",
+                  static_cast<double>(elapsed_us) / 1000.0);
     return raw_sound;
 }
 
+MIX_Audio* AudioManager::loadBakedSound(const std::string& file_path) {
+    const auto baked_path = getBakedAudioPath(file_path);
+    const bool requested_baked = baked_path == file_path;   // 直接请求 .slpcm 时不检查源文件
+    std::error_code ec;
+    if (!requested_baked && !std::filesystem::exists(baked_path, ec)) {
+        return nullptr;
+    }
+    if (!engine::utils::readFileBytes(baked_path, baked_file_buffer_)) {
+        spdlog::error("读取烘焙音效失败: '{}'", baked_path);
+        return nullptr;
+    }
+    SDL_AudioSpec spec{};
+    std::span<const std::byte> pcm;
+    if (!isBakedAudioCurrent(baked_file_buffer_, requested_baked ? std::string() : file_path) ||
+        !readBakedAudio(baked_file_buffer_, spec, pcm)) {
+        spdlog::warn("烘焙音效 '{}' 无效或已过期，改为解码源文件。请重新运行 audio_baker。", baked_path);
+        return nullptr;
+    }
+    if (spec.format != mixer_spec_.format || spec.channels != mixer_spec_.channels || spec.freq != mixer_spec_.freq) {
+        // 仍然省去了解码，只是混音线程需要转换
+        spdlog::warn("烘焙音效 '{}' 的格式（{} Hz {} 声道）与混音器（{} Hz {} 声道）不一致，播放时需要转换。",
+                     baked_path, spec.freq, spec.channels, mixer_spec_.freq, mixer_spec_.channels);
+    }
+    return MIX_LoadRawAudio(mixer_.get(), pcm.data(), pcm.size(), &spec);
+}
+
 MIX_Audio* AudioManager::getSound(const std::string& file_path) {
     auto it = sounds_.find(file_path);
     if (it != sounds_.end()) {
+        engine::utils::Metrics::add(engine::utils::Metric::AudioCacheHits);
         return it->second.get();
     }
 
-    spdlog::warn("音效 '{}' 不在缓存中，尝试加载。", file_path);
+    SUNNYLAND_LOG_EVERY(spdlog::level::warn, 1000, "音效 '{}' 不在缓存中，尝试加载。", file_path);
     return loadSound(file_path);
 }
 
 void AudioManager::unloadSound(const std::string& file_path) {
     auto it = sounds_.find(file_path);
     if (it != sounds_.end()) {
-        spdlog::debug("卸载音效：{}", file_path);
+        SPDLOG_DEBUG("卸载音效：{}", file_path);
         sounds_.erase(it);       // unique_ptr 会处理 MIX_DestroyAudio
     }
     else {
@@ -96,7 +141,7 @@ void AudioManager::unloadSound(const std::string& file_path) {
 
 void AudioManager::clearSounds() {
     if (!sounds_.empty()) {
-        spdlog::debug("正在清除所有 {} 个缓存的音效。", sounds_.size());
+        SPDLOG_DEBUG("正在清除所有 {} 个缓存的音效。", sounds_.size());
         sounds_.clear(); // unique_ptr处理删除
     }
 }
@@ -105,41 +150,44 @@ MIX_Audio* AudioManager::loadMusic(const std::string& file_path) {
     // 首先检查缓存
     auto it = music_.find(file_path);
     if (it != music_.end()) {
+        engine::utils::Metrics::add(engine::utils::Metric::AudioCacheHits);
         return it->second.get();
     }
 
     // 缓存中不存在，则加载音乐
-    spdlog::debug("正在加载音乐：{}", file_path);
+    engine::utils::Metrics::add(engine::utils::Metric::AudioCacheMisses);
+    SPDLOG_DEBUG("正在加载音乐：{}", file_path);
     // SDL3_mixer 加载函数统一为 MIX_LoadAudio
     // 参数3: predecode (true=预解码为PCM，加载慢但播放快；false=流式解码，省内存)
     // 对于音乐建议 false，音效建议 true。这里为了通用简单设为 false，
     // 如果你有短音乐文件，建议根据文件扩展名或单独的接口来区分。
     MIX_Audio* raw_music = MIX_LoadAudio(mixer_.get(), file_path.c_str(), false);
     if (!raw_music) {
-        spdlog::error("加载音乐 '{}' 失败：{}", file_path, SDL_GetError());
+        SUNNYLAND_LOG_EVERY(spdlog::level::err, 1000, "加载音乐 '{}' 失败：{}", file_path, SDL_GetError());
         return nullptr;
     }
 
     // 使用 unique_ptr 存储到缓存中
     music_.emplace(file_path, std::unique_ptr<MIX_Audio, SDLAudioDeleter>(raw_music));
-    spdlog::debug("成功加载并缓存音乐：{}", file_path);
+    SPDLOG_DEBUG("成功加载并缓存音乐：{}", file_path);
     return raw_music;
 }
 
 MIX_Audio* AudioManager::getMusic(const std::string& file_path) {
     auto it = music_.find(file_path);
     if (it != music_.end()) {
+        engine::utils::Metrics::add(engine::utils::Metric::AudioCacheHits);
         return it->second.get();
     }
 
-    spdlog::warn("音乐 '{}' 不在缓存中，尝试加载。", file_path);
+    SUNNYLAND_LOG_EVERY(spdlog::level::warn, 1000, "音乐 '{}' 不在缓存中，尝试加载。", file_path);
     return loadMusic(file_path);
 }
 
 void AudioManager::unloadMusic(const std::string& file_path) {
     auto it = music_.find(file_path);
     if (it != music_.end()) {
-        spdlog::debug("卸载音乐：{}", file_path);
+        SPDLOG_DEBUG("卸载音乐：{}", file_path);
         music_.erase(it);       // unique_ptr 会处理 MIX_DestroyAudio
     }
     else {
@@ -149,7 +197,7 @@ void AudioManager::unloadMusic(const std::string& file_path) {
 
 void AudioManager::clearMusic() {
     if (!music_.empty()) {
-        spdlog::debug("正在清除所有 {} 个缓存的音乐。", music_.size());
+        SPDLOG_DEBUG("正在清除所有 {} 个缓存的音乐。", music_.size());
         music_.clear(); // unique_ptr处理删除
     }
 }
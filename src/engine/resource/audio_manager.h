@@ -9,6 +9,7 @@
 #include <stdexcept>    // 用于 std::runtime_error
 #include <string>       // 用于 std::string
 #include <unordered_map> // 用于 std::unordered_map
+#include <vector>       // 用于 std::vector
 
 #include <SDL3_mixer/SDL_mixer.h>
 
@@ -17,6 +18,7 @@ namespace engine::resource {
  * @brief 管理 SDL_mixer 音效 (Mix_Chunk) 和音乐 (Mix_Music)。
  *
  * 提供音频资源的加载和缓存功能。构造失败时会抛出异常。
+ * 加载音效时若同目录下有未过期的同名 .slpcm（见 baked_audio.h），直接载入其中已转换好的 PCM，不再解码。
  * 仅供 ResourceManager 内部使用。
  */
 class AudioManager final{
@@ -44,11 +46,13 @@ private:
     std::unordered_map<std::string, std::unique_ptr<MIX_Audio,SDLAudioDeleter>> music_;
 
     std::unique_ptr<MIX_Mixer, MIX_MixerDeleter> mixer_;
+    SDL_AudioSpec mixer_spec_{};                ///< @brief 混音器输出格式，烘焙音效与之一致时播放无需转换
+    std::vector<std::byte> baked_file_buffer_;  ///< @brief 读取 .slpcm 的复用缓冲区（MIX_LoadRawAudio 会复制数据）
 
 public:
     /**
-     * @brief 构造函数。初始化 SDL_mixer 并打开音频设备。
-     * @throws std::runtime_error 如果 SDL_mixer 初始化或打开音频设备失败。
+     * @brief 构造函数。打开音频设备。调用前主线程必须已完成 SDL_InitSubSystem(SDL_INIT_AUDIO) 和 MIX_Init()。
+     * @throws std::runtime_error 如果音频子系统未初始化或打开音频设备失败。
      */
     AudioManager();
 
@@ -63,6 +67,7 @@ private:
 
     MIX_Audio* loadSound(const std::string& file_path); ///< @brief 加载音效文件，返回 Mix_Chunk*。
     MIX_Audio* getSound(const std::string& file_path);  ///< @brief 获取已加载的音效，如果未加载则调用 loadSound 加载。
+    MIX_Audio* loadBakedSound(const std::string& file_path); ///< @brief 尝试从对应的 .slpcm 载入，不存在或无效时返回 nullptr
 
     void unloadSound(const std::string& file_path);
     void clearSounds();
@@ -75,6 +80,9 @@ private:
 
     void clearAudio();
 
+    [[nodiscard]] std::size_t getSoundCount() const { return sounds_.size(); }
+    [[nodiscard]] std::size_t getMusicCount() const { return music_.size(); }
+
 };
 
 
@@ -0,0 +1,138 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#include "baked_audio.h"
+#include "../utils/binary_stream.h"
+#include <cstring>
+#include <filesystem>
+#include <vector>
+#include <SDL3_mixer/SDL_mixer.h>
+#include <spdlog/spdlog.h>
+
+namespace engine::resource {
+
+namespace {
+
+constexpr int DECODE_CHUNK_BYTES = 64 * 1024;
+
+struct SourceStamp {
+    std::uint64_t size = 0;
+    std::int64_t mtime = 0;
+};
+
+SourceStamp getSourceStamp(const std::string& path) {
+    std::error_code ec;
+    SourceStamp stamp;
+    stamp.size = static_cast<std::uint64_t>(std::filesystem::file_size(path, ec));
+    stamp.mtime = static_cast<std::int64_t>(std::filesystem::last_write_time(path, ec).time_since_epoch().count());
+    return stamp;
+}
+
+bool readHeader(std::span<const std::byte> file_data, BakedAudioHeader& header) {
+    if (file_data.size() < sizeof(BakedAudioHeader)) {
+        return false;
+    }
+    std::memcpy(&header, file_data.data(), sizeof(BakedAudioHeader));
+    return header.magic == BakedAudioHeader::MAGIC && header.version == BakedAudioHeader::VERSION &&
+           header.channels > 0 && header.freq > 0 &&
+           header.data_size == file_data.size() - sizeof(BakedAudioHeader);
+}
+
+} // namespace
+
+std::string getBakedAudioPath(const std::string& source_path) {
+    std::filesystem::path path(source_path);
+    if (path.extension() == BAKED_AUDIO_EXTENSION) {
+        return source_path;
+    }
+    return path.replace_extension(BAKED_AUDIO_EXTENSION).generic_string();
+}
+
+bool bakeAudio(const std::string& source_path, const std::string& baked_path, const SDL_AudioSpec& target,
+               double max_seconds, AudioBakeResult* result) {
+    MIX_AudioDecoder* decoder = MIX_CreateAudioDecoder(source_path.c_str(), 0);
+    if (!decoder) {
+        spdlog::error("无法解码音频 '{}': {}", source_path, SDL_GetError());
+        return false;
+    }
+    AudioBakeResult local;
+    MIX_GetAudioDecoderFormat(decoder, &local.source_spec);
+
+    // MIX_DecodeAudio 按 target 输出，重采样和格式转换都在这里离线完成
+    const auto bytes_per_second = static_cast<double>(SDL_AUDIO_BYTESIZE(target.format)) * target.channels * target.freq;
+    const auto max_bytes = static_cast<std::size_t>(max_seconds * bytes_per_second);
+    std::vector<std::byte> buffer;
+    BakedAudioHeader header;
+    engine::utils::BinaryWriter writer(buffer);
+    writer.write(header);   // 先占位，解码完成后回填
+    bool ok = true;
+    while (true) {
+        const auto offset = buffer.size();
+        buffer.resize(offset + DECODE_CHUNK_BYTES);
+        const int decoded = MIX_DecodeAudio(decoder, buffer.data() + offset, DECODE_CHUNK_BYTES, &target);
+        if (decoded < 0) {
+            spdlog::error("解码音频 '{}' 失败: {}", source_path, SDL_GetError());
+            ok = false;
+            break;
+        }
+        buffer.resize(offset + static_cast<std::size_t>(decoded));
+        if (decoded == 0) {
+            break;
+        }
+        if (buffer.size() - sizeof(BakedAudioHeader) > max_bytes) {
+            ok = false;     // 时长超限（多半是音乐），由调用方决定如何处理
+            break;
+        }
+    }
+    MIX_DestroyAudioDecoder(decoder);
+
+    local.data_size = buffer.size() - sizeof(BakedAudioHeader);
+    local.seconds = static_cast<double>(local.data_size) / bytes_per_second;
+    if (result) {
+        *result = local;
+    }
+    if (!ok) {
+        return false;
+    }
+
+    const auto stamp = getSourceStamp(source_path);
+    header.format = static_cast<std::uint32_t>(target.format);
+    header.channels = static_cast<std::uint32_t>(target.channels);
+    header.freq = static_cast<std::uint32_t>(target.freq);
+    header.data_size = local.data_size;
+    header.source_size = stamp.size;
+    header.source_mtime = stamp.mtime;
+    std::memcpy(buffer.data(), &header, sizeof(header));
+    if (!engine::utils::writeFileBytes(baked_path, buffer)) {
+        spdlog::error("写入烘焙音频失败: '{}'", baked_path);
+        return false;
+    }
+    return true;
+}
+
+bool isBakedAudioCurrent(std::span<const std::byte> file_data, const std::string& source_path) {
+    BakedAudioHeader header;
+    if (!readHeader(file_data, header)) {
+        return false;
+    }
+    if (source_path.empty()) {
+        return true;
+    }
+    const auto stamp = getSourceStamp(source_path);
+    return header.source_size == stamp.size && header.source_mtime == stamp.mtime;
+}
+
+bool readBakedAudio(std::span<const std::byte> file_data, SDL_AudioSpec& spec, std::span<const std::byte>& pcm) {
+    BakedAudioHeader header;
+    if (!readHeader(file_data, header)) {
+        return false;
+    }
+    spec.format = static_cast<SDL_AudioFormat>(header.format);
+    spec.channels = static_cast<int>(header.channels);
+    spec.freq = static_cast<int>(header.freq);
+    pcm = file_data.subspan(sizeof(BakedAudioHeader));
+    return true;
+}
+
+} // namespace engine::resource
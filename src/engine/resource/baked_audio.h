@@ -0,0 +1,71 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#ifndef SUNNYLAND_BAKED_AUDIO_H
+#define SUNNYLAND_BAKED_AUDIO_H
+
+#include <cstddef>      // 用于 std::byte
+#include <cstdint>      // 用于 std::uint32_t
+#include <span>         // 用于 std::span
+#include <string>       // 用于 std::string
+#include <SDL3/SDL_audio.h>
+
+namespace engine::resource {
+
+/**
+ * @brief 离线烘焙的音效（.slpcm）。
+ *
+ * 由 tools/audio_baker 从 wav/mp3/ogg 生成，与源文件放在同一目录、同名不同扩展名。
+ * 文件内容是已解码、已转换到混音器输出格式（采样格式、声道数、采样率）的 PCM，
+ * 运行时用 MIX_LoadRawAudio 载入：省去解码，格式与混音器一致时混音线程也不再重采样。
+ * 头部记录源文件的大小和修改时间，源文件更新后旧的烘焙文件不再使用。
+ */
+struct BakedAudioHeader {
+    static constexpr std::uint32_t MAGIC = 0x43504C53;     ///< @brief "SLPC"
+    static constexpr std::uint32_t VERSION = 1;
+
+    std::uint32_t magic = MAGIC;
+    std::uint32_t version = VERSION;
+    std::uint32_t format = 0;           ///< @brief SDL_AudioFormat
+    std::uint32_t channels = 0;
+    std::uint32_t freq = 0;
+    std::uint32_t reserved = 0;
+    std::uint64_t data_size = 0;        ///< @brief PCM 字节数
+    std::uint64_t source_size = 0;      ///< @brief 源文件的字节数
+    std::int64_t source_mtime = 0;      ///< @brief 源文件的修改时间
+};
+
+inline constexpr const char* BAKED_AUDIO_EXTENSION = ".slpcm";
+
+struct AudioBakeResult {
+    SDL_AudioSpec source_spec{};        ///< @brief 源文件的原始格式
+    std::size_t data_size = 0;          ///< @brief 烘焙后的 PCM 字节数
+    double seconds = 0.0;
+};
+
+/// @brief 源文件路径对应的烘焙文件路径（替换扩展名），已经是 .slpcm 时原样返回
+[[nodiscard]] std::string getBakedAudioPath(const std::string& source_path);
+
+/**
+ * @brief 解码 source_path 并转换为 target 格式，写入 baked_path。供离线工具使用。
+ * @param max_seconds 超过这个时长的文件（音乐）不烘焙，返回 false 且 result->seconds 大于 max_seconds。
+ * @return 解码或写入失败、或超过时长时返回 false。
+ */
+bool bakeAudio(const std::string& source_path, const std::string& baked_path, const SDL_AudioSpec& target,
+               double max_seconds, AudioBakeResult* result = nullptr);
+
+/**
+ * @brief 检查烘焙文件的头部是否有效，并且（source_path 非空时）与源文件的大小和修改时间一致。
+ */
+[[nodiscard]] bool isBakedAudioCurrent(std::span<const std::byte> file_data, const std::string& source_path);
+
+/**
+ * @brief 取出烘焙文件中的格式和 PCM 数据（指向 file_data 内部）。
+ * @return 文件无效时返回 false。
+ */
+bool readBakedAudio(std::span<const std::byte> file_data, SDL_AudioSpec& spec, std::span<const std::byte>& pcm);
+
+} // namespace engine::resource
+
+#endif //SUNNYLAND_BAKED_AUDIO_H
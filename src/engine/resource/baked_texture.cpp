@@ -0,0 +1,291 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#include "baked_texture.h"
+#include "../utils/binary_stream.h"
+#include "../utils/compression.h"
+#include <cstring>
+#include <filesystem>
+#include <unordered_map>
+#include <SDL3/SDL_render.h>
+#include <SDL3_image/SDL_image.h>
+#include <spdlog/spdlog.h>
+
+namespace engine::resource {
+
+namespace {
+
+constexpr std::size_t MAX_PALETTE_SIZE = 256;
+
+// 源文件的内容摘要；读取失败时 size 为 0，不会与任何有效的烘焙文件匹配
+struct SourceStamp {
+    std::uint64_t size = 0;
+    std::uint32_t crc32 = 0;
+};
+
+SourceStamp getSourceStamp(std::span<const std::byte> source_data) {
+    return {source_data.size(), engine::utils::crc32(source_data)};
+}
+
+// 校验头部并计算负载大小，负载与文件长度不符视为损坏
+bool readHeader(std::span<const std::byte> file_data, BakedTextureHeader& header) {
+    if (file_data.size() < sizeof(BakedTextureHeader)) {
+        return false;
+    }
+    std::memcpy(&header, file_data.data(), sizeof(BakedTextureHeader));
+    if (header.magic != BakedTextureHeader::MAGIC || header.version != BakedTextureHeader::VERSION ||
+        header.width == 0 || header.height == 0 || SDL_BYTESPERPIXEL(static_cast<SDL_PixelFormat>(header.pixel_format)) != 4) {
+        return false;
+    }
+    const std::size_t pixel_count = static_cast<std::size_t>(header.width) * header.height;
+    std::size_t payload = 0;
+    if (header.flags & BakedTextureHeader::FLAG_PALETTED) {
+        if (header.palette_size == 0 || header.palette_size > MAX_PALETTE_SIZE) {
+            return false;
+        }
+        payload = header.palette_size * sizeof(std::uint32_t) + pixel_count;
+    } else {
+        payload = pixel_count * sizeof(std::uint32_t);
+    }
+    return file_data.size() == sizeof(BakedTextureHeader) + payload;
+}
+
+// 把负载中的一行像素写入 dst（调色板时展开）。文件缓冲区不保证 4 字节对齐，一律按字节拷贝
+void copyPixelRow(const BakedTextureHeader& header, const std::byte* payload, const std::uint32_t* palette, std::size_t row,
+                  void* dst) {
+    const std::size_t width = header.width;
+    if (!(header.flags & BakedTextureHeader::FLAG_PALETTED)) {
+        std::memcpy(dst, payload + row * width * sizeof(std::uint32_t), width * sizeof(std::uint32_t));
+        return;
+    }
+    const auto* indices = reinterpret_cast<const std::uint8_t*>(payload + header.palette_size * sizeof(std::uint32_t)) + row * width;
+    auto* out = static_cast<std::byte*>(dst);
+    for (std::size_t x = 0; x < width; ++x) {
+        std::memcpy(out + x * sizeof(std::uint32_t), &palette[indices[x]], sizeof(std::uint32_t));  // 越界索引读到 0（透明）
+    }
+}
+
+void readPalette(const BakedTextureHeader& header, const std::byte* payload, std::uint32_t (&palette)[MAX_PALETTE_SIZE]) {
+    if (header.flags & BakedTextureHeader::FLAG_PALETTED) {
+        std::memcpy(palette, payload, header.palette_size * sizeof(std::uint32_t));
+    }
+}
+
+} // namespace
+
+std::string getBakedTexturePath(const std::string& source_path) {
+    std::filesystem::path path(source_path);
+    if (path.extension() == BAKED_TEXTURE_EXTENSION) {
+        return source_path;
+    }
+    return path.replace_extension(BAKED_TEXTURE_EXTENSION).generic_string();
+}
+
+bool bakeTexture(const std::string& source_path, const std::string& baked_path,
+                 const TextureBakeOptions& options, TextureBakeResult* result) {
+    if (SDL_BYTESPERPIXEL(options.format) != 4) {
+        spdlog::error("烘焙纹理只支持 32 位像素格式: {}", SDL_GetPixelFormatName(options.format));
+        return false;
+    }
+    std::vector<std::byte> source_data;
+    if (!engine::utils::readFileBytes(source_path, source_data)) {
+        spdlog::error("读取图片失败: '{}'", source_path);
+        return false;
+    }
+    SDL_IOStream* source_stream = SDL_IOFromConstMem(source_data.data(), source_data.size());
+    SDL_Surface* decoded = source_stream ? IMG_Load_IO(source_stream, true) : nullptr;
+    if (!decoded) {
+        spdlog::error("加载图片失败: '{}': {}", source_path, SDL_GetError());
+        return false;
+    }
+    SDL_Surface* surface = SDL_ConvertSurface(decoded, options.format);
+    SDL_DestroySurface(decoded);
+    if (!surface) {
+        spdlog::error("转换图片格式失败: '{}': {}", source_path, SDL_GetError());
+        return false;
+    }
+    if (!SDL_PremultiplySurfaceAlpha(surface, false)) {
+        spdlog::error("预乘 alpha 失败: '{}': {}", source_path, SDL_GetError());
+        SDL_DestroySurface(surface);
+        return false;
+    }
+
+    // 按行拷贝出紧凑的像素（表面的 pitch 可能带填充）
+    const auto width = static_cast<std::size_t>(surface->w);
+    const auto height = static_cast<std::size_t>(surface->h);
+    std::vector<std::uint32_t> pixels(width * height);
+    for (std::size_t y = 0; y < height; ++y) {
+        std::memcpy(pixels.data() + y * width, static_cast<const std::byte*>(surface->pixels) + y * surface->pitch,
+                    width * sizeof(std::uint32_t));
+    }
+    SDL_DestroySurface(surface);
+
+    // 像素画通常颜色很少，超过 256 种时放弃调色板
+    std::vector<std::uint32_t> palette;
+    std::vector<std::uint8_t> indices;
+    if (options.allow_palette) {
+        std::unordered_map<std::uint32_t, std::uint8_t> lookup;
+        indices.resize(pixels.size());
+        for (std::size_t i = 0; i < pixels.size(); ++i) {
+            auto [it, inserted] = lookup.try_emplace(pixels[i], static_cast<std::uint8_t>(palette.size()));
+            if (inserted) {
+                if (palette.size() == MAX_PALETTE_SIZE) {
+                    palette.clear();
+                    indices.clear();
+                    break;
+                }
+                palette.push_back(pixels[i]);
+            }
+            indices[i] = it->second;
+        }
+        // 很小的图片用调色板反而更大
+        if (palette.size() * sizeof(std::uint32_t) + indices.size() >= pixels.size() * sizeof(std::uint32_t)) {
+            palette.clear();
+            indices.clear();
+        }
+    }
+
+    const auto stamp = getSourceStamp(source_data);
+    BakedTextureHeader header;
+    header.width = static_cast<std::uint32_t>(width);
+    header.height = static_cast<std::uint32_t>(height);
+    header.pixel_format = static_cast<std::uint32_t>(options.format);
+    header.flags = BakedTextureHeader::FLAG_PREMULTIPLIED | (palette.empty() ? 0u : BakedTextureHeader::FLAG_PALETTED);
+    header.palette_size = static_cast<std::uint32_t>(palette.size());
+    header.source_size = stamp.size;
+    header.source_crc32 = stamp.crc32;
+
+    std::vector<std::byte> buffer;
+    engine::utils::BinaryWriter writer(buffer);
+    writer.write(header);
+    if (palette.empty()) {
+        writer.writeBytes(pixels.data(), pixels.size() * sizeof(std::uint32_t));
+    } else {
+        writer.writeBytes(palette.data(), palette.size() * sizeof(std::uint32_t));
+        writer.writeBytes(indices.data(), indices.size());
+    }
+    if (!engine::utils::writeFileBytes(baked_path, buffer)) {
+        spdlog::error("写入烘焙纹理失败: '{}'", baked_path);
+        return false;
+    }
+
+    if (result) {
+        result->width = static_cast<int>(width);
+        result->height = static_cast<int>(height);
+        result->palette_size = palette.size();
+        result->file_size = buffer.size();
+    }
+    return true;
+}
+
+bool isBakedTextureCurrent(std::span<const std::byte> file_data, const std::string& source_path) {
+    BakedTextureHeader header;
+    if (!readHeader(file_data, header)) {
+        return false;
+    }
+    if (source_path.empty()) {
+        return true;
+    }
+    // 大小不同时不必读取源文件
+    std::error_code ec;
+    if (std::filesystem::file_size(source_path, ec) != header.source_size || ec) {
+        return false;
+    }
+    std::vector<std::byte> source_data;
+    if (!engine::utils::readFileBytes(source_path, source_data)) {
+        return false;
+    }
+    const auto stamp = getSourceStamp(source_data);
+    return header.source_size == stamp.size && header.source_crc32 == stamp.crc32;
+}
+
+SDL_Texture* createBakedTexture(SDL_Renderer* renderer, std::span<const std::byte> file_data,
+                                std::vector<std::uint32_t>& scratch) {
+    BakedTextureHeader header;
+    if (!readHeader(file_data, header)) {
+        spdlog::error("烘焙纹理头部无效或文件已损坏。");
+        return nullptr;
+    }
+    const auto width = static_cast<int>(header.width);
+    const auto height = static_cast<int>(header.height);
+    const std::byte* payload = file_data.data() + sizeof(BakedTextureHeader);
+
+    // 文件缓冲区不保证 4 字节对齐，像素直接交给 SDL_UpdateTexture（按字节拷贝）；调色板先展开到 scratch
+    const void* pixels = payload;
+    if (header.flags & BakedTextureHeader::FLAG_PALETTED) {
+        std::uint32_t palette[MAX_PALETTE_SIZE] = {};
+        readPalette(header, payload, palette);
+        scratch.resize(static_cast<std::size_t>(header.width) * header.height);
+        for (std::size_t y = 0; y < header.height; ++y) {
+            copyPixelRow(header, payload, palette, y, scratch.data() + y * header.width);
+        }
+        pixels = scratch.data();
+    }
+
+    SDL_Texture* texture = SDL_CreateTexture(renderer, static_cast<SDL_PixelFormat>(header.pixel_format),
+                                             SDL_TEXTUREACCESS_STATIC, width, height);
+    if (!texture) {
+        spdlog::error("创建纹理失败: {}", SDL_GetError());
+        return nullptr;
+    }
+    if (!SDL_UpdateTexture(texture, nullptr, pixels, width * static_cast<int>(sizeof(std::uint32_t)))) {
+        spdlog::error("上传纹理像素失败: {}", SDL_GetError());
+        SDL_DestroyTexture(texture);
+        return nullptr;
+    }
+    SDL_SetTextureBlendMode(texture, (header.flags & BakedTextureHeader::FLAG_PREMULTIPLIED)
+                                         ? SDL_BLENDMODE_BLEND_PREMULTIPLIED : SDL_BLENDMODE_BLEND);
+    return texture;
+}
+
+SDL_Surface* createBakedSurface(std::span<const std::byte> file_data) {
+    BakedTextureHeader header;
+    if (!readHeader(file_data, header)) {
+        spdlog::error("烘焙纹理头部无效或文件已损坏。");
+        return nullptr;
+    }
+    SDL_Surface* surface = SDL_CreateSurface(static_cast<int>(header.width), static_cast<int>(header.height),
+                                             static_cast<SDL_PixelFormat>(header.pixel_format));
+    if (!surface) {
+        spdlog::error("创建表面失败: {}", SDL_GetError());
+        return nullptr;
+    }
+    const std::byte* payload = file_data.data() + sizeof(BakedTextureHeader);
+    std::uint32_t palette[MAX_PALETTE_SIZE] = {};
+    readPalette(header, payload, palette);
+    for (std::size_t y = 0; y < header.height; ++y) {
+        copyPixelRow(header, payload, palette, y, static_cast<std::byte*>(surface->pixels) + y * surface->pitch);
+    }
+    SDL_SetSurfaceBlendMode(surface, (header.flags & BakedTextureHeader::FLAG_PREMULTIPLIED)
+                                         ? SDL_BLENDMODE_BLEND_PREMULTIPLIED : SDL_BLENDMODE_BLEND);
+    return surface;
+}
+
+SDL_Surface* loadTextureSurface(const std::string& file_path) {
+    // 与 TextureManager::loadTexture 相同的选择规则，但缓冲区都是局部的，可在多个线程同时调用
+    const auto baked_path = getBakedTexturePath(file_path);
+    const bool requested_baked = baked_path == file_path;
+    std::error_code ec;
+    if (requested_baked || std::filesystem::exists(baked_path, ec)) {
+        std::vector<std::byte> file_data;
+        if (engine::utils::readFileBytes(baked_path, file_data) &&
+            isBakedTextureCurrent(file_data, requested_baked ? std::string() : file_path)) {
+            if (SDL_Surface* surface = createBakedSurface(file_data)) {
+                return surface;
+            }
+        } else {
+            spdlog::warn("烘焙纹理 '{}' 无效或已过期，改用原图。请重新运行 texture_baker。", baked_path);
+        }
+        if (requested_baked) {
+            return nullptr;
+        }
+    }
+    SDL_Surface* surface = IMG_Load(file_path.c_str());
+    if (!surface) {
+        spdlog::error("加载图片失败: '{}': {}", file_path, SDL_GetError());
+    }
+    return surface;
+}
+
+} // namespace engine::resource
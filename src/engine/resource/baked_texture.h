@@ -0,0 +1,107 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#ifndef SUNNYLAND_BAKED_TEXTURE_H
+#define SUNNYLAND_BAKED_TEXTURE_H
+
+#include <cstddef>      // 用于 std::byte
+#include <cstdint>      // 用于 std::uint32_t
+#include <span>         // 用于 std::span
+#include <string>       // 用于 std::string
+#include <vector>       // 用于 std::vector
+#include <SDL3/SDL_pixels.h>
+
+struct SDL_Renderer;
+struct SDL_Surface;
+struct SDL_Texture;
+
+namespace engine::resource {
+
+/**
+ * @brief 离线烘焙的纹理（.sltex）。
+ *
+ * 由 tools/texture_baker 从 PNG 生成，与 PNG 放在同一目录、同名不同扩展名。
+ * 文件内容是已解码、已预乘 alpha、按渲染器原生像素格式排列的像素，运行时只需 SDL_CreateTexture + SDL_UpdateTexture，
+ * 省去 PNG 解压缩、格式转换和 SDL_CreateTextureFromSurface 中的二次转换。
+ *
+ * 布局：BakedTextureHeader，随后
+ * - 普通：width * height 个 32 位像素；
+ * - 调色板（不超过 256 种颜色时）：palette_size 个 32 位颜色 + width * height 个 8 位索引，上传前展开。
+ * 头部记录源 PNG 的大小和 CRC-32，PNG 内容变化后旧的烘焙文件不再使用。不用修改时间：拷贝、检出后时间会变，
+ * 而回退到旧版本的 PNG 时间可能不变。
+ */
+struct BakedTextureHeader {
+    static constexpr std::uint32_t MAGIC = 0x58544C53;     ///< @brief "SLTX"
+    static constexpr std::uint32_t VERSION = 2;          ///< @brief 2: 以 CRC-32 代替修改时间
+    static constexpr std::uint32_t FLAG_PREMULTIPLIED = 1u << 0;
+    static constexpr std::uint32_t FLAG_PALETTED = 1u << 1;
+
+    std::uint32_t magic = MAGIC;
+    std::uint32_t version = VERSION;
+    std::uint32_t width = 0;
+    std::uint32_t height = 0;
+    std::uint32_t pixel_format = 0;     ///< @brief 像素（或调色板颜色）的 SDL_PixelFormat，总是 32 位
+    std::uint32_t flags = 0;
+    std::uint32_t palette_size = 0;     ///< @brief 调色板颜色数，未使用调色板时为 0
+    std::uint32_t reserved = 0;
+    std::uint64_t source_size = 0;      ///< @brief 源 PNG 的字节数
+    std::uint32_t source_crc32 = 0;     ///< @brief 源 PNG 内容的 CRC-32
+    std::uint32_t reserved2 = 0;
+};
+
+inline constexpr const char* BAKED_TEXTURE_EXTENSION = ".sltex";
+
+struct TextureBakeOptions {
+    SDL_PixelFormat format = SDL_PIXELFORMAT_ARGB8888;  ///< @brief 目标像素格式，应与目标渲染器的首选纹理格式一致
+    bool allow_palette = true;                          ///< @brief 颜色数不超过 256 时存为调色板 + 索引
+};
+
+struct TextureBakeResult {
+    int width = 0;
+    int height = 0;
+    std::size_t palette_size = 0;       ///< @brief 0 表示未使用调色板
+    std::size_t file_size = 0;
+};
+
+/// @brief PNG 路径对应的烘焙文件路径（替换扩展名），已经是 .sltex 时原样返回
+[[nodiscard]] std::string getBakedTexturePath(const std::string& source_path);
+
+/**
+ * @brief 解码 source_path，转换为目标格式并预乘 alpha，写入 baked_path。供离线工具使用。
+ * @return 读取、转换或写入失败时返回 false，错误已记录。
+ */
+bool bakeTexture(const std::string& source_path, const std::string& baked_path,
+                 const TextureBakeOptions& options, TextureBakeResult* result = nullptr);
+
+/**
+ * @brief 检查烘焙文件的头部是否有效，并且（source_path 非空时）与源文件的大小和 CRC-32 一致。
+ */
+[[nodiscard]] bool isBakedTextureCurrent(std::span<const std::byte> file_data, const std::string& source_path);
+
+/**
+ * @brief 用烘焙文件的内容创建静态纹理，混合模式设为 SDL_BLENDMODE_BLEND_PREMULTIPLIED。必须在渲染线程调用。
+ * @param scratch 调色板展开用的临时缓冲区，由调用方复用以避免每张纹理分配一次。
+ * @return 文件无效或创建失败时返回 nullptr，错误已记录。
+ */
+SDL_Texture* createBakedTexture(SDL_Renderer* renderer, std::span<const std::byte> file_data,
+                                std::vector<std::uint32_t>& scratch);
+
+/**
+ * @brief 把烘焙文件解码为表面（像素格式与文件一致）。不访问渲染器，可在任意线程调用。
+ *
+ * 像素已预乘时表面的混合模式为 SDL_BLENDMODE_BLEND_PREMULTIPLIED，
+ * TextureManager::loadTextureFromSurface 按表面的混合模式设置纹理，与 createBakedTexture 的结果一致。
+ * @return 文件无效或创建失败时返回 nullptr，错误已记录。
+ */
+SDL_Surface* createBakedSurface(std::span<const std::byte> file_data);
+
+/**
+ * @brief 供后台预解码使用：同目录下有未过期的 .sltex 时解码它，否则用 IMG_Load 解码原图。可在任意线程调用。
+ * @return 失败返回 nullptr，错误已记录。
+ */
+SDL_Surface* loadTextureSurface(const std::string& file_path);
+
+} // namespace engine::resource
+
+#endif //SUNNYLAND_BAKED_TEXTURE_H
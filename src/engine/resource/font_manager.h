@@ -70,6 +70,7 @@ private: // 仅由 ResourceManager（和内部）访问的方法
     TTF_Font* getFont(const std::string& file_path, int point_size);      ///< @brief 尝试获取已加载字体的指针，如果未加载则尝试加载
     void unloadFont(const std::string& file_path, int point_size);        ///< @brief 卸载特定字体（通过路径和大小标识）
     void clearFonts();                                                    ///< @brief 清空所有缓存的字体
+    [[nodiscard]] std::size_t getFontCount() const { return fonts_.size(); }  ///< @brief 当前缓存的字体数量
 
 };
 
@@ -6,29 +6,77 @@
 #include "texture_manager.h"
 #include "audio_manager.h"
 #include "font_manager.h"
+#include "../utils/startup_timeline.h"
 #include <SDL3_mixer/SDL_mixer.h>
 #include <SDL3_ttf/SDL_ttf.h>
 #include <glm/glm.hpp>
+#include <chrono>
 #include <spdlog/spdlog.h>
 
 namespace engine::resource {
 
-ResourceManager::~ResourceManager() = default;
+ResourceManager::~ResourceManager() {
+    // 后台初始化可能仍在进行，等它结束后再随 AudioManager 一起销毁，保证先于 SDL_Quit
+    if (pending_audio_.valid()) {
+        try {
+            pending_audio_.get();
+        } catch (const std::exception&) {
+        }
+    }
+}
 
 ResourceManager::ResourceManager(SDL_Renderer *renderer) {
     texture_manager_ = std::make_unique<TextureManager>(renderer);
-    font_manager_ = std::make_unique<FontManager>();
-    audio_manager_ = std::make_unique<AudioManager>();
+    // 音频设备在后台打开，与窗口、渲染器及首帧并行
+    pending_audio_ = std::async(std::launch::async, [] {
+        engine::utils::StartupSpan span("音频初始化 (MIX_CreateMixerDevice)");
+        return std::make_unique<AudioManager>();
+    });
 
-    spdlog::trace("ResourceManager 构造成功。");
-    // RAII: 构造成功即代表资源管理器可以正常工作，无需再初始化，无需检查指针是否为空
+    SPDLOG_TRACE("ResourceManager 构造成功。");
 }
 
 void ResourceManager::clear() {
+    texture_holds_.clear();
     texture_manager_->clearTextures();
-    font_manager_->clearFonts();
-    audio_manager_->clearAudio();
-    spdlog::trace("ResourceManager 中的资源通过 clear() 清空。");
+    if (font_manager_) {
+        font_manager_->clearFonts();
+    }
+    if (auto* audio_manager = audio()) {
+        audio_manager->clearAudio();
+    }
+    SPDLOG_TRACE("ResourceManager 中的资源通过 clear() 清空。");
+}
+
+bool ResourceManager::isAudioPending() const {
+    return pending_audio_.valid() && pending_audio_.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+}
+
+AudioManager* ResourceManager::audio() {
+    if (pending_audio_.valid()) {
+        if (isAudioPending()) {
+            spdlog::info("音频尚未初始化完成，等待后台线程 ...");
+        }
+        try {
+            audio_manager_ = pending_audio_.get();
+        } catch (const std::exception& e) {
+            spdlog::error("初始化音频失败，游戏将没有声音: {}", e.what());
+        }
+    }
+    return audio_manager_.get();
+}
+
+FontManager* ResourceManager::fonts() {
+    if (!font_manager_ && !font_failed_) {
+        try {
+            engine::utils::StartupSpan span("字体初始化 (TTF_Init)");
+            font_manager_ = std::make_unique<FontManager>();
+        } catch (const std::exception& e) {
+            spdlog::error("初始化字体失败，文字将无法显示: {}", e.what());
+            font_failed_ = true;
+        }
+    }
+    return font_manager_.get();
 }
 
 // --- 纹理接口实现 ---
@@ -41,66 +89,137 @@ SDL_Texture* ResourceManager::getTexture(const std::string& file_path) {
     return texture_manager_->getTexture(file_path);
 }
 
+SDL_Texture* ResourceManager::loadTextureFromSurface(const std::string& file_path, SDL_Surface* surface) {
+    return texture_manager_->loadTextureFromSurface(file_path, surface);
+}
+
 glm::vec2 ResourceManager::getTextureSize(const std::string& file_path) {
     return texture_manager_->getTextureSize(file_path);
 }
 
 void ResourceManager::unloadTexture(const std::string& file_path) {
+    if (texture_holds_.contains(file_path)) {
+        SPDLOG_DEBUG("纹理 '{}' 仍被持有，暂不卸载。", file_path);
+        return;
+    }
     texture_manager_->unloadTexture(file_path);
 }
 
+SDL_Texture* ResourceManager::acquireTexture(const std::string& file_path, SDL_Surface* surface) {
+    auto [it, inserted] = texture_holds_.try_emplace(file_path);
+    if (inserted) {
+        it->second.owned = !texture_manager_->isLoaded(file_path);
+    }
+    ++it->second.refs;
+    return surface ? texture_manager_->loadTextureFromSurface(file_path, surface) : texture_manager_->loadTexture(file_path);
+}
+
+void ResourceManager::releaseTexture(const std::string& file_path) {
+    auto it = texture_holds_.find(file_path);
+    if (it == texture_holds_.end()) {
+        SPDLOG_DEBUG("释放未被持有的纹理 '{}'（可能已被 clear() 清空），忽略。", file_path);
+        return;
+    }
+    if (--it->second.refs > 0) {
+        return;
+    }
+    const bool owned = it->second.owned;
+    texture_holds_.erase(it);
+    if (owned && texture_manager_->isLoaded(file_path)) {
+        texture_manager_->unloadTexture(file_path);
+    }
+}
+
 void ResourceManager::clearTextures() {
+    texture_holds_.clear();
     texture_manager_->clearTextures();
 }
 
 // --- 音频接口实现 ---
 MIX_Audio* ResourceManager::loadSound(const std::string& file_path) {
-    return audio_manager_->loadSound(file_path);
+    auto* audio_manager = audio();
+    return audio_manager ? audio_manager->loadSound(file_path) : nullptr;
 }
 
 MIX_Audio* ResourceManager::getSound(const std::string& file_path) {
-    return audio_manager_->getSound(file_path);
+    auto* audio_manager = audio();
+    return audio_manager ? audio_manager->getSound(file_path) : nullptr;
 }
 
 void ResourceManager::unloadSound(const std::string& file_path) {
-    audio_manager_->unloadSound(file_path);
+    if (auto* audio_manager = audio()) {
+        audio_manager->unloadSound(file_path);
+    }
 }
 
 void ResourceManager::clearSounds() {
-    audio_manager_->clearSounds();
+    if (auto* audio_manager = audio()) {
+        audio_manager->clearSounds();
+    }
 }
 
 MIX_Audio* ResourceManager::loadMusic(const std::string& file_path) {
-    return audio_manager_->loadMusic(file_path);
+    auto* audio_manager = audio();
+    return audio_manager ? audio_manager->loadMusic(file_path) : nullptr;
 }
 
 MIX_Audio* ResourceManager::getMusic(const std::string& file_path) {
-    return audio_manager_->getMusic(file_path);
+    auto* audio_manager = audio();
+    return audio_manager ? audio_manager->getMusic(file_path) : nullptr;
 }
 
 void ResourceManager::unloadMusic(const std::string& file_path) {
-    audio_manager_->unloadMusic(file_path);
+    if (auto* audio_manager = audio()) {
+        audio_manager->unloadMusic(file_path);
+    }
 }
 
 void ResourceManager::clearMusic() {
-    audio_manager_->clearMusic();
+    if (auto* audio_manager = audio()) {
+        audio_manager->clearMusic();
+    }
 }
 
 // --- 字体接口实现 ---
 TTF_Font* ResourceManager::loadFont(const std::string& file_path, int point_size) {
-    return font_manager_->loadFont(file_path, point_size);
+    auto* font_manager = fonts();
+    return font_manager ? font_manager->loadFont(file_path, point_size) : nullptr;
 }
 
 TTF_Font* ResourceManager::getFont(const std::string& file_path, int point_size) {
-    return font_manager_->getFont(file_path, point_size);
+    auto* font_manager = fonts();
+    return font_manager ? font_manager->getFont(file_path, point_size) : nullptr;
 }
 
 void ResourceManager::unloadFont(const std::string& file_path, int point_size) {
-    font_manager_->unloadFont(file_path, point_size);
+    // 尚未创建说明没有加载过任何字体，不需要为卸载而初始化 TTF
+    if (font_manager_) {
+        font_manager_->unloadFont(file_path, point_size);
+    }
 }
 
 void ResourceManager::clearFonts() {
-    font_manager_->clearFonts();
+    if (font_manager_) {
+        font_manager_->clearFonts();
+    }
+}
+
+// --- 缓存驻留统计 ---
+// 这些接口每帧由性能面板调用，不等待、不触发延迟初始化
+std::size_t ResourceManager::getTextureCount() const {
+    return texture_manager_->getTextureCount();
+}
+
+std::size_t ResourceManager::getFontCount() const {
+    return font_manager_ ? font_manager_->getFontCount() : 0;
+}
+
+std::size_t ResourceManager::getSoundCount() const {
+    return audio_manager_ ? audio_manager_->getSoundCount() : 0;
+}
+
+std::size_t ResourceManager::getMusicCount() const {
+    return audio_manager_ ? audio_manager_->getMusicCount() : 0;
 }
 
 }// namespace engine::resource
\ No newline at end of file
@@ -5,13 +5,16 @@
 #ifndef SUNNYLAND_RESOURCE_MANAGER_H
 #define SUNNYLAND_RESOURCE_MANAGER_H
 
+#include <future> // 用于 std::future
 #include <memory> // 用于 std::unique_ptr
 #include <string> // 用于 std::string
+#include <unordered_map> // 用于 std::unordered_map
 #include <glm/glm.hpp>
 
 // 前向声明 SDL 类型
 struct SDL_Renderer;
 struct SDL_Texture;
+struct SDL_Surface;
 struct MIX_Audio;
 struct Mix_Music;
 struct TTF_Font;
@@ -25,13 +28,29 @@ class AudioManager;
 
 /**
  * @brief 作为访问各种资源管理器的中央控制点（外观模式 Facade）。
- * 在构造时初始化其管理的子系统。构造失败会抛出异常。
+ *
+ * 构造时只同步创建纹理管理器（失败会抛出异常），其余子系统不阻塞启动：
+ * - 音频：打开音频设备很慢，构造时在后台线程创建 AudioManager（音频子系统和 SDL_mixer 须已在主线程初始化），
+ *   首次使用音频接口时才等待它完成；
+ *   创建失败时记录错误，之后音频接口返回 nullptr / 什么也不做，游戏照常运行（没有声音）。
+ * - 字体：只有界面文字需要，首次使用字体接口时才创建 FontManager（TTF_Init）。
+ * 纹理可以由多个持有者（场景栈、关卡流式加载器等）通过 acquireTexture()/releaseTexture() 共享：
+ * 最后一个持有者释放时才卸载，持有期间 unloadTexture() 不会卸载它。
+ * 所有接口仍只能在主线程调用。
  */
 class ResourceManager final {
 private:
     std::unique_ptr<TextureManager> texture_manager_;
-    std::unique_ptr<FontManager> font_manager_;
-    std::unique_ptr<AudioManager> audio_manager_;
+    std::unique_ptr<FontManager> font_manager_;         ///< @brief 首次使用字体时创建
+    std::unique_ptr<AudioManager> audio_manager_;       ///< @brief 后台创建完成并被取走后非空
+    std::future<std::unique_ptr<AudioManager>> pending_audio_;  ///< @brief 后台线程上的 AudioManager 创建，取走结果后失效
+    bool font_failed_ = false;
+
+    struct TextureHold {
+        int refs = 0;
+        bool owned = false;     ///< @brief 纹理由首次 acquireTexture() 载入；之前已被直接载入的纹理释放后保留
+    };
+    std::unordered_map<std::string, TextureHold> texture_holds_;   ///< @brief acquireTexture() 的引用计数
 
 public:
     /**
@@ -54,7 +73,14 @@ public:
     // -- Texture --
     SDL_Texture* loadTexture(const std::string& file_path);     ///< @brief 载入纹理资源
     SDL_Texture* getTexture(const std::string& file_path);      ///< @brief 尝试获取已加载纹理的指针，如果未加载则尝试加载
-    void unloadTexture(const std::string& file_path);          ///< @brief 卸载指定的纹理资源
+    SDL_Texture* loadTextureFromSurface(const std::string& file_path, SDL_Surface* surface);  ///< @brief 上传后台解码好的表面并缓存（接管 surface），需在渲染线程调用
+    void unloadTexture(const std::string& file_path);          ///< @brief 卸载指定的纹理资源；仍被 acquireTexture() 持有时不卸载
+    /**
+     * @brief 持有纹理（引用计数加一），未加载时载入。surface 非空时用它上传（接管 surface），否则同步加载文件。
+     * 长期保存返回的 SDL_Texture* 的使用者应通过本接口持有，避免纹理被其他使用者卸载。
+     */
+    SDL_Texture* acquireTexture(const std::string& file_path, SDL_Surface* surface = nullptr);
+    void releaseTexture(const std::string& file_path);         ///< @brief 释放 acquireTexture() 的持有，最后一个持有者释放时卸载
     glm::vec2 getTextureSize(const std::string& file_path);    ///< @brief 获取指定纹理的尺寸
     void clearTextures();
 
@@ -75,6 +101,18 @@ public:
     TTF_Font* getFont(const std::string& file_path, int point_size);      ///< @brief 尝试获取已加载字体的指针，如果未加载则尝试加载
     void unloadFont(const std::string& file_path, int point_size);        ///< @brief 卸载指定的字体资源
     void clearFonts();
+
+    // -- 缓存驻留统计（性能面板、内存检查使用） --
+    [[nodiscard]] std::size_t getTextureCount() const;
+    [[nodiscard]] std::size_t getFontCount() const;
+    [[nodiscard]] std::size_t getSoundCount() const;
+    [[nodiscard]] std::size_t getMusicCount() const;
+
+    [[nodiscard]] bool isAudioPending() const;      ///< @brief 音频仍在后台初始化（不会阻塞）
+
+private:
+    AudioManager* audio();      ///< @brief 等待后台初始化完成，不可用时返回 nullptr
+    FontManager* fonts();       ///< @brief 按需创建，不可用时返回 nullptr
 };
 
 } // namespace engine::resource
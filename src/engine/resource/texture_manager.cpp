@@ -3,34 +3,120 @@
 //
 
 #include "texture_manager.h"
+#include "baked_texture.h"
+#include "../utils/binary_stream.h"
+#include "../utils/log.h"
+#include "../utils/metrics.h"
 
 #include <SDL3_image/SDL_image.h> // 用于 IMG_LoadTexture, IMG_Init, IMG_Quit
 #include <spdlog/spdlog.h>
+#include <filesystem>
 #include <stdexcept>
 
 namespace engine::resource {
+
+namespace {
+
+// 显存占用按每像素 4 字节估算（缓存的纹理都是 RGBA8 或调色板展开后的 RGBA8）
+std::uint64_t estimateTextureBytes(const SDL_Texture* texture) {
+    return static_cast<std::uint64_t>(texture->w) * static_cast<std::uint64_t>(texture->h) * 4;
+}
+
+void trackTextureCreated(const SDL_Texture* texture) {
+    engine::utils::Metrics::add(engine::utils::Metric::TexturesCreated);
+    engine::utils::Metrics::add(engine::utils::Metric::TextureBytesCreated, estimateTextureBytes(texture));
+}
+
+} // namespace
+
+void TextureManager::SDLTextureDeleter::operator()(SDL_Texture* texture) const {
+    if (texture) {
+        engine::utils::Metrics::add(engine::utils::Metric::TexturesDestroyed);
+        engine::utils::Metrics::add(engine::utils::Metric::TextureBytesDestroyed, estimateTextureBytes(texture));
+        SDL_DestroyTexture(texture);
+    }
+}
+
 TextureManager::TextureManager(SDL_Renderer *renderer) : renderer_(renderer) {
     if (!renderer_) {
         throw std::runtime_error("TextureManager 构造失败: 渲染器指针为空。");
     }
     // SDL3中不再需要手动调用IMG_Init/IMG_Quit
-    spdlog::trace("TextureManager 构造成功。");
+    SPDLOG_TRACE("TextureManager 构造成功。");
 }
 
 SDL_Texture* TextureManager::loadTexture(const std::string& file_path) {
     // 检查是否已加载
     auto it = textures_.find(file_path);
     if (it != textures_.end()) {
+        engine::utils::Metrics::add(engine::utils::Metric::TextureCacheHits);
         return it->second.get();
     }
     // 如果没加载则尝试加载纹理
-    SDL_Texture* raw_texture = IMG_LoadTexture(renderer_, file_path.c_str());
+    engine::utils::Metrics::add(engine::utils::Metric::TextureCacheMisses);
+    // 优先使用离线烘焙的 .sltex，没有或已过期时再解码 PNG
+    SDL_Texture* raw_texture = loadBakedTexture(file_path);
+    if (!raw_texture) {
+        raw_texture = IMG_LoadTexture(renderer_, file_path.c_str());
+    }
+    if (!raw_texture) {
+        SUNNYLAND_LOG_EVERY(spdlog::level::err, 1000, "加载纹理失败: '{}': {}", file_path, SDL_GetError());
+        return nullptr;
+    }
+    trackTextureCreated(raw_texture);
+    textures_.emplace(file_path, std::unique_ptr<SDL_Texture, SDLTextureDeleter>(raw_texture));
+    SPDLOG_DEBUG("成功加载并缓存纹理: {}", file_path.c_str());
+    return raw_texture;
+}
+
+SDL_Texture* TextureManager::loadBakedTexture(const std::string& file_path) {
+    const auto baked_path = getBakedTexturePath(file_path);
+    const bool requested_baked = baked_path == file_path;   // 直接请求 .sltex 时不检查源文件
+    std::error_code ec;
+    if (!requested_baked && !std::filesystem::exists(baked_path, ec)) {
+        return nullptr;
+    }
+    if (!engine::utils::readFileBytes(baked_path, baked_file_buffer_)) {
+        spdlog::error("读取烘焙纹理失败: '{}'", baked_path);
+        return nullptr;
+    }
+    if (!isBakedTextureCurrent(baked_file_buffer_, requested_baked ? std::string() : file_path)) {
+        spdlog::warn("烘焙纹理 '{}' 无效或已过期，改用原图。请重新运行 texture_baker。", baked_path);
+        return nullptr;
+    }
+    SDL_Texture* raw_texture = createBakedTexture(renderer_, baked_file_buffer_, baked_scratch_);
+    if (raw_texture) {
+        SPDLOG_TRACE("使用烘焙纹理: {}", baked_path);
+    }
+    return raw_texture;
+}
+
+SDL_Texture* TextureManager::loadTextureFromSurface(const std::string& file_path, SDL_Surface* surface) {
+    if (!surface) {
+        spdlog::error("无法从空表面创建纹理: '{}'", file_path);
+        return nullptr;
+    }
+    // 已经缓存过则直接丢弃新解码的表面
+    auto it = textures_.find(file_path);
+    if (it != textures_.end()) {
+        SDL_DestroySurface(surface);
+        return it->second.get();
+    }
+    // 表面通常在后台线程解码，这里只做上传，必须在渲染线程调用
+    SDL_Texture* raw_texture = SDL_CreateTextureFromSurface(renderer_, surface);
+    // 烘焙纹理解码出的表面以混合模式标记预乘像素（见 createBakedSurface），纹理必须与之一致
+    SDL_BlendMode blend_mode = SDL_BLENDMODE_BLEND;
+    if (raw_texture && SDL_GetSurfaceBlendMode(surface, &blend_mode)) {
+        SDL_SetTextureBlendMode(raw_texture, blend_mode);
+    }
+    SDL_DestroySurface(surface);
     if (!raw_texture) {
-        spdlog::error("加载纹理失败: '{}': {}", file_path, SDL_GetError());
+        spdlog::error("从表面创建纹理失败: '{}': {}", file_path, SDL_GetError());
         return nullptr;
     }
+    trackTextureCreated(raw_texture);
     textures_.emplace(file_path, std::unique_ptr<SDL_Texture, SDLTextureDeleter>(raw_texture));
-    spdlog::debug("成功加载并缓存纹理: {}", file_path.c_str());
+    SPDLOG_DEBUG("成功从预解码表面创建并缓存纹理: {}", file_path);
     return raw_texture;
 }
 
@@ -38,10 +124,11 @@ SDL_Texture* TextureManager::getTexture(const std::string& file_path) {
     // 查找现有纹理
     auto it = textures_.find(file_path);
     if (it != textures_.end()) {
+        engine::utils::Metrics::add(engine::utils::Metric::TextureCacheHits);
         return it->second.get();
     }
     // 如果未找到，尝试加载它
-    spdlog::warn("纹理 '{}' 未找到缓存，尝试加载。", file_path);
+    SUNNYLAND_LOG_EVERY(spdlog::level::warn, 1000, "纹理 '{}' 未找到缓存，尝试加载。", file_path);
     return loadTexture(file_path);
 }
 
@@ -49,7 +136,7 @@ glm::vec2 TextureManager::getTextureSize(const std::string& file_path) {
     // 获取纹理
     SDL_Texture* texture = getTexture(file_path);
     if (!texture) {
-        spdlog::error("无法获取纹理: {}", file_path);
+        SUNNYLAND_LOG_EVERY(spdlog::level::err, 1000, "无法获取纹理: {}", file_path);
         return glm::vec2(0);
     }
     // 获取纹理尺寸
@@ -64,7 +151,7 @@ glm::vec2 TextureManager::getTextureSize(const std::string& file_path) {
 void TextureManager::unloadTexture(const std::string& file_path) {
     auto it = textures_.find(file_path);
     if (it != textures_.end()) {
-        spdlog::debug("卸载纹理: {}", file_path);
+        SPDLOG_DEBUG("卸载纹理: {}", file_path);
         textures_.erase(it); // unique_ptr 通过自定义删除器处理删除
     } else {
         spdlog::warn("尝试卸载不存在的纹理: {}", file_path);
@@ -73,7 +160,7 @@ void TextureManager::unloadTexture(const std::string& file_path) {
 
 void TextureManager::clearTextures() {
     if (!textures_.empty()) {
-        spdlog::debug("正在清除所有 {} 个缓存的纹理。", textures_.size());
+        SPDLOG_DEBUG("正在清除所有 {} 个缓存的纹理。", textures_.size());
         textures_.clear(); // unique_ptr 处理所有元素的删除
     }
 }
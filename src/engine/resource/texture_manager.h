@@ -9,6 +9,7 @@
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include <SDL3/SDL_render.h>
 #include <glm/glm.hpp>
 
@@ -19,20 +20,20 @@ namespace engine::resource {
  *
  * 在构造时初始化。使用文件路径作为键，确保纹理只加载一次并正确释放。
  * 依赖于一个有效的 SDL_Renderer，构造失败会抛出异常。
+ * 加载 PNG 时若同目录下有未过期的同名 .sltex（见 baked_texture.h），直接上传其中的预乘像素，
+ * 此时纹理的混合模式为 SDL_BLENDMODE_BLEND_PREMULTIPLIED。
  */
 class TextureManager final {
 friend class ResourceManager;
 private:
     struct SDLTextureDeleter  {
-        void operator()(SDL_Texture* texture) const {
-            if (texture) {
-                SDL_DestroyTexture(texture);
-            }
-        }
+        void operator()(SDL_Texture* texture) const;    ///< @brief 销毁纹理并计入 Metric::TexturesDestroyed
     };
 
     std::unordered_map<std::string, std::unique_ptr<SDL_Texture, SDLTextureDeleter>> textures_;
     SDL_Renderer* renderer_ = nullptr; // 指向主渲染器的非拥有指针
+    std::vector<std::byte> baked_file_buffer_;      ///< @brief 读取 .sltex 的复用缓冲区
+    std::vector<std::uint32_t> baked_scratch_;      ///< @brief 调色板展开的复用缓冲区
 
 public:
     /**
@@ -50,11 +51,15 @@ public:
 
 private:
     SDL_Texture* loadTexture(const std::string& file_path); ///< @brief 从文件路径加载纹理
+    SDL_Texture* loadBakedTexture(const std::string& file_path); ///< @brief 尝试从对应的 .sltex 创建纹理，不存在或无效时返回 nullptr
     SDL_Texture* getTexture(const std::string& file_path); ///< @brief 尝试获取已加载纹理的指针，如果未加载则尝试加载
+    SDL_Texture* loadTextureFromSurface(const std::string& file_path, SDL_Surface* surface); ///< @brief 用已解码的表面创建纹理并以 file_path 缓存，接管 surface 的所有权
 
     glm::vec2 getTextureSize(const std::string& file_path);
     void unloadTexture(const std::string& file_path);
     void clearTextures();
+    [[nodiscard]] std::size_t getTextureCount() const { return textures_.size(); }
+    [[nodiscard]] bool isLoaded(const std::string& file_path) const { return textures_.contains(file_path); }
 };
 
 
@@ -0,0 +1,343 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#include "save_system.h"
+#include "../utils/binary_stream.h"
+#include "../utils/compression.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+#ifdef _WIN32
+#include <io.h>         // 用于 _commit, _fileno
+#else
+#include <fcntl.h>      // 用于 open
+#include <unistd.h>     // 用于 fsync
+#endif
+
+namespace engine::save {
+
+namespace {
+
+constexpr std::uint32_t FILE_MAGIC = 0x56534C53;    // "SLSV"
+constexpr std::uint32_t FILE_VERSION = 1;           // 容器格式版本
+constexpr std::uint32_t SNAPSHOT_VERSION = 1;       // 快照内容版本，新增字段时递增并在 deserialize 中兼容旧版本
+constexpr std::uint32_t FLAG_COMPRESSED = 1u << 0;
+
+struct FileHeader {
+    std::uint32_t magic = FILE_MAGIC;
+    std::uint32_t version = FILE_VERSION;
+    std::uint32_t flags = 0;
+    std::uint32_t raw_size = 0;         ///< @brief 快照原始大小
+    std::uint32_t stored_size = 0;      ///< @brief 文件头之后实际存储的字节数
+    std::uint32_t checksum = 0;         ///< @brief 存储内容的 CRC-32
+};
+
+std::uint64_t nowNs() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/**
+ * @brief 把目录项的变更（rename 的结果）刷到磁盘。POSIX 上只 fsync 文件本身并不保证它所在目录的更新已落盘。
+ * Windows 上 NTFS 的元数据由日志保证，直接返回成功。
+ */
+bool syncParentDirectory(const std::string& path) {
+#ifdef _WIN32
+    (void)path;
+    return true;
+#else
+    auto directory = std::filesystem::path(path).parent_path();
+    if (directory.empty()) {
+        directory = ".";
+    }
+    const int fd = open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+    if (fd < 0) {
+        return false;
+    }
+    const bool ok = fsync(fd) == 0;
+    return (close(fd) == 0) && ok;
+#endif
+}
+
+} // namespace
+
+SaveSystem::SaveSystem(std::string save_path, std::string json_path)
+    : save_path_(std::move(save_path)), json_path_(std::move(json_path)) {
+    worker_ = std::thread(&SaveSystem::workerLoop, this);
+    SPDLOG_TRACE("SaveSystem 构造成功，存档路径: {}", save_path_);
+}
+
+SaveSystem::~SaveSystem() {
+    flush();
+    {
+        std::lock_guard lock(mutex_);
+        stop_ = true;
+    }
+    condition_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+    SPDLOG_TRACE("SaveSystem 析构成功。");
+}
+
+void SaveSystem::snapshot(const SaveData& data) {
+    const auto start = nowNs();
+    snapshot_buffer_.clear();       // 保留容量，稳定状态下不分配内存
+    serialize(data, snapshot_buffer_);
+    {
+        std::lock_guard lock(mutex_);
+        // 与待写缓冲区交换：若后台尚未处理上一份快照，它会被这份更新的快照覆盖
+        snapshot_buffer_.swap(pending_buffer_);
+        has_pending_ = true;
+    }
+    condition_.notify_one();
+    last_snapshot_ns_.store(nowNs() - start, std::memory_order_relaxed);
+}
+
+void SaveSystem::flush() {
+    std::unique_lock lock(mutex_);
+    idle_condition_.wait(lock, [this] { return !has_pending_ && !writing_; });
+}
+
+bool SaveSystem::load(SaveData& data) const {
+    if (loadBinary(data)) {
+        SPDLOG_DEBUG("已从二进制存档加载: {}", save_path_);
+        return true;
+    }
+    if (importJson(data)) {
+        spdlog::info("二进制存档不可用，已从 JSON 存档导入: {}", json_path_);
+        return true;
+    }
+    return false;
+}
+
+bool SaveSystem::exportJson(const SaveData& data) const {
+    nlohmann::json json;
+    json["high_score"] = data.high_score;
+    json["level_health"] = data.level_health;
+    json["level_score"] = data.level_score;
+    json["map_path"] = data.map_path;
+    json["max_health"] = data.max_health;
+    if (!data.entities.empty()) {
+        auto& entities = json["entities"];
+        for (const auto& entity : data.entities) {
+            entities.push_back({{"id", entity.id}, {"type_id", entity.type_id},
+                                {"x", entity.position.x}, {"y", entity.position.y},
+                                {"vx", entity.velocity.x}, {"vy", entity.velocity.y},
+                                {"health", entity.health}, {"flags", entity.flags}});
+        }
+    }
+    const std::string text = json.dump(4);
+    if (!writeFileAtomically(json_path_, text.data(), text.size())) {
+        spdlog::error("导出 JSON 存档失败: {}", json_path_);
+        return false;
+    }
+    return true;
+}
+
+bool SaveSystem::importJson(SaveData& data) const {
+    std::ifstream file(json_path_);
+    if (!file.is_open()) {
+        return false;
+    }
+    try {
+        nlohmann::json json;
+        file >> json;
+        SaveData result;
+        result.high_score = json.value("high_score", 0);
+        result.level_health = json.value("level_health", 3);
+        result.level_score = json.value("level_score", 0);
+        result.map_path = json.value("map_path", "");
+        result.max_health = json.value("max_health", 3);
+        for (const auto& entity_json : json.value("entities", nlohmann::json::array())) {
+            EntityRecord entity;
+            entity.id = entity_json.value("id", 0u);
+            entity.type_id = entity_json.value("type_id", 0u);
+            entity.position = {entity_json.value("x", 0.0f), entity_json.value("y", 0.0f)};
+            entity.velocity = {entity_json.value("vx", 0.0f), entity_json.value("vy", 0.0f)};
+            entity.health = entity_json.value("health", 0);
+            entity.flags = entity_json.value("flags", 0u);
+            result.entities.push_back(entity);
+        }
+        data = std::move(result);
+    } catch (const nlohmann::json::exception& e) {
+        spdlog::error("解析 JSON 存档 '{}' 失败: {}", json_path_, e.what());
+        return false;
+    }
+    return true;
+}
+
+// --- 后台线程 ---
+
+void SaveSystem::workerLoop() {
+    std::vector<std::byte> job;
+    while (true) {
+        {
+            std::unique_lock lock(mutex_);
+            condition_.wait(lock, [this] { return stop_ || has_pending_; });
+            if (!has_pending_) {
+                return;     // stop_ 且没有待写入的快照
+            }
+            job.swap(pending_buffer_);
+            has_pending_ = false;
+            writing_ = true;
+        }
+
+        const auto start = nowNs();
+        if (writeSnapshot(job)) {
+            completed_writes_.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            failed_writes_.fetch_add(1, std::memory_order_relaxed);
+        }
+        last_write_ns_.store(nowNs() - start, std::memory_order_relaxed);
+
+        {
+            std::lock_guard lock(mutex_);
+            writing_ = false;
+        }
+        idle_condition_.notify_all();
+    }
+}
+
+bool SaveSystem::writeSnapshot(const std::vector<std::byte>& snapshot) {
+    std::vector<std::byte> file_bytes(sizeof(FileHeader));
+    engine::utils::compressLz(snapshot, file_bytes);
+
+    FileHeader header;
+    header.raw_size = static_cast<std::uint32_t>(snapshot.size());
+    if (file_bytes.size() - sizeof(FileHeader) < snapshot.size()) {
+        header.flags |= FLAG_COMPRESSED;
+    } else {
+        // 压缩无收益（数据本身没有重复）时直接存原始数据
+        file_bytes.resize(sizeof(FileHeader));
+        file_bytes.insert(file_bytes.end(), snapshot.begin(), snapshot.end());
+    }
+    const std::span<const std::byte> payload(file_bytes.data() + sizeof(FileHeader), file_bytes.size() - sizeof(FileHeader));
+    header.stored_size = static_cast<std::uint32_t>(payload.size());
+    header.checksum = engine::utils::crc32(payload);
+    std::memcpy(file_bytes.data(), &header, sizeof(header));
+
+    if (!writeFileAtomically(save_path_, file_bytes.data(), file_bytes.size())) {
+        spdlog::error("写入存档失败: {}", save_path_);
+        return false;
+    }
+    SPDLOG_DEBUG("存档已写入 {}（原始 {} 字节，存储 {} 字节）", save_path_, header.raw_size, header.stored_size);
+    return true;
+}
+
+bool SaveSystem::loadBinary(SaveData& data) const {
+    std::vector<std::byte> file_bytes;
+    if (!engine::utils::readFileBytes(save_path_, file_bytes) || file_bytes.size() < sizeof(FileHeader)) {
+        return false;
+    }
+    FileHeader header;
+    std::memcpy(&header, file_bytes.data(), sizeof(header));
+    const std::span<const std::byte> payload(file_bytes.data() + sizeof(FileHeader), file_bytes.size() - sizeof(FileHeader));
+    if (header.magic != FILE_MAGIC || header.version != FILE_VERSION || header.stored_size != payload.size()) {
+        spdlog::warn("存档 '{}' 格式不匹配，已忽略。", save_path_);
+        return false;
+    }
+    if (engine::utils::crc32(payload) != header.checksum) {
+        spdlog::warn("存档 '{}' 校验失败（文件可能已损坏），已忽略。", save_path_);
+        return false;
+    }
+
+    std::vector<std::byte> snapshot;
+    if (header.flags & FLAG_COMPRESSED) {
+        if (!engine::utils::decompressLz(payload, header.raw_size, snapshot)) {
+            spdlog::warn("存档 '{}' 解压失败，已忽略。", save_path_);
+            return false;
+        }
+    } else {
+        snapshot.assign(payload.begin(), payload.end());
+    }
+    return deserialize(snapshot, data);
+}
+
+void SaveSystem::serialize(const SaveData& data, std::vector<std::byte>& out) {
+    engine::utils::BinaryWriter writer(out);
+    writer.write(SNAPSHOT_VERSION);
+    writer.write(static_cast<std::int32_t>(data.high_score));
+    writer.write(static_cast<std::int32_t>(data.level_health));
+    writer.write(static_cast<std::int32_t>(data.level_score));
+    writer.write(static_cast<std::int32_t>(data.max_health));
+    writer.writeString(data.map_path);
+    writer.write(static_cast<std::uint32_t>(data.entities.size()));
+    writer.writeBytes(data.entities.data(), data.entities.size() * sizeof(EntityRecord));
+}
+
+bool SaveSystem::deserialize(const std::vector<std::byte>& in, SaveData& data) {
+    engine::utils::BinaryReader reader(in);
+    std::uint32_t version = 0;
+    std::int32_t high_score = 0, level_health = 0, level_score = 0, max_health = 0;
+    SaveData result;
+    if (!reader.read(version)) {
+        return false;
+    }
+    if (version > SNAPSHOT_VERSION) {
+        spdlog::warn("存档快照版本 {} 高于当前支持的版本 {}。", version, SNAPSHOT_VERSION);
+        return false;
+    }
+    reader.read(high_score);
+    reader.read(level_health);
+    reader.read(level_score);
+    reader.read(max_health);
+    reader.readString(result.map_path);
+    std::uint32_t entity_count = 0;
+    if (!reader.read(entity_count) || entity_count > reader.remaining() / sizeof(EntityRecord)) {
+        return false;
+    }
+    result.entities.resize(entity_count);
+    reader.readBytes(result.entities.data(), entity_count * sizeof(EntityRecord));
+    if (!reader.good()) {
+        return false;
+    }
+    result.high_score = high_score;
+    result.level_health = level_health;
+    result.level_score = level_score;
+    result.max_health = max_health;
+    data = std::move(result);
+    return true;
+}
+
+bool SaveSystem::writeFileAtomically(const std::string& path, const void* data, std::size_t size) {
+    const std::string temp_path = path + ".tmp";
+    std::FILE* file = std::fopen(temp_path.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+    bool ok = std::fwrite(data, 1, size, file) == size && std::fflush(file) == 0;
+    // 确保数据真正落盘后再重命名，否则断电时可能得到一个被重命名过来的空文件
+#ifdef _WIN32
+    ok = ok && _commit(_fileno(file)) == 0;
+#else
+    ok = ok && fsync(fileno(file)) == 0;
+#endif
+    ok = (std::fclose(file) == 0) && ok;
+    if (!ok) {
+        std::remove(temp_path.c_str());
+        return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temp_path, path, ec);   // 同一目录内的重命名是原子的，会替换已有文件
+    if (ec) {
+        spdlog::error("重命名 '{}' -> '{}' 失败: {}", temp_path, path, ec.message());
+        std::remove(temp_path.c_str());
+        return false;
+    }
+    // 重命名本身也要落盘，否则保存后立即崩溃仍可能读到旧文件
+    if (!syncParentDirectory(path)) {
+        spdlog::error("同步 '{}' 所在目录失败。", path);
+        return false;
+    }
+    return true;
+}
+
+} // namespace engine::save
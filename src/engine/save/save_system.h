@@ -0,0 +1,126 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#ifndef SUNNYLAND_SAVE_SYSTEM_H
+#define SUNNYLAND_SAVE_SYSTEM_H
+
+#include <atomic>               // 用于 std::atomic
+#include <condition_variable>   // 用于 std::condition_variable
+#include <cstddef>              // 用于 std::byte
+#include <cstdint>              // 用于 std::uint32_t
+#include <mutex>                // 用于 std::mutex
+#include <string>               // 用于 std::string
+#include <thread>               // 用于 std::thread
+#include <vector>               // 用于 std::vector
+#include <glm/glm.hpp>
+
+namespace engine::save {
+
+/**
+ * @brief 单个实体的存档记录。平凡可拷贝，快照时整块复制。
+ */
+struct EntityRecord {
+    std::uint32_t id = 0;           ///< @brief 地图对象 ID 或运行时分配的 ID
+    std::uint32_t type_id = 0;      ///< @brief 由游戏层定义的实体类型
+    glm::vec2 position{0.0f};
+    glm::vec2 velocity{0.0f};
+    std::int32_t health = 0;
+    std::uint32_t flags = 0;        ///< @brief 由游戏层定义的状态位（如已拾取、已击败）
+};
+
+/**
+ * @brief 存档内容。前五个字段与 assets/save.json 一一对应。
+ */
+struct SaveData {
+    int high_score = 0;
+    int level_health = 3;
+    int level_score = 0;
+    std::string map_path;
+    int max_health = 3;
+    std::vector<EntityRecord> entities;     ///< @brief 世界状态，JSON 导入导出同样支持
+};
+
+/**
+ * @brief 异步、防崩溃的存档系统。
+ *
+ * - snapshot()：在游戏线程上把 SaveData 以版本化的紧凑二进制格式写入复用缓冲区（只有 memcpy 级别的开销），
+ *   然后交给后台线程。连续多次快照时只保留最新的一份。
+ * - 后台线程：压缩、加上带校验和的文件头，写入 "<path>.tmp" 并刷盘后原子重命名为目标文件。
+ *   写入过程中崩溃只会留下不完整的 .tmp 文件，已有存档不受影响。
+ * - load()：优先读取二进制存档；不存在或校验失败时回退到 JSON 存档（兼容现有的 save.json）。
+ * - exportJson()/importJson()：便于调试和手工编辑的 JSON 格式。
+ */
+class SaveSystem final {
+private:
+    std::string save_path_;         ///< @brief 二进制存档路径
+    std::string json_path_;         ///< @brief JSON 存档路径（导入回退、调试导出）
+
+    // --- 游戏线程与后台线程之间的交接 ---
+    std::thread worker_;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::condition_variable idle_condition_;
+    std::vector<std::byte> snapshot_buffer_;    ///< @brief 游戏线程写入的缓冲区
+    std::vector<std::byte> pending_buffer_;     ///< @brief 等待后台写盘的快照（与 snapshot_buffer_ 交换，复用容量）
+    bool has_pending_ = false;
+    bool writing_ = false;
+    bool stop_ = false;
+
+    // --- 统计（供调试/性能面板读取） ---
+    std::atomic<std::uint64_t> last_snapshot_ns_{0};    ///< @brief 最近一次 snapshot() 耗时
+    std::atomic<std::uint64_t> last_write_ns_{0};       ///< @brief 最近一次后台压缩 + 写盘耗时
+    std::atomic<std::uint32_t> completed_writes_{0};
+    std::atomic<std::uint32_t> failed_writes_{0};
+
+public:
+    /**
+     * @brief 构造函数，启动后台写盘线程。
+     * @param save_path 二进制存档路径。
+     * @param json_path JSON 存档路径。
+     */
+    explicit SaveSystem(std::string save_path = "assets/save.bin", std::string json_path = "assets/save.json");
+    ~SaveSystem();      ///< @brief 等待未完成的写入后退出后台线程
+
+    SaveSystem(const SaveSystem&) = delete;
+    SaveSystem& operator=(const SaveSystem&) = delete;
+    SaveSystem(SaveSystem&&) = delete;
+    SaveSystem& operator=(SaveSystem&&) = delete;
+
+    /**
+     * @brief 在游戏线程上拍摄快照并提交后台写入，立即返回。
+     */
+    void snapshot(const SaveData& data);
+
+    /**
+     * @brief 阻塞直到所有已提交的快照都写入磁盘（用于退出前或测试）。
+     */
+    void flush();
+
+    /**
+     * @brief 同步读取存档：二进制优先，失败时回退到 JSON。
+     * @return 两者都不可用时返回 false，data 保持不变。
+     */
+    bool load(SaveData& data) const;
+
+    bool exportJson(const SaveData& data) const;    ///< @brief 把存档以 JSON 格式写入 json_path（同样原子重命名）
+    bool importJson(SaveData& data) const;          ///< @brief 从 json_path 读取存档
+
+    [[nodiscard]] std::uint64_t getLastSnapshotNs() const { return last_snapshot_ns_.load(std::memory_order_relaxed); }
+    [[nodiscard]] std::uint64_t getLastWriteNs() const { return last_write_ns_.load(std::memory_order_relaxed); }
+    [[nodiscard]] std::uint32_t getCompletedWrites() const { return completed_writes_.load(std::memory_order_relaxed); }
+    [[nodiscard]] std::uint32_t getFailedWrites() const { return failed_writes_.load(std::memory_order_relaxed); }
+
+private:
+    void workerLoop();
+    bool writeSnapshot(const std::vector<std::byte>& snapshot);    ///< @brief 后台线程：压缩、加文件头、原子写入
+    bool loadBinary(SaveData& data) const;
+
+    static void serialize(const SaveData& data, std::vector<std::byte>& out);
+    static bool deserialize(const std::vector<std::byte>& in, SaveData& data);
+    static bool writeFileAtomically(const std::string& path, const void* data, std::size_t size);
+};
+
+} // namespace engine::save
+
+#endif //SUNNYLAND_SAVE_SYSTEM_H
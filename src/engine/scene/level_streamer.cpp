@@ -0,0 +1,744 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#include "level_streamer.h"
+#include "tile_table.h"
+#include "../resource/baked_texture.h"
+#include "../resource/resource_manager.h"
+#include "../utils/binary_stream.h"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <SDL3_image/SDL_image.h>
+#include <spdlog/spdlog.h>
+#include <utility>
+
+namespace engine::scene {
+
+namespace {
+
+constexpr std::uint32_t INDEX_MAGIC = 0x49524C53;       // "SLRI"
+constexpr std::uint32_t REGION_MAGIC = 0x47524C53;      // "SLRG"
+constexpr std::uint32_t CACHE_VERSION = 2;             // 2: 索引记录外部图块集的时间戳
+
+// 区域缓存是否过期以源文件（地图及其外部图块集）的大小和修改时间判断
+struct SourceStamp {
+    std::uint64_t size = 0;
+    std::int64_t mtime = 0;
+
+    bool operator==(const SourceStamp&) const = default;
+};
+
+SourceStamp getSourceStamp(const std::string& path) {
+    std::error_code ec;
+    SourceStamp stamp;
+    stamp.size = static_cast<std::uint64_t>(std::filesystem::file_size(path, ec));
+    stamp.mtime = static_cast<std::int64_t>(std::filesystem::last_write_time(path, ec).time_since_epoch().count());
+    return stamp;
+}
+
+bool loadJson(const std::string& path, nlohmann::json& out) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        spdlog::error("无法打开文件: {}", path);
+        return false;
+    }
+    try {
+        file >> out;
+    } catch (const nlohmann::json::parse_error& e) {
+        spdlog::error("解析 JSON 文件 '{}' 失败: {}", path, e.what());
+        return false;
+    }
+    return true;
+}
+
+// 返回子节点的引用；不存在时返回一个静态空数组（json::value() 返回副本，不能用于保存指针）
+const nlohmann::json& childArray(const nlohmann::json& json, const char* key) {
+    static const nlohmann::json empty = nlohmann::json::array();
+    auto it = json.find(key);
+    return it != json.end() ? *it : empty;
+}
+
+// 地图引用的外部图块集文件（.tsj）。图块集的修改会改变 gid 到纹理的映射，也要使缓存过期
+std::vector<std::string> collectTilesetSources(const nlohmann::json& map_json, const std::string& map_path) {
+    const auto base_dir = std::filesystem::path(map_path).parent_path();
+    std::vector<std::string> sources;
+    for (const auto& tileset_ref : childArray(map_json, "tilesets")) {
+        if (const auto source = tileset_ref.find("source"); source != tileset_ref.end() && source->is_string()) {
+            sources.push_back((base_dir / source->get<std::string>()).lexically_normal().generic_string());
+        }
+    }
+    return sources;
+}
+
+// 递归收集图块层和对象层（分组图层被展开）
+void collectLayers(const nlohmann::json& layers_json, std::vector<const nlohmann::json*>& tile_layers,
+                   std::vector<const nlohmann::json*>& object_layers) {
+    for (const auto& layer : layers_json) {
+        const std::string type = layer.value("type", "");
+        if (type == "tilelayer") {
+            tile_layers.push_back(&layer);
+        } else if (type == "objectgroup") {
+            object_layers.push_back(&layer);
+        } else if (type == "group") {
+            collectLayers(childArray(layer, "layers"), tile_layers, object_layers);
+        }
+    }
+}
+
+} // namespace
+
+LevelStreamer::LevelStreamer(engine::resource::ResourceManager& resource_manager, Settings settings)
+    : resource_manager_(resource_manager), settings_(settings) {
+    if (settings_.region_size <= 0) {
+        spdlog::warn("LevelStreamer: region_size 必须为正数，使用默认值 32。");
+        settings_.region_size = 32;
+    }
+    if (settings_.load_radius < 0) {
+        spdlog::warn("LevelStreamer: load_radius 不能为负，使用 0。");
+        settings_.load_radius = 0;
+    }
+    if (settings_.max_integrations_per_frame < 1) {
+        spdlog::warn("LevelStreamer: max_integrations_per_frame 至少为 1。");
+        settings_.max_integrations_per_frame = 1;
+    }
+    if (settings_.unload_radius <= settings_.load_radius) {
+        spdlog::warn("LevelStreamer: unload_radius ({}) 必须大于 load_radius ({})，已调整。",
+                     settings_.unload_radius, settings_.load_radius);
+        settings_.unload_radius = settings_.load_radius + 1;
+    }
+    worker_ = std::thread(&LevelStreamer::workerLoop, this);
+    SPDLOG_TRACE("LevelStreamer 构造成功。");
+}
+
+LevelStreamer::LevelStreamer(engine::resource::ResourceManager& resource_manager)
+    : LevelStreamer(resource_manager, Settings{}) {}
+
+LevelStreamer::~LevelStreamer() {
+    close();
+    {
+        std::lock_guard lock(mutex_);
+        stop_ = true;
+    }
+    condition_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+    // close() 之后仍在执行的任务可能又放入了结果，释放其中解码好的表面
+    for (auto& result : results_) {
+        for (auto& texture : result.textures) {
+            SDL_DestroySurface(texture.surface);
+        }
+    }
+    results_.clear();
+    SPDLOG_TRACE("LevelStreamer 析构成功。");
+}
+
+void LevelStreamer::open(const std::string& map_path) {
+    close();
+    SPDLOG_DEBUG("LevelStreamer: 异步打开地图 {}", map_path);
+    Job job;
+    job.generation = generation_;
+    job.map_path = map_path;
+    job.region_size = settings_.region_size;
+    pushJob(std::move(job));
+}
+
+void LevelStreamer::close() {
+    for (const int region_index : active_regions_) {
+        if (region_states_[region_index] == RegionState::Resident) {
+            unloadRegion(region_index);
+        }
+    }
+    active_regions_.clear();
+    region_states_.clear();
+    resident_.clear();
+    texture_refs_.clear();
+    index_.reset();
+    ++generation_;
+
+    // 丢弃排队中的任务和已完成但未接收的结果
+    std::vector<Result> stale_results;
+    {
+        std::lock_guard lock(mutex_);
+        jobs_.clear();
+        stale_results.swap(results_);
+    }
+    for (auto& result : stale_results) {
+        for (auto& texture : result.textures) {
+            SDL_DestroySurface(texture.surface);
+        }
+    }
+}
+
+void LevelStreamer::update(glm::vec2 focus_world_pos) {
+    // 1. 接收后台结果：打开索引的结果总是立即接收，区域结果每帧有上限
+    std::vector<Result> ready;
+    {
+        std::lock_guard lock(mutex_);
+        int region_budget = settings_.max_integrations_per_frame;
+        auto it = results_.begin();
+        while (it != results_.end()) {
+            if (it->region_index >= 0 && region_budget-- <= 0) {
+                ++it;
+                continue;
+            }
+            ready.push_back(std::move(*it));
+            it = results_.erase(it);
+        }
+    }
+    for (auto& result : ready) {
+        integrate(result);
+    }
+    if (!index_) {
+        return;
+    }
+
+    // 2. 计算焦点所在区域
+    const glm::vec2 region_pixels(static_cast<float>(index_->tile_size.x * index_->region_size),
+                                  static_cast<float>(index_->tile_size.y * index_->region_size));
+    const glm::ivec2 focus(static_cast<int>(std::floor(focus_world_pos.x / region_pixels.x)),
+                           static_cast<int>(std::floor(focus_world_pos.y / region_pixels.y)));
+    const auto distance = [&focus](int region_x, int region_y) {
+        return std::max(std::abs(region_x - focus.x), std::abs(region_y - focus.y));
+    };
+
+    // 3. 卸载超出 unload_radius 的区域（加载中的区域只标记，结果到达时丢弃；失败的区域在此复位，之后可重试）
+    const int region_count_x = index_->region_count.x;
+    std::erase_if(active_regions_, [&](int region_index) {
+        if (distance(region_index % region_count_x, region_index / region_count_x) <= settings_.unload_radius) {
+            return false;
+        }
+        if (region_states_[region_index] == RegionState::Resident) {
+            unloadRegion(region_index);
+        }
+        region_states_[region_index] = RegionState::Unloaded;
+        return true;
+    });
+
+    // 4. 由近到远请求 load_radius 内的区域
+    for (int ring = 0; ring <= settings_.load_radius; ++ring) {
+        for (int y = focus.y - ring; y <= focus.y + ring; ++y) {
+            for (int x = focus.x - ring; x <= focus.x + ring; ++x) {
+                if (distance(x, y) != ring || x < 0 || y < 0 || x >= region_count_x || y >= index_->region_count.y) {
+                    continue;
+                }
+                const int region_index = y * region_count_x + x;
+                if (region_states_[region_index] == RegionState::Unloaded) {
+                    requestRegion(region_index);
+                }
+            }
+        }
+    }
+}
+
+std::uint32_t LevelStreamer::getTile(std::size_t layer, int tile_x, int tile_y) const {
+    if (!index_ || tile_x < 0 || tile_y < 0 || tile_x >= index_->map_size.x || tile_y >= index_->map_size.y) {
+        return 0;
+    }
+    const int region_size = index_->region_size;
+    const int region_index = (tile_y / region_size) * index_->region_count.x + tile_x / region_size;
+    const auto& region = resident_[region_index];
+    if (!region || layer >= region->layers.size() || region->layers[layer].empty()) {
+        return 0;
+    }
+    return region->layers[layer][(tile_y % region_size) * region_size + tile_x % region_size];
+}
+
+const StreamedRegion* LevelStreamer::getRegion(glm::ivec2 region_coord) const {
+    if (!index_ || region_coord.x < 0 || region_coord.y < 0 ||
+        region_coord.x >= index_->region_count.x || region_coord.y >= index_->region_count.y) {
+        return nullptr;
+    }
+    return resident_[region_coord.y * index_->region_count.x + region_coord.x].get();
+}
+
+std::size_t LevelStreamer::getResidentRegionCount() const {
+    return static_cast<std::size_t>(std::ranges::count_if(active_regions_, [this](int region_index) {
+        return region_states_[region_index] == RegionState::Resident;
+    }));
+}
+
+std::size_t LevelStreamer::getResidentTextureCount() const {
+    return static_cast<std::size_t>(std::ranges::count_if(texture_refs_, [](int refs) { return refs > 0; }));
+}
+
+// --- 主线程内部函数 ---
+
+void LevelStreamer::integrate(Result& result) {
+    const bool stale = result.generation != generation_;
+
+    if (result.region_index < 0) {
+        if (!stale && result.index) {
+            index_ = std::move(result.index);
+            const auto region_total = static_cast<std::size_t>(index_->region_count.x) * index_->region_count.y;
+            region_states_.assign(region_total, RegionState::Unloaded);
+            resident_.clear();
+            resident_.resize(region_total);
+            texture_refs_.assign(index_->texture_paths.size(), 0);
+            spdlog::info("LevelStreamer: 地图就绪，{}x{} 图块，{}x{} 个区域，{} 个纹理。",
+                         index_->map_size.x, index_->map_size.y, index_->region_count.x, index_->region_count.y,
+                         index_->texture_paths.size());
+        } else if (!stale) {
+            spdlog::error("LevelStreamer: 打开地图失败。");
+        }
+        return;
+    }
+
+    // 地图已切换，或区域在加载期间已离开范围：丢弃结果
+    if (stale || region_states_[result.region_index] != RegionState::Loading || !result.region) {
+        for (auto& texture : result.textures) {
+            SDL_DestroySurface(texture.surface);
+        }
+        if (!stale && region_states_[result.region_index] == RegionState::Loading) {
+            // 留在 active_regions_ 中并标记为失败，离开卸载半径后才会重新请求，避免每帧重复读盘和报错
+            spdlog::error("LevelStreamer: 读取区域 {} 失败，离开范围前不再重试。", result.region_index);
+            region_states_[result.region_index] = RegionState::Failed;
+        }
+        return;
+    }
+
+    // 首次被引用的纹理向 ResourceManager 持有一次：有后台解码的表面就上传它，否则（加载期间被其他区域释放）同步加载。
+    // 其他区域已持有的纹理丢弃解码结果
+    for (const auto texture_id : result.region->texture_ids) {
+        if (texture_refs_[texture_id]++ != 0) {
+            continue;
+        }
+        const auto& path = index_->texture_paths[texture_id];
+        const auto decoded = std::ranges::find(result.textures, path, &DecodedTexture::path);
+        SDL_Surface* surface = decoded != result.textures.end() ? std::exchange(decoded->surface, nullptr) : nullptr;
+        resource_manager_.acquireTexture(path, surface);
+    }
+    for (auto& texture : result.textures) {
+        if (texture.surface) {
+            SDL_DestroySurface(texture.surface);
+        }
+    }
+
+    region_states_[result.region_index] = RegionState::Resident;
+    resident_[result.region_index] = std::move(result.region);
+    if (on_region_loaded_) {
+        on_region_loaded_(*resident_[result.region_index]);
+    }
+}
+
+void LevelStreamer::requestRegion(int region_index) {
+    Job job;
+    job.generation = generation_;
+    job.index = index_;
+    job.region_index = region_index;
+    // 只让后台解码当前未被任何区域引用（因而可能未加载）的纹理
+    for (const auto texture_id : index_->region_textures[region_index]) {
+        if (texture_refs_[texture_id] == 0) {
+            job.decode_textures.push_back(index_->texture_paths[texture_id]);
+        }
+    }
+    region_states_[region_index] = RegionState::Loading;
+    active_regions_.push_back(region_index);
+    pushJob(std::move(job));
+}
+
+void LevelStreamer::unloadRegion(int region_index) {
+    auto& region = resident_[region_index];
+    if (!region) {
+        return;
+    }
+    if (on_region_unloaded_) {
+        on_region_unloaded_(*region);
+    }
+    releaseTextures(region->texture_ids);
+    region.reset();
+}
+
+void LevelStreamer::releaseTextures(const std::vector<std::uint32_t>& texture_ids) {
+    for (const auto texture_id : texture_ids) {
+        if (--texture_refs_[texture_id] == 0) {
+            resource_manager_.releaseTexture(index_->texture_paths[texture_id]);
+        }
+    }
+}
+
+void LevelStreamer::pushJob(Job job) {
+    {
+        std::lock_guard lock(mutex_);
+        jobs_.push_back(std::move(job));
+    }
+    condition_.notify_one();
+}
+
+// --- 后台线程 ---
+
+void LevelStreamer::workerLoop() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock lock(mutex_);
+            condition_.wait(lock, [this] { return stop_ || !jobs_.empty(); });
+            if (stop_) {
+                return;
+            }
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+        }
+        Result result;
+        try {
+            result = runJob(job);
+        } catch (const std::exception& e) {
+            // 损坏的缓存或地图不能让后台线程终止整个进程，按加载失败处理
+            spdlog::error("LevelStreamer: 后台任务失败: {}", e.what());
+            result = Result{};
+            result.generation = job.generation;
+            result.region_index = job.map_path.empty() ? job.region_index : -1;
+        }
+        {
+            std::lock_guard lock(mutex_);
+            results_.push_back(std::move(result));
+        }
+    }
+}
+
+LevelStreamer::Result LevelStreamer::runJob(const Job& job) {
+    Result result;
+    result.generation = job.generation;
+    if (!job.map_path.empty()) {
+        result.index = openIndex(job.map_path, job.region_size);
+        return result;
+    }
+
+    result.region_index = job.region_index;
+    result.region = readRegion(*job.index, job.region_index);
+    if (result.region) {
+        for (const auto& path : job.decode_textures) {
+            SDL_Surface* surface = engine::resource::loadTextureSurface(path);
+            if (!surface) {
+                spdlog::warn("LevelStreamer: 后台解码图片 '{}' 失败。", path);
+                continue;
+            }
+            result.textures.push_back({path, surface});
+        }
+    }
+    return result;
+}
+
+std::shared_ptr<const LevelStreamer::MapIndex> LevelStreamer::openIndex(const std::string& map_path, int region_size) {
+    const std::string cache_dir = map_path + ".regions";
+    const std::string index_path = cache_dir + "/index.bin";
+    std::vector<std::byte> index_bytes;
+    if (engine::utils::readFileBytes(index_path, index_bytes)) {
+        if (auto index = parseIndex(index_bytes, map_path, cache_dir, region_size)) {
+            SPDLOG_DEBUG("LevelStreamer: 使用已有的区域缓存 {}", cache_dir);
+            return index;
+        }
+    }
+
+    spdlog::info("LevelStreamer: 区域缓存缺失或已过期，正在为 {} 构建...", map_path);
+    std::vector<std::vector<std::byte>> region_bytes;
+    if (!buildCache(map_path, region_size, index_bytes, region_bytes)) {
+        return nullptr;
+    }
+
+    // 先写区域文件、最后写索引：只要索引存在且未过期，所有区域文件就一定完整
+    std::error_code ec;
+    std::filesystem::create_directories(cache_dir, ec);
+    bool written = !ec;
+    for (std::size_t i = 0; written && i < region_bytes.size(); ++i) {
+        written = engine::utils::writeFileBytes(regionFilePath(cache_dir, static_cast<int>(i)), region_bytes[i]);
+    }
+    written = written && engine::utils::writeFileBytes(index_path, index_bytes);
+    if (written) {
+        spdlog::info("LevelStreamer: 区域缓存构建完成，共 {} 个区域。", region_bytes.size());
+        return parseIndex(index_bytes, map_path, cache_dir, region_size);
+    }
+
+    // 缓存目录不可写（如只读安装）：区域数据保留在内存中，本次运行照常流式加载
+    spdlog::warn("LevelStreamer: 无法写入区域缓存 '{}'，本次改用内存中的区域数据。", cache_dir);
+    auto index = parseIndex(index_bytes, map_path, std::string(), region_size);
+    if (index) {
+        index->region_data = std::move(region_bytes);
+    }
+    return index;
+}
+
+bool LevelStreamer::buildCache(const std::string& map_path, int region_size, std::vector<std::byte>& index_bytes,
+                               std::vector<std::vector<std::byte>>& region_bytes) {
+    nlohmann::json map_json;
+    if (!loadJson(map_path, map_json)) {
+        return false;
+    }
+    if (map_json.value("infinite", false)) {
+        spdlog::error("LevelStreamer: 暂不支持无限地图: {}", map_path);
+        return false;
+    }
+
+    const glm::ivec2 map_size(map_json.value("width", 0), map_json.value("height", 0));
+    const glm::ivec2 tile_size(map_json.value("tilewidth", 0), map_json.value("tileheight", 0));
+    if (map_size.x <= 0 || map_size.y <= 0 || tile_size.x <= 0 || tile_size.y <= 0) {
+        spdlog::error("LevelStreamer: 地图尺寸无效: {}", map_path);
+        return false;
+    }
+    const glm::ivec2 region_count((map_size.x + region_size - 1) / region_size, (map_size.y + region_size - 1) / region_size);
+
+    // 1. 图块集 -> gid 到纹理的映射
+    TileTable tile_table;
+    if (!tile_table.compile(map_path)) {
+        return false;
+    }
+    const auto& texture_paths = tile_table.getTexturePaths();
+
+    // 2. 收集图块层数据，对象按锚点归入区域
+    std::vector<const nlohmann::json*> tile_layers, object_layers;
+    collectLayers(childArray(map_json, "layers"), tile_layers, object_layers);
+
+    std::vector<std::vector<std::uint32_t>> layer_data;
+    std::vector<std::string> layer_names;
+    for (const auto* layer : tile_layers) {
+        if (!layer->contains("data") || !(*layer)["data"].is_array()) {
+            spdlog::warn("LevelStreamer: 图层 '{}' 不是 CSV 格式的有限地图数据，已跳过。", layer->value("name", ""));
+            continue;
+        }
+        layer_names.push_back(layer->value("name", ""));
+        layer_data.push_back((*layer)["data"].get<std::vector<std::uint32_t>>());
+    }
+
+    const auto region_total = static_cast<std::size_t>(region_count.x) * region_count.y;
+    std::vector<std::vector<StreamedObject>> region_objects(region_total);
+    for (const auto* layer : object_layers) {
+        for (const auto& object_json : layer->value("objects", nlohmann::json::array())) {
+            StreamedObject object;
+            object.id = object_json.value("id", 0u);
+            object.gid = object_json.value("gid", 0u) & GID_MASK;
+            object.position = {object_json.value("x", 0.0f), object_json.value("y", 0.0f)};
+            object.size = {object_json.value("width", 0.0f), object_json.value("height", 0.0f)};
+            object.name = object_json.value("name", "");
+            object.type = object_json.value("type", "");
+            // 以对象中心作为归属依据；图块对象的 y 是底边
+            const glm::vec2 center(object.position.x + object.size.x * 0.5f,
+                                   object.gid != 0 ? object.position.y - object.size.y * 0.5f : object.position.y + object.size.y * 0.5f);
+            const int region_x = std::clamp(static_cast<int>(center.x) / tile_size.x / region_size, 0, region_count.x - 1);
+            const int region_y = std::clamp(static_cast<int>(center.y) / tile_size.y / region_size, 0, region_count.y - 1);
+            region_objects[static_cast<std::size_t>(region_y) * region_count.x + region_x].push_back(std::move(object));
+        }
+    }
+
+    // 3. 逐区域生成数据，同时记录每个区域引用的纹理
+    std::vector<std::vector<std::uint32_t>> region_textures(region_total);
+    region_bytes.assign(region_total, {});
+    std::vector<std::uint32_t> tiles(static_cast<std::size_t>(region_size) * region_size);
+    for (int region_y = 0; region_y < region_count.y; ++region_y) {
+        for (int region_x = 0; region_x < region_count.x; ++region_x) {
+            const int region_index = region_y * region_count.x + region_x;
+            std::vector<std::uint32_t> textures;
+            engine::utils::BinaryWriter writer(region_bytes[region_index]);
+            writer.write(REGION_MAGIC);
+            writer.write(static_cast<std::uint32_t>(layer_data.size()));
+
+            for (const auto& data : layer_data) {
+                bool any_tile = false;
+                for (int local_y = 0; local_y < region_size; ++local_y) {
+                    for (int local_x = 0; local_x < region_size; ++local_x) {
+                        const int tile_x = region_x * region_size + local_x;
+                        const int tile_y = region_y * region_size + local_y;
+                        std::uint32_t gid = 0;
+                        const auto tile_index = static_cast<std::size_t>(tile_y) * map_size.x + tile_x;
+                        if (tile_x < map_size.x && tile_y < map_size.y && tile_index < data.size()) {
+                            gid = data[tile_index];
+                        }
+                        tiles[static_cast<std::size_t>(local_y) * region_size + local_x] = gid;
+                        if (gid != 0) {
+                            any_tile = true;
+                            textures.push_back(tile_table.getTextureId(gid));
+                        }
+                    }
+                }
+                writer.write(static_cast<std::uint8_t>(any_tile));
+                if (any_tile) {
+                    writer.writeBytes(tiles.data(), tiles.size() * sizeof(std::uint32_t));
+                }
+            }
+
+            const auto& objects = region_objects[region_index];
+            writer.write(static_cast<std::uint32_t>(objects.size()));
+            for (const auto& object : objects) {
+                writer.write(object.id);
+                writer.write(object.gid);
+                writer.write(object.position);
+                writer.write(object.size);
+                writer.writeString(object.name);
+                writer.writeString(object.type);
+                if (object.gid != 0) {
+                    textures.push_back(tile_table.getTextureId(object.gid));
+                }
+            }
+
+            std::ranges::sort(textures);
+            textures.erase(std::unique(textures.begin(), textures.end()), textures.end());
+            for (const auto texture : textures) {
+                if (texture != NO_TEXTURE) {
+                    region_textures[region_index].push_back(texture);
+                }
+            }
+        }
+    }
+
+    // 4. 索引：源文件时间戳、地图尺寸、图层名、纹理表、每个区域引用的纹理
+    index_bytes.clear();
+    engine::utils::BinaryWriter writer(index_bytes);
+    const auto stamp = getSourceStamp(map_path);
+    writer.write(INDEX_MAGIC);
+    writer.write(CACHE_VERSION);
+    writer.write(stamp.size);
+    writer.write(stamp.mtime);
+    writer.write(static_cast<std::int32_t>(region_size));
+    const auto tileset_sources = collectTilesetSources(map_json, map_path);
+    writer.write(static_cast<std::uint32_t>(tileset_sources.size()));
+    for (const auto& source : tileset_sources) {
+        const auto tileset_stamp = getSourceStamp(source);
+        writer.writeString(source);
+        writer.write(tileset_stamp.size);
+        writer.write(tileset_stamp.mtime);
+    }
+    writer.write(map_size);
+    writer.write(tile_size);
+    writer.write(static_cast<std::uint32_t>(layer_names.size()));
+    for (const auto& name : layer_names) {
+        writer.writeString(name);
+    }
+    writer.write(static_cast<std::uint32_t>(texture_paths.size()));
+    for (const auto& path : texture_paths) {
+        writer.writeString(path);
+    }
+    for (const auto& textures : region_textures) {
+        writer.write(static_cast<std::uint32_t>(textures.size()));
+        writer.writeBytes(textures.data(), textures.size() * sizeof(std::uint32_t));
+    }
+    return true;
+}
+
+std::shared_ptr<LevelStreamer::MapIndex> LevelStreamer::parseIndex(std::span<const std::byte> bytes, const std::string& map_path,
+                                                                   const std::string& cache_dir, int region_size) {
+    engine::utils::BinaryReader reader(bytes);
+    std::uint32_t magic = 0, version = 0;
+    SourceStamp stamp;
+    std::int32_t cached_region_size = 0;
+    reader.read(magic);
+    reader.read(version);
+    reader.read(stamp.size);
+    reader.read(stamp.mtime);
+    reader.read(cached_region_size);
+    if (!reader.good() || magic != INDEX_MAGIC || version != CACHE_VERSION ||
+        stamp != getSourceStamp(map_path) || cached_region_size != region_size) {
+        return nullptr;
+    }
+    std::uint32_t count = 0;
+    reader.read(count);
+    for (std::uint32_t i = 0; i < count && reader.good(); ++i) {
+        std::string source;
+        SourceStamp tileset_stamp;
+        reader.readString(source);
+        reader.read(tileset_stamp.size);
+        reader.read(tileset_stamp.mtime);
+        if (reader.good() && tileset_stamp != getSourceStamp(source)) {
+            return nullptr;
+        }
+    }
+
+    // 以下数值都来自文件：截断或损坏的缓存不能导致超大分配，按剩余字节数检查每个计数
+    constexpr std::size_t COUNT_BYTES = sizeof(std::uint32_t);
+    auto index = std::make_shared<MapIndex>();
+    index->cache_dir = cache_dir;
+    index->region_size = region_size;
+    reader.read(index->map_size);
+    reader.read(index->tile_size);
+    if (!reader.good() || index->map_size.x <= 0 || index->map_size.y <= 0 || index->tile_size.x <= 0 || index->tile_size.y <= 0) {
+        return nullptr;
+    }
+    index->region_count = {(index->map_size.x + region_size - 1) / region_size, (index->map_size.y + region_size - 1) / region_size};
+    if (!reader.read(count) || count > reader.remaining() / COUNT_BYTES) {
+        return nullptr;
+    }
+    index->layer_names.resize(count);
+    for (auto& name : index->layer_names) {
+        reader.readString(name);
+    }
+    if (!reader.read(count) || count > reader.remaining() / COUNT_BYTES) {
+        return nullptr;
+    }
+    index->texture_paths.resize(count);
+    for (auto& path : index->texture_paths) {
+        reader.readString(path);
+    }
+    const auto region_total = static_cast<std::size_t>(index->region_count.x) * static_cast<std::size_t>(index->region_count.y);
+    if (!reader.good() || region_total > reader.remaining() / COUNT_BYTES) {
+        return nullptr;
+    }
+    index->region_textures.resize(region_total);
+    for (auto& textures : index->region_textures) {
+        if (!reader.read(count) || count > reader.remaining() / COUNT_BYTES) {
+            return nullptr;
+        }
+        textures.resize(count);
+        reader.readBytes(textures.data(), count * sizeof(std::uint32_t));
+        if (std::ranges::any_of(textures, [&index](std::uint32_t id) { return id >= index->texture_paths.size(); })) {
+            return nullptr;
+        }
+    }
+    return reader.good() ? index : nullptr;
+}
+
+std::unique_ptr<StreamedRegion> LevelStreamer::readRegion(const MapIndex& index, int region_index) {
+    std::vector<std::byte> file_bytes;
+    std::span<const std::byte> bytes;
+    if (!index.region_data.empty()) {
+        bytes = index.region_data[region_index];
+    } else if (engine::utils::readFileBytes(regionFilePath(index.cache_dir, region_index), file_bytes)) {
+        bytes = file_bytes;
+    } else {
+        return nullptr;
+    }
+    engine::utils::BinaryReader reader(bytes);
+    std::uint32_t magic = 0, layer_count = 0;
+    reader.read(magic);
+    reader.read(layer_count);
+    if (!reader.good() || magic != REGION_MAGIC || layer_count != index.layer_names.size()) {
+        return nullptr;
+    }
+
+    auto region = std::make_unique<StreamedRegion>();
+    region->coord = {region_index % index.region_count.x, region_index / index.region_count.x};
+    region->layers.resize(layer_count);
+    const auto tile_count = static_cast<std::size_t>(index.region_size) * index.region_size;
+    for (auto& layer : region->layers) {
+        std::uint8_t present = 0;
+        reader.read(present);
+        if (present) {
+            layer.resize(tile_count);
+            reader.readBytes(layer.data(), tile_count * sizeof(std::uint32_t));
+        }
+    }
+    std::uint32_t object_count = 0;
+    reader.read(object_count);
+    for (std::uint32_t i = 0; i < object_count && reader.good(); ++i) {
+        StreamedObject object;
+        reader.read(object.id);
+        reader.read(object.gid);
+        reader.read(object.position);
+        reader.read(object.size);
+        reader.readString(object.name);
+        reader.readString(object.type);
+        region->objects.push_back(std::move(object));
+    }
+    if (!reader.good()) {
+        return nullptr;
+    }
+    region->texture_ids = index.region_textures[region_index];
+    return region;
+}
+
+std::string LevelStreamer::regionFilePath(const std::string& cache_dir, int region_index) {
+    return cache_dir + "/region_" + std::to_string(region_index) + ".bin";
+}
+
+} // namespace engine::scene
@@ -0,0 +1,207 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#ifndef SUNNYLAND_LEVEL_STREAMER_H
+#define SUNNYLAND_LEVEL_STREAMER_H
+
+#include <condition_variable>   // 用于 std::condition_variable
+#include <cstddef>              // 用于 std::byte
+#include <cstdint>              // 用于 std::uint32_t
+#include <deque>                // 用于 std::deque
+#include <functional>           // 用于 std::function
+#include <memory>               // 用于 std::unique_ptr
+#include <mutex>                // 用于 std::mutex
+#include <span>                 // 用于 std::span
+#include <string>               // 用于 std::string
+#include <thread>               // 用于 std::thread
+#include <vector>               // 用于 std::vector
+#include <glm/glm.hpp>
+
+struct SDL_Surface;
+
+namespace engine::resource {
+class ResourceManager;
+}
+
+namespace engine::scene {
+
+/**
+ * @brief 区域内的一个地图对象（来自 objectgroup 图层）。
+ */
+struct StreamedObject {
+    std::uint32_t id = 0;
+    std::uint32_t gid = 0;          ///< @brief 图块对象的全局图块 ID，普通对象为 0
+    glm::vec2 position{0.0f};       ///< @brief Tiled 中的 x/y（图块对象为左下角）
+    glm::vec2 size{0.0f};
+    std::string name;
+    std::string type;
+};
+
+/**
+ * @brief 一个已驻留内存的区域：region_size x region_size 个图块，以及归属于该区域的对象。
+ */
+struct StreamedRegion {
+    glm::ivec2 coord{0};                                ///< @brief 区域坐标（以区域为单位）
+    std::vector<std::vector<std::uint32_t>> layers;     ///< @brief 每个图块层一份 gid 数组，该层在区域内为空时数组为空
+    std::vector<StreamedObject> objects;
+    std::vector<std::uint32_t> texture_ids;             ///< @brief 区域引用的纹理在 LevelStreamer 纹理表中的下标
+};
+
+/**
+ * @brief 关卡流式加载器：把大地图切成固定大小的区域，按相机距离在后台异步加载/卸载。
+ *
+ * 工作流程：
+ * 1. open() 后，后台线程检查地图旁的区域缓存（<map>.regions/），缺失或过期时解析一次 .tmj，
+ *    把图块层和对象按区域切分写成独立的小文件。这是唯一一次需要完整解析地图的时刻。
+ *    地图或其外部图块集（.tsj）的大小、修改时间变化都会使缓存过期；目录不可写时区域数据留在内存中。
+ * 2. 每帧在主线程调用 update(相机中心)：半径 load_radius 内的区域被请求加载，
+ *    超出 unload_radius 的区域被卸载（unload_radius > load_radius 形成滞回，避免在边界来回抖动）。
+ * 3. 后台线程读取区域文件，并预先解码区域引用的、尚未驻留的图片；主线程每帧最多接收
+ *    max_integrations_per_frame 个完成的区域，只做纹理上传和回调，从而限制单帧卡顿。
+ *
+ * 纹理在流式加载器内按区域计数，首个引用它的区域驻留时向 ResourceManager 持有（acquireTexture），
+ * 最后一个引用它的区域卸载时释放；场景等其他持有者仍在使用的纹理不会被卸载。
+ * 驻留区域数量上限为 (2 * unload_radius + 1)²，与地图大小无关。
+ */
+class LevelStreamer final {
+public:
+    using RegionCallback = std::function<void(const StreamedRegion&)>;
+
+    struct Settings {
+        int region_size = 32;                   ///< @brief 区域边长（图块）
+        int load_radius = 1;                    ///< @brief 加载半径（区域，切比雪夫距离）
+        int unload_radius = 2;                  ///< @brief 卸载半径（区域），必须大于 load_radius
+        int max_integrations_per_frame = 2;     ///< @brief 每帧最多接收的已完成区域数
+    };
+
+private:
+    // Failed: 读取失败，离开 unload_radius 之前不再重试
+    enum class RegionState : std::uint8_t { Unloaded, Loading, Resident, Failed };
+
+    /**
+     * @brief 区域缓存索引。由后台线程构建后只读，通过 shared_ptr 在线程间共享。
+     */
+    struct MapIndex {
+        std::string cache_dir;
+        int region_size = 0;
+        glm::ivec2 map_size{0};                     ///< @brief 地图大小（图块）
+        glm::ivec2 tile_size{0};
+        glm::ivec2 region_count{0};                 ///< @brief 区域网格大小
+        std::vector<std::string> layer_names;       ///< @brief 图块层名称，下标与 StreamedRegion::layers 对应
+        std::vector<std::string> texture_paths;     ///< @brief 纹理路径表
+        std::vector<std::vector<std::uint32_t>> region_textures;   ///< @brief 每个区域引用的纹理下标
+        std::vector<std::vector<std::byte>> region_data;           ///< @brief 缓存目录不可写时保存在内存中的区域数据，否则为空
+    };
+
+    // 后台任务：打开索引，或读取一个区域。任务自带所需的全部数据，不访问主线程状态
+    struct Job {
+        std::uint64_t generation = 0;               ///< @brief 发出请求时的代次，close()/open() 后旧结果会被丢弃
+        std::string map_path;                       ///< @brief 非空表示打开索引任务
+        int region_size = 0;                        ///< @brief 打开索引任务使用的区域边长
+        std::shared_ptr<const MapIndex> index;
+        int region_index = -1;
+        std::vector<std::string> decode_textures;   ///< @brief 需要在后台预解码的图片
+    };
+
+    struct DecodedTexture {
+        std::string path;
+        SDL_Surface* surface = nullptr;             ///< @brief 后台解码结果，由主线程上传或释放
+    };
+
+    struct Result {
+        std::uint64_t generation = 0;
+        int region_index = -1;                      ///< @brief -1 表示打开索引任务的结果
+        std::shared_ptr<const MapIndex> index;
+        std::unique_ptr<StreamedRegion> region;
+        std::vector<DecodedTexture> textures;
+    };
+
+    engine::resource::ResourceManager& resource_manager_;
+    Settings settings_;
+
+    // --- 主线程状态 ---
+    std::shared_ptr<const MapIndex> index_;         ///< @brief 为空表示地图尚未就绪
+    std::vector<RegionState> region_states_;
+    std::vector<int> active_regions_;                           ///< @brief 处于加载中或已驻留状态的区域下标
+    std::vector<std::unique_ptr<StreamedRegion>> resident_;    ///< @brief 下标为区域下标，未驻留为空
+    std::vector<int> texture_refs_;                             ///< @brief 每个纹理被多少个驻留区域引用（大于 0 时持有 ResourceManager 中的纹理）
+    std::uint64_t generation_ = 0;
+    RegionCallback on_region_loaded_;
+    RegionCallback on_region_unloaded_;
+
+    // --- 后台线程 ---
+    std::thread worker_;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::deque<Job> jobs_;
+    std::vector<Result> results_;
+    bool stop_ = false;
+
+public:
+    LevelStreamer(engine::resource::ResourceManager& resource_manager, Settings settings);
+    explicit LevelStreamer(engine::resource::ResourceManager& resource_manager);
+    ~LevelStreamer();
+
+    LevelStreamer(const LevelStreamer&) = delete;
+    LevelStreamer& operator=(const LevelStreamer&) = delete;
+    LevelStreamer(LevelStreamer&&) = delete;
+    LevelStreamer& operator=(LevelStreamer&&) = delete;
+
+    /**
+     * @brief 异步打开地图。立即返回，isReady() 为 true 后 update() 才开始加载区域。
+     */
+    void open(const std::string& map_path);
+
+    /**
+     * @brief 卸载所有区域和它们引用的纹理，并丢弃尚未完成的后台结果。
+     */
+    void close();
+
+    /**
+     * @brief 每帧在主线程调用：接收后台结果，并根据相机位置请求/卸载区域。
+     * @param focus_world_pos 流式加载的焦点（通常为相机中心），世界坐标。
+     */
+    void update(glm::vec2 focus_world_pos);
+
+    void setOnRegionLoaded(RegionCallback callback) { on_region_loaded_ = std::move(callback); }      ///< @brief 区域驻留后回调（如生成对象）
+    void setOnRegionUnloaded(RegionCallback callback) { on_region_unloaded_ = std::move(callback); }  ///< @brief 区域卸载前回调（如销毁对象）
+
+    /**
+     * @brief 查询图块 gid；所在区域未驻留或坐标越界时返回 0。
+     */
+    [[nodiscard]] std::uint32_t getTile(std::size_t layer, int tile_x, int tile_y) const;
+    [[nodiscard]] const StreamedRegion* getRegion(glm::ivec2 region_coord) const;   ///< @brief 未驻留时返回 nullptr
+
+    [[nodiscard]] bool isReady() const { return index_ != nullptr; }
+    [[nodiscard]] glm::ivec2 getMapSize() const { return index_ ? index_->map_size : glm::ivec2(0); }
+    [[nodiscard]] glm::ivec2 getTileSize() const { return index_ ? index_->tile_size : glm::ivec2(0); }
+    [[nodiscard]] glm::ivec2 getRegionCount() const { return index_ ? index_->region_count : glm::ivec2(0); }
+    [[nodiscard]] const std::vector<std::string>& getLayerNames() const { return index_->layer_names; }      ///< @brief 仅在 isReady() 后调用
+    [[nodiscard]] const std::string& getTexturePath(std::uint32_t texture_id) const { return index_->texture_paths[texture_id]; }
+    [[nodiscard]] std::size_t getResidentRegionCount() const;
+    [[nodiscard]] std::size_t getResidentTextureCount() const;
+    [[nodiscard]] const Settings& getSettings() const { return settings_; }
+
+private:
+    void workerLoop();
+    // 以下静态函数在后台线程中运行，只读写参数
+    static Result runJob(const Job& job);
+    static std::shared_ptr<const MapIndex> openIndex(const std::string& map_path, int region_size);
+    static bool buildCache(const std::string& map_path, int region_size, std::vector<std::byte>& index_bytes,
+                           std::vector<std::vector<std::byte>>& region_bytes);
+    static std::shared_ptr<MapIndex> parseIndex(std::span<const std::byte> bytes, const std::string& map_path,
+                                                const std::string& cache_dir, int region_size);
+    static std::unique_ptr<StreamedRegion> readRegion(const MapIndex& index, int region_index);
+    static std::string regionFilePath(const std::string& cache_dir, int region_index);
+
+    void integrate(Result& result);             ///< @brief 主线程：接收一个后台结果
+    void requestRegion(int region_index);
+    void unloadRegion(int region_index);
+    void releaseTextures(const std::vector<std::uint32_t>& texture_ids);
+    void pushJob(Job job);
+};
+
+} // namespace engine::scene
+
+#endif //SUNNYLAND_LEVEL_STREAMER_H
@@ -0,0 +1,145 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#include "scene.h"
+#include "../resource/baked_texture.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <SDL3_image/SDL_image.h>
+#include <spdlog/spdlog.h>
+
+namespace engine::scene {
+
+namespace {
+
+bool loadJson(const std::string& path, nlohmann::json& out) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        spdlog::error("无法打开文件: {}", path);
+        return false;
+    }
+    try {
+        file >> out;
+    } catch (const nlohmann::json::parse_error& e) {
+        spdlog::error("解析 JSON 文件 '{}' 失败: {}", path, e.what());
+        return false;
+    }
+    return true;
+}
+
+std::string resolvePath(const std::filesystem::path& base_dir, const std::string& relative_path) {
+    return (base_dir / relative_path).lexically_normal().generic_string();
+}
+
+// 图块集中的图片：网格图块集为整张图，集合图块集为每个图块一张
+void collectTilesetImages(const nlohmann::json& tileset_json, const std::filesystem::path& base_dir, std::vector<std::string>& out) {
+    if (tileset_json.contains("image")) {
+        out.push_back(resolvePath(base_dir, tileset_json["image"].get<std::string>()));
+    }
+    for (const auto& tile : tileset_json.value("tiles", nlohmann::json::array())) {
+        if (tile.contains("image")) {
+            out.push_back(resolvePath(base_dir, tile["image"].get<std::string>()));
+        }
+    }
+}
+
+void collectImageLayers(const nlohmann::json& layers_json, const std::filesystem::path& base_dir, std::vector<std::string>& out) {
+    for (const auto& layer : layers_json) {
+        const std::string type = layer.value("type", "");
+        if (type == "imagelayer" && !layer.value("image", "").empty() && layer.value("visible", true)) {
+            out.push_back(resolvePath(base_dir, layer["image"].get<std::string>()));
+        } else if (type == "group") {
+            collectImageLayers(layer.value("layers", nlohmann::json::array()), base_dir, out);
+        }
+    }
+}
+
+} // namespace
+
+// --- SceneLoadContext ---
+
+SceneLoadContext::~SceneLoadContext() {
+    for (auto& texture : textures_) {
+        if (texture.surface) {
+            SDL_DestroySurface(texture.surface);
+        }
+    }
+}
+
+bool SceneLoadContext::preloadTexture(const std::string& file_path) {
+    auto& paths = assets_.textures;
+    if (std::find(paths.begin(), paths.end(), file_path) != paths.end()) {
+        return true;
+    }
+    // 与 TextureManager 相同，优先解码未过期的 .sltex，保证预加载的纹理与直接加载的混合模式一致
+    SDL_Surface* surface = engine::resource::loadTextureSurface(file_path);
+    if (!surface) {
+        spdlog::error("预加载纹理失败: '{}'", file_path);
+        return false;
+    }
+    paths.push_back(file_path);
+    textures_.push_back({file_path, surface});
+    return true;
+}
+
+void SceneLoadContext::preloadSound(const std::string& file_path) {
+    if (std::find(assets_.sounds.begin(), assets_.sounds.end(), file_path) == assets_.sounds.end()) {
+        assets_.sounds.push_back(file_path);
+    }
+}
+
+void SceneLoadContext::preloadMusic(const std::string& file_path) {
+    if (std::find(assets_.music.begin(), assets_.music.end(), file_path) == assets_.music.end()) {
+        assets_.music.push_back(file_path);
+    }
+}
+
+void SceneLoadContext::preloadFont(const std::string& file_path, int point_size) {
+    const std::pair<std::string, int> key{file_path, point_size};
+    if (std::find(assets_.fonts.begin(), assets_.fonts.end(), key) == assets_.fonts.end()) {
+        assets_.fonts.push_back(key);
+    }
+}
+
+bool SceneLoadContext::preloadMapTextures(const std::string& map_path) {
+    nlohmann::json map_json;
+    if (!loadJson(map_path, map_json)) {
+        return false;
+    }
+    const auto base_dir = std::filesystem::path(map_path).parent_path();
+
+    std::vector<std::string> images;
+    for (const auto& tileset_ref : map_json.value("tilesets", nlohmann::json::array())) {
+        if (!tileset_ref.contains("source")) {
+            collectTilesetImages(tileset_ref, base_dir, images);    // 内嵌图块集
+            continue;
+        }
+        const auto tileset_path = resolvePath(base_dir, tileset_ref["source"].get<std::string>());
+        nlohmann::json tileset_json;
+        if (!loadJson(tileset_path, tileset_json)) {
+            return false;
+        }
+        collectTilesetImages(tileset_json, std::filesystem::path(tileset_path).parent_path(), images);
+    }
+    collectImageLayers(map_json.value("layers", nlohmann::json::array()), base_dir, images);
+
+    for (const auto& image : images) {
+        if (isCancelled()) {
+            return false;
+        }
+        preloadTexture(image);      // 单张图片失败不影响其余图片，错误已记录
+    }
+    SPDLOG_DEBUG("地图 '{}' 预加载了 {} 张图片。", map_path, images.size());
+    return true;
+}
+
+// --- Scene ---
+
+Scene::Scene(std::string name, engine::resource::ResourceManager& resource_manager, SceneManager& scene_manager)
+    : name_(std::move(name)), resource_manager_(resource_manager), scene_manager_(scene_manager) {
+}
+
+} // namespace engine::scene
@@ -0,0 +1,135 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#ifndef SUNNYLAND_SCENE_H
+#define SUNNYLAND_SCENE_H
+
+#include <atomic>       // 用于 std::atomic
+#include <string>       // 用于 std::string
+#include <utility>      // 用于 std::pair
+#include <vector>       // 用于 std::vector
+
+struct SDL_Renderer;
+struct SDL_Surface;
+union SDL_Event;
+
+namespace engine::resource {
+class ResourceManager;
+}
+
+namespace engine::scene {
+
+class SceneManager;
+
+/**
+ * @brief 场景通过预加载声明的资源清单。场景被替换或弹出时，据此卸载新场景不再使用的资源。
+ */
+struct SceneAssets {
+    std::vector<std::string> textures;
+    std::vector<std::string> sounds;
+    std::vector<std::string> music;
+    std::vector<std::pair<std::string, int>> fonts;     ///< @brief 路径与字号
+};
+
+/**
+ * @brief 场景后台准备阶段（Scene::prepare）使用的上下文，在后台线程上调用。
+ *
+ * ResourceManager 不是线程安全的，纹理也只能在渲染线程创建，因此：
+ * - preloadTexture() 立即在当前（后台）线程解码图片（有未过期的 .sltex 时解码它），主线程之后只需上传；
+ * - 音效、音乐、字体只记录下来，由主线程在切换前分帧加载。
+ * 所有资源都进入 ResourceManager 后才会切换场景。
+ */
+class SceneLoadContext final {
+    friend class SceneManager;
+private:
+    struct DecodedTexture {
+        std::string path;
+        SDL_Surface* surface = nullptr;     ///< @brief 上传后为空
+    };
+
+    std::vector<DecodedTexture> textures_;
+    SceneAssets assets_;
+    std::atomic<bool> cancelled_{false};
+    std::atomic<float> progress_{0.0f};
+
+public:
+    SceneLoadContext() = default;
+    ~SceneLoadContext();    ///< @brief 释放尚未上传的表面（如加载被取消）
+
+    SceneLoadContext(const SceneLoadContext&) = delete;
+    SceneLoadContext& operator=(const SceneLoadContext&) = delete;
+    SceneLoadContext(SceneLoadContext&&) = delete;
+    SceneLoadContext& operator=(SceneLoadContext&&) = delete;
+
+    /**
+     * @brief 在当前线程解码图片，切换前由主线程上传到 ResourceManager。重复的路径会被忽略。
+     * @return 解码失败时返回 false。
+     */
+    bool preloadTexture(const std::string& file_path);
+    void preloadSound(const std::string& file_path);
+    void preloadMusic(const std::string& file_path);
+    void preloadFont(const std::string& file_path, int point_size);
+
+    /**
+     * @brief 解析 .tmj 地图，预加载其中所有图块集图片和图片层图片。
+     * @return 地图或图块集无法读取时返回 false。
+     */
+    bool preloadMapTextures(const std::string& map_path);
+
+    [[nodiscard]] bool isCancelled() const { return cancelled_.load(std::memory_order_relaxed); }
+    void setProgress(float progress) { progress_.store(progress, std::memory_order_relaxed); }   ///< @brief 可选：报告准备进度 [0, 1]
+};
+
+/**
+ * @brief 场景基类（标题、关卡、结算等）。
+ *
+ * 生命周期：
+ * 1. prepare()：后台线程调用。解析地图、解码图片、生成实体数据等耗时工作都放在这里，
+ *    只能访问场景自身和 context，不能访问渲染器、ResourceManager 或其他场景。
+ * 2. init()：主线程调用，此时 prepare() 声明的资源已全部在 ResourceManager 中，
+ *    只应做取纹理指针之类的轻量工作——它和场景切换发生在同一帧。
+ * 3. handleEvent()/update()/render()：作为栈顶场景运行时每帧调用（render 对栈中所有场景调用）。
+ * 4. clean()：被弹出或替换时调用。
+ */
+class Scene {
+    friend class SceneManager;
+private:
+    SceneAssets assets_;        ///< @brief 由 SceneManager 在切换时从加载上下文移入
+
+protected:
+    std::string name_;
+    engine::resource::ResourceManager& resource_manager_;
+    SceneManager& scene_manager_;       ///< @brief 用于请求切换到下一个场景
+
+public:
+    Scene(std::string name, engine::resource::ResourceManager& resource_manager, SceneManager& scene_manager);
+    virtual ~Scene() = default;
+
+    Scene(const Scene&) = delete;
+    Scene& operator=(const Scene&) = delete;
+    Scene(Scene&&) = delete;
+    Scene& operator=(Scene&&) = delete;
+
+    virtual bool prepare(SceneLoadContext& context) { return true; }   ///< @brief 后台线程：准备数据、声明资源，失败返回 false
+    virtual void init() {}                                              ///< @brief 主线程：成为活动场景前调用一次
+    virtual void handleEvent(const SDL_Event& event) {}
+    virtual void update(float delta_time) {}
+    virtual void render(SDL_Renderer* renderer) {}
+    virtual void clean() {}
+    virtual void onPause() {}       ///< @brief 有新场景压入栈顶时调用
+    virtual void onResume() {}      ///< @brief 重新回到栈顶时调用
+
+    /**
+     * @brief 静态画面（菜单、对话框等）在没有输入时画面不会变化，返回 true 后 GameApp 停止逐帧循环，
+     *        只在收到事件时推进一帧并重绘。默认返回 false（逐帧运行）。
+     */
+    [[nodiscard]] virtual bool isIdle() const { return false; }
+
+    [[nodiscard]] const std::string& getName() const { return name_; }
+    [[nodiscard]] const SceneAssets& getAssets() const { return assets_; }
+};
+
+} // namespace engine::scene
+
+#endif //SUNNYLAND_SCENE_H
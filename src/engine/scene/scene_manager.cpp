@@ -0,0 +1,325 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#include "scene_manager.h"
+#include "scene.h"
+#include "../core/coroutine.h"
+#include "../core/event_bus.h"
+#include "../core/frame_governor.h"
+#include "../resource/resource_manager.h"
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <unordered_set>
+#include <SDL3/SDL_timer.h>
+#include <spdlog/spdlog.h>
+
+namespace engine::scene {
+
+namespace {
+
+std::size_t assetCount(const SceneAssets& assets) {
+    return assets.textures.size() + assets.sounds.size() + assets.music.size() + assets.fonts.size();
+}
+
+// 资源按 纹理、音效、音乐、字体 的顺序编号，取前 count 个（即已经载入 ResourceManager 的部分）
+SceneAssets takeFirst(const SceneAssets& assets, std::size_t count) {
+    SceneAssets result;
+    const auto take = [&count](const auto& from, auto& to) {
+        const auto n = std::min(count, from.size());
+        to.assign(from.begin(), from.begin() + static_cast<std::ptrdiff_t>(n));
+        count -= n;
+    };
+    take(assets.textures, result.textures);
+    take(assets.sounds, result.sounds);
+    take(assets.music, result.music);
+    take(assets.fonts, result.fonts);
+    return result;
+}
+
+} // namespace
+
+SceneManager::SceneManager(engine::resource::ResourceManager& resource_manager, engine::core::EventBus& event_bus,
+                           engine::core::FrameGovernor& frame_governor, engine::core::CoroutineScheduler& scheduler,
+                           const engine::render::VirtualCanvas& canvas, Settings settings)
+    : resource_manager_(resource_manager), event_bus_(event_bus), frame_governor_(frame_governor), scheduler_(scheduler),
+      canvas_(canvas), settings_(settings) {
+    SPDLOG_TRACE("SceneManager 构造成功。");
+}
+
+SceneManager::SceneManager(engine::resource::ResourceManager& resource_manager, engine::core::EventBus& event_bus,
+                           engine::core::FrameGovernor& frame_governor, engine::core::CoroutineScheduler& scheduler,
+                           const engine::render::VirtualCanvas& canvas)
+    : SceneManager(resource_manager, event_bus, frame_governor, scheduler, canvas, Settings{}) {
+}
+
+SceneManager::~SceneManager() {
+    close();
+    SPDLOG_TRACE("SceneManager 析构成功。");
+}
+
+bool SceneManager::pushScene(std::unique_ptr<Scene> scene) {
+    if (!scene) {
+        return false;
+    }
+    startPreload(std::move(scene), Action::Push);
+    // 同步路径：直接等待后台准备完成，再不限时地载入所有资源
+    preload_->prepared.wait();
+    if (!advancePreload(UINT64_MAX)) {
+        return false;
+    }
+    activatePreload();
+    return true;
+}
+
+void SceneManager::requestPushScene(std::unique_ptr<Scene> scene) {
+    if (scene) {
+        startPreload(std::move(scene), Action::Push);
+    }
+}
+
+void SceneManager::requestReplaceScene(std::unique_ptr<Scene> scene) {
+    if (scene) {
+        startPreload(std::move(scene), Action::Replace);
+    }
+}
+
+void SceneManager::requestPopScene() {
+    pending_pop_ = true;
+}
+
+void SceneManager::handleEvent(const SDL_Event& event) {
+    if (auto* scene = getCurrentScene()) {
+        scene->handleEvent(event);
+    }
+}
+
+void SceneManager::update(float delta_time) {
+    reapAbandoned(false);
+
+    // 场景切换统一在帧开头进行，保证一帧之内栈是稳定的
+    if (pending_pop_) {
+        pending_pop_ = false;
+        popScene();
+    }
+    if (preload_) {
+        const auto budget_ns = static_cast<std::uint64_t>(settings_.upload_budget_ms * 1'000'000.0f);
+        if (advancePreload(SDL_GetTicksNS() + budget_ns)) {
+            activatePreload();
+        }
+    }
+
+    if (auto* scene = getCurrentScene()) {
+        scene->update(delta_time);
+    }
+}
+
+void SceneManager::render(SDL_Renderer* renderer) {
+    for (const auto& scene : scene_stack_) {
+        scene->render(renderer);
+    }
+}
+
+void SceneManager::close() {
+    if (preload_) {
+        preload_->context->cancelled_.store(true, std::memory_order_relaxed);
+        abandoned_.push_back(std::move(preload_));
+    }
+    reapAbandoned(true);
+    while (!scene_stack_.empty()) {
+        cleanScene(*scene_stack_.back());
+        scene_stack_.pop_back();
+    }
+    pending_pop_ = false;
+}
+
+float SceneManager::getLoadProgress() const {
+    if (!preload_) {
+        return 1.0f;
+    }
+    if (!preload_->prepare_done) {
+        return 0.5f * std::clamp(preload_->context->progress_.load(std::memory_order_relaxed), 0.0f, 1.0f);
+    }
+    const auto total = assetCount(preload_->context->assets_);
+    return total == 0 ? 1.0f : 0.5f + 0.5f * static_cast<float>(preload_->next_asset) / static_cast<float>(total);
+}
+
+void SceneManager::startPreload(std::unique_ptr<Scene> scene, Action action) {
+    if (preload_) {
+        // 新的请求覆盖尚未完成的预加载：通知其尽快结束，并卸载它已经载入的资源
+        spdlog::warn("场景 '{}' 的预加载被 '{}' 取代。", preload_->scene->getName(), scene->getName());
+        auto old = std::move(preload_);
+        old->context->cancelled_.store(true, std::memory_order_relaxed);
+        if (old->prepare_done) {
+            releaseAssets(takeFirst(old->context->assets_, old->next_asset));
+        }
+        abandoned_.push_back(std::move(old));
+    }
+
+    auto preload = std::make_unique<Preload>();
+    preload->scene = std::move(scene);
+    preload->context = std::make_unique<SceneLoadContext>();
+    preload->action = action;
+    preload->start_ns = SDL_GetTicksNS();
+    preload->prepared = std::async(std::launch::async, [scene = preload->scene.get(), context = preload->context.get()] {
+        // prepare() 中的异常（如地图 JSON 字段类型不符时的 nlohmann::json::type_error）在这里转为准备失败，
+        // 否则会在主线程的 get() 处重新抛出并终止游戏
+        try {
+            return scene->prepare(*context);
+        } catch (const std::exception& e) {
+            spdlog::error("场景 '{}' 准备时发生异常: {}", scene->getName(), e.what());
+        } catch (...) {
+            spdlog::error("场景 '{}' 准备时发生未知异常。", scene->getName());
+        }
+        return false;
+    });
+    SPDLOG_DEBUG("开始在后台预加载场景 '{}'。", preload->scene->getName());
+    preload_ = std::move(preload);
+}
+
+bool SceneManager::advancePreload(std::uint64_t deadline_ns) {
+    auto& preload = *preload_;
+    if (!preload.prepare_done) {
+        if (preload.prepared.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            return false;
+        }
+        preload.prepare_done = true;
+        if (!preload.prepared.get()) {
+            spdlog::error("场景 '{}' 准备失败，已放弃切换。", preload.scene->getName());
+            preload_.reset();       // 尚未上传任何资源，解码好的表面由上下文释放
+            return false;
+        }
+    }
+
+    // 主线程部分：逐个载入资源，超出本帧预算就留到下一帧（每帧至少处理一个）
+    auto& context = *preload.context;
+    const auto& assets = context.assets_;
+    const auto total = assetCount(assets);
+    while (preload.next_asset < total) {
+        auto index = preload.next_asset++;
+        if (index < context.textures_.size()) {
+            auto& texture = context.textures_[index];
+            resource_manager_.acquireTexture(texture.path, texture.surface);    // 持有纹理并接管表面
+            texture.surface = nullptr;
+        } else if ((index -= context.textures_.size()) < assets.sounds.size()) {
+            resource_manager_.loadSound(assets.sounds[index]);
+        } else if ((index -= assets.sounds.size()) < assets.music.size()) {
+            resource_manager_.loadMusic(assets.music[index]);
+        } else {
+            index -= assets.music.size();
+            resource_manager_.loadFont(assets.fonts[index].first, assets.fonts[index].second);
+        }
+        if (SDL_GetTicksNS() >= deadline_ns) {
+            break;
+        }
+    }
+    return preload.next_asset >= total;
+}
+
+void SceneManager::activatePreload() {
+    auto preload = std::move(preload_);
+    auto& scene = preload->scene;
+    scene->assets_ = std::move(preload->context->assets_);
+
+    // 先清理被替换的场景，再初始化新场景：两者的事件订阅、脚本和帧时间旋钮不能同时存在（同名旋钮会互相覆盖）
+    std::unique_ptr<Scene> replaced;
+    if (preload->action == Action::Replace && !scene_stack_.empty()) {
+        replaced = std::move(scene_stack_.back());
+        scene_stack_.pop_back();
+        cleanScene(*replaced);
+    } else if (auto* current = getCurrentScene()) {
+        current->onPause();
+    }
+    scene->init();
+    spdlog::info("切换到场景 '{}'（从请求到切换 {:.1f} ms）", scene->getName(),
+                 static_cast<double>(SDL_GetTicksNS() - preload->start_ns) / 1'000'000.0);
+    scene_stack_.push_back(std::move(scene));
+
+    // 新场景已入栈，旧场景独占的资源才能安全卸载
+    if (replaced) {
+        releaseAssets(replaced->assets_);
+    }
+}
+
+void SceneManager::popScene() {
+    if (scene_stack_.empty()) {
+        spdlog::warn("尝试从空的场景栈中弹出场景。");
+        return;
+    }
+    auto scene = std::move(scene_stack_.back());
+    scene_stack_.pop_back();
+    cleanScene(*scene);
+    releaseAssets(scene->assets_);
+    SPDLOG_DEBUG("弹出场景 '{}'。", scene->getName());
+    if (auto* current = getCurrentScene()) {
+        current->onResume();
+    }
+}
+
+bool SceneManager::isIdle() const {
+    const auto* current = getCurrentScene();
+    return current && current->isIdle() && !preload_ && !pending_pop_;
+}
+
+void SceneManager::cleanScene(Scene& scene) {
+    scheduler_.cancelAll(&scene);       // 协程帧内可能引用场景的对象，先于 clean() 销毁
+    scene.clean();
+    event_bus_.unsubscribeAll(&scene);
+    frame_governor_.removeKnobs(&scene);
+}
+
+void SceneManager::releaseAssets(const SceneAssets& assets) {
+    // 纹理由 ResourceManager 引用计数（流式加载器等也会持有同一纹理），逐个释放即可。
+    // 其余资源：栈中其他场景、以及已完成准备的预加载场景仍在使用的保留
+    for (const auto& path : assets.textures) {
+        resource_manager_.releaseTexture(path);
+    }
+
+    std::unordered_set<std::string> keep_sounds, keep_music, keep_fonts;
+    const auto fontKey = [](const std::pair<std::string, int>& font) { return font.first + "#" + std::to_string(font.second); };
+    const auto mark = [&](const SceneAssets& used) {
+        keep_sounds.insert(used.sounds.begin(), used.sounds.end());
+        keep_music.insert(used.music.begin(), used.music.end());
+        for (const auto& font : used.fonts) {
+            keep_fonts.insert(fontKey(font));
+        }
+    };
+    for (const auto& scene : scene_stack_) {
+        mark(scene->assets_);
+    }
+    if (preload_ && preload_->prepare_done) {
+        mark(preload_->context->assets_);
+    }
+
+    for (const auto& path : assets.sounds) {
+        if (!keep_sounds.contains(path)) {
+            resource_manager_.unloadSound(path);
+        }
+    }
+    for (const auto& path : assets.music) {
+        if (!keep_music.contains(path)) {
+            resource_manager_.unloadMusic(path);
+        }
+    }
+    for (const auto& font : assets.fonts) {
+        if (!keep_fonts.contains(fontKey(font))) {
+            resource_manager_.unloadFont(font.first, font.second);
+        }
+    }
+}
+
+void SceneManager::reapAbandoned(bool wait) {
+    std::erase_if(abandoned_, [wait](const std::unique_ptr<Preload>& preload) {
+        if (!preload->prepare_done && !wait &&
+            preload->prepared.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            return false;
+        }
+        if (!preload->prepare_done) {
+            preload->prepared.wait();
+        }
+        return true;
+    });
+}
+
+} // namespace engine::scene
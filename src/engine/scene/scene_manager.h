@@ -0,0 +1,131 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#ifndef SUNNYLAND_SCENE_MANAGER_H
+#define SUNNYLAND_SCENE_MANAGER_H
+
+#include <cstdint>      // 用于 std::uint64_t
+#include <future>       // 用于 std::future
+#include <memory>       // 用于 std::unique_ptr
+#include <vector>       // 用于 std::vector
+
+struct SDL_Renderer;
+union SDL_Event;
+
+namespace engine::resource {
+class ResourceManager;
+}
+
+namespace engine::core {
+class EventBus;
+class FrameGovernor;
+class CoroutineScheduler;
+}
+
+namespace engine::render {
+class VirtualCanvas;
+}
+
+namespace engine::scene {
+
+class Scene;
+class SceneLoadContext;
+struct SceneAssets;
+
+/**
+ * @brief 场景栈，支持在后台预加载下一个场景。
+ *
+ * requestPushScene()/requestReplaceScene() 不会阻塞：
+ * 1. 新场景的 prepare() 在后台线程执行，当前场景照常运行；
+ * 2. prepare() 完成后，主线程每帧在 upload_budget_ms 内把解码好的纹理上传、把音频和字体载入 ResourceManager；
+ * 3. 所有资源就绪后，在某一帧的 update() 开头调用新场景的 init() 并完成切换。
+ * 被替换/弹出的场景所独占的资源（不被栈中其他场景或正在加载的场景使用）随之卸载。
+ *
+ * update() 只更新栈顶场景；render() 从栈底到栈顶绘制所有场景，便于暂停菜单等覆盖在关卡之上。
+ * 场景在 getCanvas() 的逻辑分辨率下绘制（相机视口应取画布大小）。
+ * 场景通过 getEventBus() 订阅游戏事件、通过 getFrameGovernor() 注册画质旋钮、通过 getScheduler() 启动协程脚本；
+ * 以自身为 owner 的脚本在场景 clean() 之前取消，以自身为对象指针的订阅和以自身为 owner 的旋钮在 clean() 之后移除。
+ */
+class SceneManager final {
+public:
+    struct Settings {
+        float upload_budget_ms = 2.0f;      ///< @brief 每帧用于上传/载入资源的时间预算（至少处理一个资源）
+    };
+
+private:
+    enum class Action : std::uint8_t { Push, Replace };
+
+    struct Preload {
+        std::unique_ptr<Scene> scene;
+        std::unique_ptr<SceneLoadContext> context;
+        std::future<bool> prepared;
+        Action action = Action::Push;
+        bool prepare_done = false;
+        std::size_t next_asset = 0;         ///< @brief 按 纹理、音效、音乐、字体 的顺序已处理的资源数
+        std::uint64_t start_ns = 0;
+    };
+
+    engine::resource::ResourceManager& resource_manager_;
+    engine::core::EventBus& event_bus_;
+    engine::core::FrameGovernor& frame_governor_;
+    engine::core::CoroutineScheduler& scheduler_;
+    const engine::render::VirtualCanvas& canvas_;
+    Settings settings_;
+    std::vector<std::unique_ptr<Scene>> scene_stack_;
+    std::unique_ptr<Preload> preload_;
+    std::vector<std::unique_ptr<Preload>> abandoned_;   ///< @brief 被取消、等待后台线程结束的预加载
+    bool pending_pop_ = false;
+
+public:
+    SceneManager(engine::resource::ResourceManager& resource_manager, engine::core::EventBus& event_bus,
+                 engine::core::FrameGovernor& frame_governor, engine::core::CoroutineScheduler& scheduler,
+                 const engine::render::VirtualCanvas& canvas, Settings settings);
+    SceneManager(engine::resource::ResourceManager& resource_manager, engine::core::EventBus& event_bus,
+                 engine::core::FrameGovernor& frame_governor, engine::core::CoroutineScheduler& scheduler,
+                 const engine::render::VirtualCanvas& canvas);
+    ~SceneManager();
+
+    SceneManager(const SceneManager&) = delete;
+    SceneManager& operator=(const SceneManager&) = delete;
+    SceneManager(SceneManager&&) = delete;
+    SceneManager& operator=(SceneManager&&) = delete;
+
+    /**
+     * @brief 同步加载并压入场景（用于启动时的第一个场景）。
+     * @return prepare() 失败时返回 false，场景被丢弃。
+     */
+    bool pushScene(std::unique_ptr<Scene> scene);
+
+    void requestPushScene(std::unique_ptr<Scene> scene);       ///< @brief 后台预加载，就绪后压入栈顶
+    void requestReplaceScene(std::unique_ptr<Scene> scene);    ///< @brief 后台预加载，就绪后替换栈顶（如关卡切换）
+    void requestPopScene();                                     ///< @brief 下一帧开头弹出栈顶场景
+
+    void handleEvent(const SDL_Event& event);
+    void update(float delta_time);
+    void render(SDL_Renderer* renderer);
+    void close();       ///< @brief 取消预加载并清理所有场景
+
+    [[nodiscard]] engine::core::EventBus& getEventBus() const { return event_bus_; }
+    [[nodiscard]] engine::core::FrameGovernor& getFrameGovernor() const { return frame_governor_; }
+    [[nodiscard]] engine::core::CoroutineScheduler& getScheduler() const { return scheduler_; }
+    [[nodiscard]] const engine::render::VirtualCanvas& getCanvas() const { return canvas_; }
+    [[nodiscard]] Scene* getCurrentScene() const { return scene_stack_.empty() ? nullptr : scene_stack_.back().get(); }
+    [[nodiscard]] std::size_t getSceneCount() const { return scene_stack_.size(); }
+    [[nodiscard]] bool isLoading() const { return preload_ != nullptr; }
+    [[nodiscard]] bool isIdle() const;     ///< @brief 栈顶场景空闲，且没有正在进行的加载或待处理的弹出
+    [[nodiscard]] float getLoadProgress() const;    ///< @brief 当前预加载进度 [0, 1]，没有预加载时为 1
+
+private:
+    void startPreload(std::unique_ptr<Scene> scene, Action action);
+    bool advancePreload(std::uint64_t deadline_ns);     ///< @brief 推进预加载，全部就绪时返回 true
+    void activatePreload();
+    void popScene();
+    void cleanScene(Scene& scene);      ///< @brief 调用 clean() 并取消场景自身的事件订阅和画质旋钮
+    void releaseAssets(const SceneAssets& assets);     ///< @brief 卸载 assets 中不再被其他场景引用的资源
+    void reapAbandoned(bool wait);
+};
+
+} // namespace engine::scene
+
+#endif //SUNNYLAND_SCENE_MANAGER_H
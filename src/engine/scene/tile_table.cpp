@@ -0,0 +1,220 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#include "tile_table.h"
+#include "../render/animation.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+namespace engine::scene {
+
+namespace {
+
+bool loadJson(const std::string& path, nlohmann::json& out) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        spdlog::error("无法打开文件: {}", path);
+        return false;
+    }
+    try {
+        file >> out;
+    } catch (const nlohmann::json::parse_error& e) {
+        spdlog::error("解析 JSON 文件 '{}' 失败: {}", path, e.what());
+        return false;
+    }
+    return true;
+}
+
+// 与 ResourceManager、AnimationLibrary 一致的工程相对路径
+std::string resolvePath(const std::filesystem::path& base_dir, const std::string& relative_path) {
+    return (base_dir / relative_path).lexically_normal().generic_string();
+}
+
+// 返回子节点的引用；不存在时返回一个静态空数组（json::value() 返回副本，不能用于保存指针）
+const nlohmann::json& childArray(const nlohmann::json& json, const char* key) {
+    static const nlohmann::json empty = nlohmann::json::array();
+    auto it = json.find(key);
+    return it != json.end() ? *it : empty;
+}
+
+std::uint8_t readTileFlags(const nlohmann::json& tile_json) {
+    std::uint8_t flags = 0;
+    for (const auto& property : childArray(tile_json, "properties")) {
+        const std::string name = property.value("name", "");
+        // const json 的 operator[] 在键不存在时是未定义行为，必须先查找
+        const auto value_it = property.find("value");
+        if (value_it == property.end()) {
+            spdlog::warn("图块属性 '{}' 缺少 value，已忽略。", name);
+            continue;
+        }
+        const auto& value = *value_it;
+        const bool enabled = value.is_boolean() ? value.get<bool>() : !value.is_null();
+        if (!enabled) {
+            continue;
+        }
+        if (name == "solid") {
+            flags |= tile_flag::SOLID;
+        } else if (name == "unisolid") {
+            flags |= tile_flag::ONE_WAY;
+        } else if (name == "hazard") {
+            flags |= tile_flag::HAZARD;
+        } else if (name == "ladder") {
+            flags |= tile_flag::LADDER;
+        } else if (name == "slope") {
+            flags |= tile_flag::SLOPE;
+        }
+    }
+    return flags;
+}
+
+// "animation" 属性中作为图块默认动画的片段名："idle"，没有则取第一个；没有该属性返回空串
+std::string defaultClipName(const nlohmann::json& tile_json) {
+    for (const auto& property : childArray(tile_json, "properties")) {
+        if (property.value("name", "") != "animation") {
+            continue;
+        }
+        try {
+            const auto clips_json = nlohmann::json::parse(property.value("value", "{}"));
+            if (clips_json.contains("idle")) {
+                return "idle";
+            }
+            if (clips_json.is_object() && !clips_json.empty()) {
+                return clips_json.begin().key();
+            }
+        } catch (const nlohmann::json::parse_error&) {
+            // 解析错误由 AnimationLibrary 在烘焙时报告
+        }
+    }
+    return {};
+}
+
+} // namespace
+
+TileTable::TileTable() {
+    clear();
+}
+
+bool TileTable::compile(const std::string& map_path, engine::render::AnimationLibrary* animations) {
+    clear();
+    nlohmann::json map_json;
+    if (!loadJson(map_path, map_json)) {
+        return false;
+    }
+    const auto map_dir = std::filesystem::path(map_path).parent_path();
+
+    for (const auto& tileset_ref : childArray(map_json, "tilesets")) {
+        const auto first_gid = tileset_ref.value("firstgid", 1u);
+        nlohmann::json external;
+        const nlohmann::json* tileset_json = &tileset_ref;     // 内嵌图块集
+        std::string tileset_path;
+        auto base_dir = map_dir;
+        if (tileset_ref.contains("source")) {
+            tileset_path = resolvePath(map_dir, tileset_ref["source"].get<std::string>());
+            if (!loadJson(tileset_path, external)) {
+                clear();
+                return false;
+            }
+            tileset_json = &external;
+            base_dir = std::filesystem::path(tileset_path).parent_path();
+        }
+
+        // 1. 按图块集中出现的最大图块 ID 扩展各表（集合图块集的 ID 不一定连续）
+        const auto& tiles = childArray(*tileset_json, "tiles");
+        std::uint32_t end_gid = first_gid + tileset_json->value("tilecount", 0u);
+        for (const auto& tile : tiles) {
+            end_gid = std::max(end_gid, first_gid + tile.value("id", 0u) + 1);
+        }
+        if (flags_.size() < end_gid) {
+            flags_.resize(end_gid, 0);
+            source_rects_.resize(end_gid, SDL_FRect{});
+            texture_ids_.resize(end_gid, NO_TEXTURE);
+            animations_.resize(end_gid, NO_ANIMATION);
+        }
+
+        // 2. 网格图块集：整张图按 columns/margin/spacing 切分
+        std::string grid_image;
+        if (tileset_json->contains("image")) {
+            grid_image = resolvePath(base_dir, (*tileset_json)["image"].get<std::string>());
+            const auto texture_id = internTexture(grid_image);
+            const int columns = std::max(1, tileset_json->value("columns", 1));
+            const int tile_width = tileset_json->value("tilewidth", 0);
+            const int tile_height = tileset_json->value("tileheight", 0);
+            const int margin = tileset_json->value("margin", 0);
+            const int spacing = tileset_json->value("spacing", 0);
+            const auto tile_count = tileset_json->value("tilecount", 0u);
+            for (std::uint32_t id = 0; id < tile_count; ++id) {
+                const auto gid = first_gid + id;
+                const int column = static_cast<int>(id) % columns;
+                const int row = static_cast<int>(id) / columns;
+                source_rects_[gid] = {static_cast<float>(margin + column * (tile_width + spacing)),
+                                      static_cast<float>(margin + row * (tile_height + spacing)),
+                                      static_cast<float>(tile_width), static_cast<float>(tile_height)};
+                texture_ids_[gid] = texture_id;
+            }
+        }
+
+        // 3. 逐图块：属性位，集合图块集的图片与子矩形，动画片段
+        bool tileset_baked = false;     // 本图块集是否已烘焙进 animations（只在第一次查找失败时烘焙一次）
+        const auto find_clip = [&](const std::string& texture_path, const std::string& name) {
+            auto clip = animations->findClip(texture_path, name);
+            if (clip == engine::render::INVALID_CLIP && !tileset_baked && !tileset_path.empty()) {
+                tileset_baked = true;
+                animations->loadTileset(tileset_path);
+                clip = animations->findClip(texture_path, name);
+            }
+            return clip;
+        };
+        for (const auto& tile : tiles) {
+            const auto id = tile.value("id", 0u);
+            const auto gid = first_gid + id;
+            flags_[gid] = readTileFlags(tile);
+
+            std::string texture_path = grid_image;
+            if (tile.contains("image")) {
+                texture_path = resolvePath(base_dir, tile["image"].get<std::string>());
+                const auto image_width = tile.value("imagewidth", 0.0f);
+                const auto image_height = tile.value("imageheight", 0.0f);
+                source_rects_[gid] = {tile.value("x", 0.0f), tile.value("y", 0.0f),
+                                      tile.value("width", image_width), tile.value("height", image_height)};
+                texture_ids_[gid] = internTexture(texture_path);
+            }
+
+            if (!animations || texture_path.empty()) {
+                continue;
+            }
+            std::string clip_name = defaultClipName(tile);
+            if (clip_name.empty() && tile.contains("animation") && !grid_image.empty()) {
+                clip_name = std::to_string(id);     // Tiled 原生动画
+            }
+            if (!clip_name.empty()) {
+                animations_[gid] = find_clip(texture_path, clip_name);
+            }
+        }
+    }
+
+    SPDLOG_DEBUG("图块表编译完成: {}（{} 个 gid，{} 张纹理）", map_path, flags_.size(), texture_paths_.size());
+    return true;
+}
+
+void TileTable::clear() {
+    flags_.assign(1, 0);
+    source_rects_.assign(1, SDL_FRect{});
+    texture_ids_.assign(1, NO_TEXTURE);
+    animations_.assign(1, NO_ANIMATION);
+    texture_paths_.clear();
+    texture_ids_by_path_.clear();
+}
+
+std::uint32_t TileTable::internTexture(const std::string& texture_path) {
+    auto [it, inserted] = texture_ids_by_path_.emplace(texture_path, static_cast<std::uint32_t>(texture_paths_.size()));
+    if (inserted) {
+        texture_paths_.push_back(texture_path);
+    }
+    return it->second;
+}
+
+} // namespace engine::scene
@@ -0,0 +1,95 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#ifndef SUNNYLAND_TILE_TABLE_H
+#define SUNNYLAND_TILE_TABLE_H
+
+#include <cstdint>        // 用于 std::uint8_t, std::uint32_t
+#include <string>         // 用于 std::string
+#include <unordered_map>  // 用于 std::unordered_map
+#include <vector>         // 用于 std::vector
+#include <SDL3/SDL_rect.h>
+
+namespace engine::render {
+class AnimationLibrary;
+}
+
+namespace engine::scene {
+
+/**
+ * @brief 图块属性位，由图块集中的自定义属性（solid、unisolid、hazard、ladder、slope）得出。
+ */
+namespace tile_flag {
+inline constexpr std::uint8_t SOLID = 1u << 0;      ///< @brief 实心
+inline constexpr std::uint8_t ONE_WAY = 1u << 1;    ///< @brief 单向平台（unisolid），可从下方穿过、站在上面
+inline constexpr std::uint8_t HAZARD = 1u << 2;     ///< @brief 危险图块（尖刺等）
+inline constexpr std::uint8_t LADDER = 1u << 3;
+inline constexpr std::uint8_t SLOPE = 1u << 4;
+}
+
+inline constexpr std::uint32_t GID_MASK = 0x0FFFFFFFu;             ///< @brief 去掉 Tiled 的翻转/旋转标志位
+inline constexpr std::uint32_t NO_TEXTURE = 0xFFFFFFFFu;
+inline constexpr std::uint32_t NO_ANIMATION = 0xFFFFFFFFu;         ///< @brief 与 render::INVALID_CLIP 相同
+
+/**
+ * @brief 把地图引用的所有图块集（.tsj 或内嵌）编译成按 gid 索引的扁平表。
+ *
+ * 加载期解析一次嵌套的 JSON：按 firstgid 把各图块集的图块 ID 换算成 gid（如 level1 中
+ * tileset/prop/actor 的 firstgid 为 1、576、607），得到每个 gid 的属性位、源矩形、纹理和动画片段。
+ * 之后碰撞、导航和渲染的逐图块查询都只是一次数组读取，不再查找 map 或 JSON 节点。
+ * gid 0（空图块）和超出范围的 gid 返回空值：属性位 0、NO_TEXTURE、NO_ANIMATION。
+ * 传入的 gid 可以带翻转标志位，查询时会去掉。
+ */
+class TileTable final {
+private:
+    std::vector<std::uint8_t> flags_;           ///< @brief gid -> tile_flag 属性位
+    std::vector<SDL_FRect> source_rects_;       ///< @brief gid -> 在纹理中的源矩形
+    std::vector<std::uint32_t> texture_ids_;    ///< @brief gid -> 纹理路径表下标，NO_TEXTURE 表示无图片
+    std::vector<std::uint32_t> animations_;     ///< @brief gid -> AnimationLibrary 中的片段，NO_ANIMATION 表示静态图块
+    std::vector<std::string> texture_paths_;    ///< @brief 纹理路径表（工程相对路径，与 ResourceManager 一致）
+    std::unordered_map<std::string, std::uint32_t> texture_ids_by_path_;   ///< @brief 仅在编译时使用
+
+public:
+    TileTable();
+
+    /**
+     * @brief 编译地图（.tmj）引用的所有图块集。
+     * @param map_path 地图文件路径，外部图块集的 source 相对它解析。
+     * @param animations 非空时，带动画的图块会在其中查找（必要时先烘焙）对应的片段：
+     *        Tiled 原生动画取以图块 ID 命名的片段，"animation" 属性取 "idle" 片段（没有则取第一个）。
+     * @return 地图或图块集无法读取时返回 false，表被清空。
+     */
+    bool compile(const std::string& map_path, engine::render::AnimationLibrary* animations = nullptr);
+    void clear();   ///< @brief 清空，只保留 gid 0 的空条目
+
+    [[nodiscard]] std::uint8_t getFlags(std::uint32_t gid) const {
+        gid &= GID_MASK;
+        return gid < flags_.size() ? flags_[gid] : 0;
+    }
+    [[nodiscard]] bool hasFlag(std::uint32_t gid, std::uint8_t flag) const { return (getFlags(gid) & flag) != 0; }
+    [[nodiscard]] const SDL_FRect& getSourceRect(std::uint32_t gid) const {
+        gid &= GID_MASK;
+        return source_rects_[gid < source_rects_.size() ? gid : 0];
+    }
+    [[nodiscard]] std::uint32_t getTextureId(std::uint32_t gid) const {
+        gid &= GID_MASK;
+        return gid < texture_ids_.size() ? texture_ids_[gid] : NO_TEXTURE;
+    }
+    [[nodiscard]] std::uint32_t getAnimation(std::uint32_t gid) const {
+        gid &= GID_MASK;
+        return gid < animations_.size() ? animations_[gid] : NO_ANIMATION;
+    }
+
+    [[nodiscard]] const std::string& getTexturePath(std::uint32_t texture_id) const { return texture_paths_[texture_id]; }
+    [[nodiscard]] const std::vector<std::string>& getTexturePaths() const { return texture_paths_; }
+    [[nodiscard]] std::size_t getGidCount() const { return flags_.size(); }     ///< @brief 最大 gid + 1（未编译时为 1）
+    [[nodiscard]] const std::vector<std::uint8_t>& getFlagTable() const { return flags_; }  ///< @brief 整张属性表，供批量处理
+
+private:
+    std::uint32_t internTexture(const std::string& texture_path);
+};
+
+} // namespace engine::scene
+
+#endif //SUNNYLAND_TILE_TABLE_H
@@ -0,0 +1,34 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#include "binary_stream.h"
+#include <fstream>
+
+namespace engine::utils {
+
+bool readFileBytes(const std::string& file_path, std::vector<std::byte>& out) {
+    std::ifstream file(file_path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return false;
+    }
+    const auto size = file.tellg();
+    if (size < 0) {
+        return false;
+    }
+    out.resize(static_cast<std::size_t>(size));
+    file.seekg(0);
+    return static_cast<bool>(file.read(reinterpret_cast<char*>(out.data()), size));
+}
+
+bool writeFileBytes(const std::string& file_path, std::span<const std::byte> data) {
+    std::ofstream file(file_path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    file.flush();
+    return static_cast<bool>(file);
+}
+
+} // namespace engine::utils
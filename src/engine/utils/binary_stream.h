@@ -0,0 +1,102 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#ifndef SUNNYLAND_BINARY_STREAM_H
+#define SUNNYLAND_BINARY_STREAM_H
+
+#include <cstddef>      // 用于 std::byte
+#include <cstdint>      // 用于 std::uint32_t
+#include <cstring>      // 用于 std::memcpy
+#include <span>         // 用于 std::span
+#include <string>       // 用于 std::string
+#include <string_view>  // 用于 std::string_view
+#include <type_traits>  // 用于 std::is_trivially_copyable_v
+#include <vector>       // 用于 std::vector
+
+namespace engine::utils {
+
+/**
+ * @brief 向字节缓冲区顺序写入平凡可拷贝类型和字符串（本机字节序）。
+ *
+ * 只用于引擎自己生成、自己读取的缓存/存档格式，不考虑跨平台字节序。
+ */
+class BinaryWriter final {
+private:
+    std::vector<std::byte>& buffer_;
+
+public:
+    explicit BinaryWriter(std::vector<std::byte>& buffer) : buffer_(buffer) {}
+
+    template <typename T>
+    void write(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "BinaryWriter::write 只支持平凡可拷贝类型");
+        writeBytes(&value, sizeof(T));
+    }
+
+    void writeBytes(const void* data, std::size_t size) {
+        const auto offset = buffer_.size();
+        buffer_.resize(offset + size);
+        std::memcpy(buffer_.data() + offset, data, size);
+    }
+
+    void writeString(std::string_view value) {
+        write(static_cast<std::uint32_t>(value.size()));
+        writeBytes(value.data(), value.size());
+    }
+
+    [[nodiscard]] std::size_t size() const { return buffer_.size(); }
+};
+
+/**
+ * @brief 从字节序列顺序读取 BinaryWriter 写入的数据。
+ *
+ * 任何一次越界读取都会使读取器进入失败状态，之后的读取全部返回 false，调用方只需在最后检查 good()。
+ */
+class BinaryReader final {
+private:
+    std::span<const std::byte> data_;
+    std::size_t offset_ = 0;
+    bool good_ = true;
+
+public:
+    explicit BinaryReader(std::span<const std::byte> data) : data_(data) {}
+
+    template <typename T>
+    bool read(T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "BinaryReader::read 只支持平凡可拷贝类型");
+        return readBytes(&value, sizeof(T));
+    }
+
+    bool readBytes(void* out, std::size_t size) {
+        if (!good_ || size > data_.size() - offset_) {
+            good_ = false;
+            return false;
+        }
+        std::memcpy(out, data_.data() + offset_, size);
+        offset_ += size;
+        return true;
+    }
+
+    bool readString(std::string& value) {
+        std::uint32_t length = 0;
+        if (!read(length) || length > data_.size() - offset_) {
+            good_ = false;
+            return false;
+        }
+        value.assign(reinterpret_cast<const char*>(data_.data() + offset_), length);
+        offset_ += length;
+        return true;
+    }
+
+    [[nodiscard]] bool good() const { return good_; }
+    [[nodiscard]] std::size_t remaining() const { return data_.size() - offset_; }
+    [[nodiscard]] std::size_t offset() const { return offset_; }
+};
+
+bool readFileBytes(const std::string& file_path, std::vector<std::byte>& out);      ///< @brief 读取整个文件，失败返回 false
+bool writeFileBytes(const std::string& file_path, std::span<const std::byte> data); ///< @brief 覆盖写入整个文件，失败返回 false
+
+} // namespace engine::utils
+
+#endif //SUNNYLAND_BINARY_STREAM_H
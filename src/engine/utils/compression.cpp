@@ -0,0 +1,163 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#include "compression.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace engine::utils {
+
+namespace {
+
+constexpr std::size_t MIN_MATCH = 4;
+constexpr std::size_t MAX_OFFSET = 0xFFFF;
+constexpr int HASH_BITS = 12;
+
+std::uint32_t read32(const std::byte* p) {
+    std::uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+std::uint32_t hash4(std::uint32_t value) {
+    return (value * 2654435761u) >> (32 - HASH_BITS);
+}
+
+// 长度 >= 15 时，超出部分用若干个 255 加一个余数字节表示
+void writeLength(std::vector<std::byte>& out, std::size_t length) {
+    while (length >= 255) {
+        out.push_back(std::byte{255});
+        length -= 255;
+    }
+    out.push_back(static_cast<std::byte>(length));
+}
+
+bool readLength(std::span<const std::byte> input, std::size_t& pos, std::size_t& length) {
+    std::byte value{255};
+    while (value == std::byte{255}) {
+        if (pos >= input.size()) {
+            return false;
+        }
+        value = input[pos++];
+        length += static_cast<std::size_t>(value);
+    }
+    return true;
+}
+
+void writeSequence(std::vector<std::byte>& out, const std::byte* literals, std::size_t literal_length,
+                   std::size_t offset, std::size_t match_length) {
+    const std::size_t match_code = match_length >= MIN_MATCH ? match_length - MIN_MATCH : 0;
+    const auto token = static_cast<std::uint8_t>((std::min<std::size_t>(literal_length, 15) << 4) |
+                                                 std::min<std::size_t>(match_code, 15));
+    out.push_back(static_cast<std::byte>(token));
+    if (literal_length >= 15) {
+        writeLength(out, literal_length - 15);
+    }
+    out.insert(out.end(), literals, literals + literal_length);
+    if (match_length == 0) {
+        return;     // 最后一个序列只有字面量
+    }
+    out.push_back(static_cast<std::byte>(offset & 0xFF));
+    out.push_back(static_cast<std::byte>(offset >> 8));
+    if (match_code >= 15) {
+        writeLength(out, match_code - 15);
+    }
+}
+
+} // namespace
+
+void compressLz(std::span<const std::byte> input, std::vector<std::byte>& out) {
+    std::array<std::uint32_t, 1u << HASH_BITS> table{};     // 存 位置 + 1，0 表示空
+    const std::byte* data = input.data();
+    const std::size_t size = input.size();
+    std::size_t anchor = 0;
+    std::size_t pos = 0;
+
+    while (size >= MIN_MATCH && pos + MIN_MATCH <= size) {
+        const std::uint32_t sequence = read32(data + pos);
+        auto& slot = table[hash4(sequence)];
+        const std::size_t candidate = slot;
+        slot = static_cast<std::uint32_t>(pos + 1);
+
+        if (candidate == 0 || pos - (candidate - 1) > MAX_OFFSET || read32(data + candidate - 1) != sequence) {
+            ++pos;
+            continue;
+        }
+        const std::size_t match_pos = candidate - 1;
+        std::size_t match_length = MIN_MATCH;
+        while (pos + match_length < size && data[match_pos + match_length] == data[pos + match_length]) {
+            ++match_length;
+        }
+        writeSequence(out, data + anchor, pos - anchor, pos - match_pos, match_length);
+        pos += match_length;
+        anchor = pos;
+    }
+    writeSequence(out, data + anchor, size - anchor, 0, 0);
+}
+
+bool decompressLz(std::span<const std::byte> input, std::size_t expected_size, std::vector<std::byte>& out) {
+    out.clear();
+    out.reserve(expected_size);
+    std::size_t pos = 0;
+
+    while (pos < input.size()) {
+        const auto token = static_cast<std::uint8_t>(input[pos++]);
+        std::size_t literal_length = token >> 4;
+        if (literal_length == 15 && !readLength(input, pos, literal_length)) {
+            return false;
+        }
+        if (literal_length > input.size() - pos || out.size() + literal_length > expected_size) {
+            return false;
+        }
+        out.insert(out.end(), input.begin() + static_cast<std::ptrdiff_t>(pos),
+                   input.begin() + static_cast<std::ptrdiff_t>(pos + literal_length));
+        pos += literal_length;
+        if (pos == input.size()) {
+            break;  // 最后一个序列
+        }
+
+        if (input.size() - pos < 2) {
+            return false;
+        }
+        const std::size_t offset = static_cast<std::size_t>(input[pos]) | (static_cast<std::size_t>(input[pos + 1]) << 8);
+        pos += 2;
+        std::size_t match_length = token & 0x0F;
+        if (match_length == 15 && !readLength(input, pos, match_length)) {
+            return false;
+        }
+        match_length += MIN_MATCH;
+        if (offset == 0 || offset > out.size() || out.size() + match_length > expected_size) {
+            return false;
+        }
+        // 匹配区可能与输出重叠（offset < match_length），必须逐字节复制
+        const std::size_t start = out.size() - offset;
+        for (std::size_t i = 0; i < match_length; ++i) {
+            out.push_back(out[start + i]);
+        }
+    }
+    return out.size() == expected_size;
+}
+
+std::uint32_t crc32(std::span<const std::byte> data) {
+    static const auto table = [] {
+        std::array<std::uint32_t, 256> result{};
+        for (std::uint32_t i = 0; i < 256; ++i) {
+            std::uint32_t value = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                value = (value & 1) ? (0xEDB88320u ^ (value >> 1)) : (value >> 1);
+            }
+            result[i] = value;
+        }
+        return result;
+    }();
+
+    std::uint32_t crc = 0xFFFFFFFFu;
+    for (const std::byte b : data) {
+        crc = table[(crc ^ static_cast<std::uint32_t>(b)) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+} // namespace engine::utils
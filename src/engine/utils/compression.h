@@ -0,0 +1,36 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#ifndef SUNNYLAND_COMPRESSION_H
+#define SUNNYLAND_COMPRESSION_H
+
+#include <cstddef>  // 用于 std::byte
+#include <cstdint>  // 用于 std::uint32_t
+#include <span>     // 用于 std::span
+#include <vector>   // 用于 std::vector
+
+namespace engine::utils {
+
+/**
+ * @brief 轻量级 LZ77 压缩（LZ4 风格的字节序列格式），适合存档这类重复结构较多的小数据。
+ *
+ * 不追求压缩率，只求实现简单、速度快、无第三方依赖。输出会追加到 out 末尾。
+ */
+void compressLz(std::span<const std::byte> input, std::vector<std::byte>& out);
+
+/**
+ * @brief 解压 compressLz() 的输出。
+ * @param expected_size 原始数据大小（由调用方在容器头中记录）。
+ * @return 数据损坏或大小不符时返回 false，out 内容未定义。
+ */
+bool decompressLz(std::span<const std::byte> input, std::size_t expected_size, std::vector<std::byte>& out);
+
+/**
+ * @brief 计算 CRC-32（IEEE 802.3 多项式），用于校验文件完整性。
+ */
+std::uint32_t crc32(std::span<const std::byte> data);
+
+} // namespace engine::utils
+
+#endif //SUNNYLAND_COMPRESSION_H
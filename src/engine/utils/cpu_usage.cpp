@@ -0,0 +1,68 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#include "cpu_usage.h"
+#include <chrono>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>        // 用于 GetProcessTimes
+#else
+#include <sys/resource.h>   // 用于 getrusage
+#endif
+
+namespace engine::utils {
+
+namespace {
+
+double wallSeconds() {
+    using Clock = std::chrono::steady_clock;
+    return std::chrono::duration<double>(Clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+double getProcessCpuSeconds() {
+#ifdef _WIN32
+    FILETIME creation, exit, kernel, user;
+    if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user)) {
+        return 0.0;
+    }
+    // FILETIME 的单位是 100 纳秒
+    const auto toSeconds = [](const FILETIME& time) {
+        const auto ticks = (static_cast<unsigned long long>(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+        return static_cast<double>(ticks) * 1e-7;
+    };
+    return toSeconds(kernel) + toSeconds(user);
+#else
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0.0;
+    }
+    const auto toSeconds = [](const timeval& time) {
+        return static_cast<double>(time.tv_sec) + static_cast<double>(time.tv_usec) * 1e-6;
+    };
+    return toSeconds(usage.ru_utime) + toSeconds(usage.ru_stime);
+#endif
+}
+
+void CpuMeter::restart() {
+    wall_start_ = wallSeconds();
+    cpu_start_ = getProcessCpuSeconds();
+}
+
+double CpuMeter::getElapsedSeconds() const {
+    return wallSeconds() - wall_start_;
+}
+
+double CpuMeter::getUsagePercent() const {
+    const double elapsed = getElapsedSeconds();
+    if (elapsed <= 0.0) {
+        return 0.0;
+    }
+    return (getProcessCpuSeconds() - cpu_start_) / elapsed * 100.0;
+}
+
+} // namespace engine::utils
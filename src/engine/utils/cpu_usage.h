@@ -0,0 +1,34 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#ifndef SUNNYLAND_CPU_USAGE_H
+#define SUNNYLAND_CPU_USAGE_H
+
+namespace engine::utils {
+
+/**
+ * @brief 进程累计占用的 CPU 时间（用户态 + 内核态，所有线程之和，秒）。
+ */
+double getProcessCpuSeconds();
+
+/**
+ * @brief 统计一段时间内进程的 CPU 占用率：CPU 时间 / 真实时间，100% 表示占满一个核心。
+ *        用于对比暂停、菜单等静态画面下的空闲开销。
+ */
+class CpuMeter final {
+private:
+    double wall_start_ = 0.0;
+    double cpu_start_ = 0.0;
+
+public:
+    CpuMeter() { restart(); }
+
+    void restart();                                 ///< @brief 从现在开始重新统计
+    [[nodiscard]] double getElapsedSeconds() const; ///< @brief 自 restart() 以来的真实时间（秒）
+    [[nodiscard]] double getUsagePercent() const;   ///< @brief 自 restart() 以来的平均 CPU 占用率（%）
+};
+
+} // namespace engine::utils
+
+#endif //SUNNYLAND_CPU_USAGE_H
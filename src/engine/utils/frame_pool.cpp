@@ -0,0 +1,74 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#include "frame_pool.h"
+#include <bit>
+#include <new>
+
+namespace engine::utils {
+
+FramePool::~FramePool() {
+    for (auto& size_class : classes_) {
+        for (void* chunk : size_class.chunks) {
+            ::operator delete(chunk);
+        }
+    }
+}
+
+FramePool& FramePool::instance() {
+    static FramePool pool;
+    return pool;
+}
+
+std::size_t FramePool::classIndex(std::size_t size) {
+    const auto block = std::bit_ceil(size < MIN_BLOCK ? MIN_BLOCK : size);
+    return static_cast<std::size_t>(std::countr_zero(block) - std::countr_zero(MIN_BLOCK));
+}
+
+void FramePool::refill(std::size_t index) {
+    const std::size_t block_size = MIN_BLOCK << index;
+    auto* chunk = static_cast<std::byte*>(::operator new(block_size * BLOCKS_PER_CHUNK));
+    auto& size_class = classes_[index];
+    size_class.chunks.push_back(chunk);
+    for (std::size_t i = BLOCKS_PER_CHUNK; i-- > 0;) {
+        auto* block = reinterpret_cast<FreeBlock*>(chunk + i * block_size);
+        block->next = size_class.free_list;
+        size_class.free_list = block;
+    }
+    stats_.reserved_bytes += block_size * BLOCKS_PER_CHUNK;
+}
+
+void* FramePool::allocate(std::size_t size) {
+    if (size > MAX_BLOCK) {
+        ++stats_.oversized_live;
+        return ::operator new(size);
+    }
+    const auto index = classIndex(size);
+    auto& size_class = classes_[index];
+    if (!size_class.free_list) {
+        refill(index);
+    }
+    FreeBlock* block = size_class.free_list;
+    size_class.free_list = block->next;
+    ++stats_.live_blocks;
+    return block;
+}
+
+void FramePool::deallocate(void* pointer, std::size_t size) noexcept {
+    if (!pointer) {
+        return;
+    }
+    if (size > MAX_BLOCK) {
+        --stats_.oversized_live;
+        ::operator delete(pointer);
+        return;
+    }
+    auto& size_class = classes_[classIndex(size)];
+    auto* block = static_cast<FreeBlock*>(pointer);
+    block->next = size_class.free_list;
+    size_class.free_list = block;
+    --stats_.live_blocks;
+}
+
+} // namespace engine::utils
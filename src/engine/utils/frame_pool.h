@@ -0,0 +1,70 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#ifndef SUNNYLAND_FRAME_POOL_H
+#define SUNNYLAND_FRAME_POOL_H
+
+#include <array>        // 用于 std::array
+#include <cstddef>      // 用于 std::size_t
+#include <vector>       // 用于 std::vector
+
+namespace engine::utils {
+
+/**
+ * @brief 按大小分级的内存池，用于协程帧等频繁创建、销毁且大小固定的小对象。
+ *
+ * 64 ~ 4096 字节按 2 的幂分为 7 级，每级维护一条空闲链表，空了就一次分配 BLOCKS_PER_CHUNK 块；
+ * 释放的块回到链表，稳定运行后不再向系统申请内存。超过最大级别的请求直接使用 ::operator new。
+ * 内存只在进程退出时归还。只能在主线程使用。
+ */
+class FramePool final {
+public:
+    static constexpr std::size_t MIN_BLOCK = 64;
+    static constexpr std::size_t MAX_BLOCK = 4096;
+    static constexpr std::size_t CLASS_COUNT = 7;           ///< @brief 64, 128, ..., 4096
+    static constexpr std::size_t BLOCKS_PER_CHUNK = 32;
+
+    struct Stats {
+        std::size_t live_blocks = 0;        ///< @brief 正在使用的池内块数
+        std::size_t reserved_bytes = 0;     ///< @brief 已向系统申请的池内存
+        std::size_t oversized_live = 0;     ///< @brief 正在使用的超大块（未经过池）
+    };
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    struct SizeClass {
+        FreeBlock* free_list = nullptr;
+        std::vector<void*> chunks;
+    };
+
+    std::array<SizeClass, CLASS_COUNT> classes_{};
+    Stats stats_;
+
+public:
+    FramePool() = default;
+    ~FramePool();
+
+    FramePool(const FramePool&) = delete;
+    FramePool& operator=(const FramePool&) = delete;
+    FramePool(FramePool&&) = delete;
+    FramePool& operator=(FramePool&&) = delete;
+
+    void* allocate(std::size_t size);
+    void deallocate(void* pointer, std::size_t size) noexcept;     ///< @brief size 必须与分配时相同
+
+    [[nodiscard]] const Stats& getStats() const { return stats_; }
+
+    static FramePool& instance();       ///< @brief 协程帧共用的全局池
+
+private:
+    static std::size_t classIndex(std::size_t size);
+    void refill(std::size_t index);
+};
+
+} // namespace engine::utils
+
+#endif //SUNNYLAND_FRAME_POOL_H
@@ -0,0 +1,85 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#include "log.h"
+#include <spdlog/async.h>
+#include <spdlog/sinks/basic_file_sink.h>
+#include <spdlog/sinks/dup_filter_sink.h>
+#include <spdlog/sinks/stdout_color_sinks.h>
+#include <vector>
+
+namespace engine::utils {
+
+namespace {
+
+constexpr const char* LOGGER_NAME = "sunnyland";
+
+std::shared_ptr<spdlog::logger> makeConsoleLogger(spdlog::level::level_enum level) {
+    auto logger = std::make_shared<spdlog::logger>(LOGGER_NAME, std::make_shared<spdlog::sinks::stdout_color_sink_mt>());
+    logger->set_level(level);
+    return logger;
+}
+
+} // namespace
+
+void Log::init(const Settings& settings) {
+    std::vector<spdlog::sink_ptr> sinks;
+    if (settings.console) {
+        sinks.push_back(std::make_shared<spdlog::sinks::stdout_color_sink_mt>());
+    }
+    if (!settings.file_path.empty()) {
+        try {
+            sinks.push_back(std::make_shared<spdlog::sinks::basic_file_sink_mt>(settings.file_path, true));
+        } catch (const spdlog::spdlog_ex& e) {
+            spdlog::error("无法打开日志文件 '{}': {}", settings.file_path, e.what());
+        }
+    }
+    // 合并连续重复的消息：在后台线程进行，不增加调用线程的开销
+    if (settings.duplicate_window_ms > 0) {
+        auto dup_filter = std::make_shared<spdlog::sinks::dup_filter_sink_mt>(std::chrono::milliseconds(settings.duplicate_window_ms));
+        dup_filter->set_sinks(std::move(sinks));
+        sinks = {dup_filter};
+    }
+
+    // 单个后台线程；队列满时覆盖最旧的消息（overrun_oldest），游戏线程永远不会因日志阻塞
+    spdlog::init_thread_pool(settings.queue_size, 1);
+    auto logger = std::make_shared<spdlog::async_logger>(LOGGER_NAME, sinks.begin(), sinks.end(), spdlog::thread_pool(),
+                                                         spdlog::async_overflow_policy::overrun_oldest);
+    logger->set_level(settings.level);
+    logger->flush_on(spdlog::level::err);
+    spdlog::set_default_logger(std::move(logger));
+    spdlog::flush_every(std::chrono::seconds(1));
+
+    if (settings.level < SPDLOG_ACTIVE_LEVEL) {
+        spdlog::info("运行期日志级别低于编译期级别 {}，更低级别的 SPDLOG_TRACE/SPDLOG_DEBUG 已在编译时移除。",
+                     spdlog::level::to_string_view(static_cast<spdlog::level::level_enum>(SPDLOG_ACTIVE_LEVEL)));
+    }
+}
+
+void Log::init() {
+    init(Settings{});
+}
+
+void Log::shutdown() {
+    auto logger = std::dynamic_pointer_cast<spdlog::async_logger>(spdlog::default_logger());
+    if (!logger) {
+        return;
+    }
+    const auto dropped = getDroppedCount();
+    const auto level = logger->level();
+    // 先换回同步 logger，再释放线程池：线程池析构时会处理完队列中剩余的消息再退出
+    spdlog::set_default_logger(makeConsoleLogger(level));
+    logger.reset();
+    spdlog::details::registry::instance().set_tp(nullptr);
+    if (dropped > 0) {
+        spdlog::warn("日志队列溢出，共丢弃 {} 条消息。", dropped);
+    }
+}
+
+std::size_t Log::getDroppedCount() {
+    auto pool = spdlog::thread_pool();
+    return pool ? pool->overrun_counter() : 0;
+}
+
+} // namespace engine::utils
@@ -0,0 +1,93 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#ifndef SUNNYLAND_LOG_H
+#define SUNNYLAND_LOG_H
+
+#include <atomic>       // 用于 std::atomic
+#include <chrono>       // 用于 std::chrono::steady_clock
+#include <cstddef>      // 用于 std::size_t
+#include <cstdint>      // 用于 std::uint32_t
+#include <string>       // 用于 std::string
+#include <spdlog/spdlog.h>
+
+namespace engine::utils {
+
+/**
+ * @brief 引擎日志的初始化与关闭。
+ *
+ * init() 把 spdlog 的默认 logger 换成异步 logger：调用线程只格式化消息并放入固定大小的环形队列，
+ * 写控制台/文件在后台线程进行；队列满时丢弃最旧的消息，而不是阻塞游戏线程。
+ * 因此现有的 spdlog::info/warn/error 调用无需修改即走异步路径。
+ *
+ * trace/debug 日志使用 SPDLOG_TRACE/SPDLOG_DEBUG 宏：低于编译期 SPDLOG_ACTIVE_LEVEL 的调用（Release 构建中的
+ * trace/debug，见 CMakeLists.txt）连同参数求值一起被移除。
+ * 可能每帧触发的日志使用 SUNNYLAND_LOG_EVERY 按调用点限流。
+ */
+class Log final {
+public:
+    struct Settings {
+        spdlog::level::level_enum level = spdlog::level::debug;     ///< @brief 运行期日志级别（不能低于编译期级别）
+        std::size_t queue_size = 8192;          ///< @brief 异步队列容量（条）
+        std::string file_path;                  ///< @brief 非空时同时写入该文件
+        bool console = true;                    ///< @brief 输出到控制台
+        int duplicate_window_ms = 1000;         ///< @brief 在此时间内与上一条完全相同的消息被合并，0 表示不合并
+    };
+
+    Log() = delete;
+
+    static void init(const Settings& settings);
+    static void init();
+    static void shutdown();     ///< @brief 写出队列中剩余的消息并停止后台线程，之后的日志回到同步控制台输出
+    [[nodiscard]] static std::size_t getDroppedCount();     ///< @brief 因队列满被丢弃的消息数
+};
+
+/**
+ * @brief 调用点级别的日志限流：interval 内只放行一次，并统计被抑制的次数。线程安全。
+ */
+class LogRateLimiter final {
+private:
+    const std::int64_t interval_ns_;
+    std::atomic<std::int64_t> next_allowed_ns_{0};
+    std::atomic<std::uint32_t> suppressed_{0};
+
+public:
+    explicit LogRateLimiter(int interval_ms) : interval_ns_(static_cast<std::int64_t>(interval_ms) * 1'000'000) {}
+
+    /**
+     * @brief 是否放行本次日志。
+     * @param suppressed 放行时返回自上次放行以来被抑制的次数。
+     */
+    bool allow(std::uint32_t& suppressed) {
+        const auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        auto next = next_allowed_ns_.load(std::memory_order_relaxed);
+        if (now < next || !next_allowed_ns_.compare_exchange_strong(next, now + interval_ns_, std::memory_order_relaxed)) {
+            suppressed_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        suppressed = suppressed_.exchange(0, std::memory_order_relaxed);
+        return true;
+    }
+};
+
+} // namespace engine::utils
+
+/**
+ * @brief 限流日志：同一调用点每 interval_ms 毫秒最多输出一次，被抑制的调用不格式化参数，
+ *        下次输出时附带被抑制的次数。level 为 spdlog::level::warn 等。
+ */
+#define SUNNYLAND_LOG_EVERY(level, interval_ms, ...)                                                        \
+    do {                                                                                                    \
+        static ::engine::utils::LogRateLimiter sunnyland_log_limiter_{interval_ms};                         \
+        std::uint32_t sunnyland_log_suppressed_ = 0;                                                        \
+        if (::spdlog::should_log(level) && sunnyland_log_limiter_.allow(sunnyland_log_suppressed_)) {       \
+            ::spdlog::log(level, __VA_ARGS__);                                                              \
+            if (sunnyland_log_suppressed_ > 0) {                                                            \
+                ::spdlog::log(level, "（此前该处日志被限流 {} 次）", sunnyland_log_suppressed_);             \
+            }                                                                                               \
+        }                                                                                                   \
+    } while (false)
+
+#endif //SUNNYLAND_LOG_H
@@ -0,0 +1,22 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#ifndef SUNNYLAND_MATH_H
+#define SUNNYLAND_MATH_H
+
+#include <glm/glm.hpp>
+
+namespace engine::utils {
+
+/**
+ * @brief 轴对齐矩形，position 为左上角，size 为宽高。
+ */
+struct Rect {
+    glm::vec2 position{0.0f};
+    glm::vec2 size{0.0f};
+};
+
+} // namespace engine::utils
+
+#endif //SUNNYLAND_MATH_H
@@ -0,0 +1,143 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#include "metrics.h"
+
+#ifdef SUNNYLAND_TRACK_ALLOCATIONS
+#include <cstdlib>
+#include <new>
+#endif
+
+namespace engine::utils {
+
+namespace {
+
+constexpr std::array<const char*, METRIC_COUNT> METRIC_NAMES = {
+    "draw_calls",
+    "texture_cache_hits",
+    "texture_cache_misses",
+    "font_cache_hits",
+    "font_cache_misses",
+    "audio_cache_hits",
+    "audio_cache_misses",
+    "audio_load_us",
+    "baked_audio_loads",
+    "events_dispatched",
+    "events_dropped",
+    "quality_changes",
+    "coroutine_resumes",
+    "textures_created",
+    "textures_destroyed",
+    "texture_bytes_created",
+    "texture_bytes_destroyed",
+    "allocations",
+    "allocated_bytes",
+};
+
+} // namespace
+
+const char* Metrics::getName(Metric metric) {
+    return METRIC_NAMES[static_cast<std::size_t>(metric)];
+}
+
+bool Metrics::isAllocationTrackingEnabled() {
+#ifdef SUNNYLAND_TRACK_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+} // namespace engine::utils
+
+#ifdef SUNNYLAND_TRACK_ALLOCATIONS
+
+// --- 替换全局 operator new/delete，统计分配次数和字节数 ---
+// 只在分配时累加两个 relaxed 原子量；释放不计数，直接转给 free。
+
+namespace {
+
+void* trackedAlloc(std::size_t size) {
+    engine::utils::Metrics::add(engine::utils::Metric::Allocations);
+    engine::utils::Metrics::add(engine::utils::Metric::AllocatedBytes, size);
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void* trackedAlignedAlloc(std::size_t size, std::align_val_t alignment) {
+    engine::utils::Metrics::add(engine::utils::Metric::Allocations);
+    engine::utils::Metrics::add(engine::utils::Metric::AllocatedBytes, size);
+    const auto align = static_cast<std::size_t>(alignment);
+#ifdef _WIN32
+    return _aligned_malloc(size == 0 ? 1 : size, align);
+#else
+    // aligned_alloc 要求大小是对齐值的整数倍
+    const std::size_t rounded = ((size == 0 ? 1 : size) + align - 1) / align * align;
+    return std::aligned_alloc(align, rounded);
+#endif
+}
+
+void trackedAlignedFree(void* ptr) {
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    if (void* ptr = trackedAlloc(size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    if (void* ptr = trackedAlloc(size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return trackedAlloc(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return trackedAlloc(size); }
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    if (void* ptr = trackedAlignedAlloc(size, alignment)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    if (void* ptr = trackedAlignedAlloc(size, alignment)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return trackedAlignedAlloc(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return trackedAlignedAlloc(size, alignment);
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::align_val_t) noexcept { trackedAlignedFree(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { trackedAlignedFree(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { trackedAlignedFree(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { trackedAlignedFree(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { trackedAlignedFree(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { trackedAlignedFree(ptr); }
+
+#endif // SUNNYLAND_TRACK_ALLOCATIONS
@@ -0,0 +1,98 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#ifndef SUNNYLAND_METRICS_H
+#define SUNNYLAND_METRICS_H
+
+#include <array>        // 用于 std::array
+#include <atomic>       // 用于 std::atomic
+#include <cstddef>      // 用于 std::size_t
+#include <cstdint>      // 用于 std::uint64_t
+
+namespace engine::utils {
+
+/**
+ * @brief 全局计数器。新增计数器时在 Count 之前添加一项，并在 metrics.cpp 的名称表中补上名称。
+ */
+enum class Metric : std::uint8_t {
+    DrawCalls,
+    TextureCacheHits,
+    TextureCacheMisses,
+    FontCacheHits,
+    FontCacheMisses,
+    AudioCacheHits,
+    AudioCacheMisses,
+    AudioLoadMicros,        ///< @brief 音效载入累计耗时（微秒）
+    BakedAudioLoads,        ///< @brief 从 .slpcm 载入的音效数
+    EventsDispatched,       ///< @brief EventBus 分发的事件数
+    EventsDropped,          ///< @brief 跨线程发布时因队列已满（或未启用）被丢弃的事件数
+    QualityChanges,         ///< @brief FrameGovernor 调整画质档位的次数
+    CoroutineResumes,       ///< @brief CoroutineScheduler 恢复协程的次数
+    TexturesCreated,        ///< @brief TextureManager 创建的 SDL 纹理数，减去 TexturesDestroyed 即当前存活数
+    TexturesDestroyed,
+    TextureBytesCreated,    ///< @brief 按每像素 4 字节估算的纹理显存
+    TextureBytesDestroyed,
+    Allocations,
+    AllocatedBytes,
+    Count
+};
+
+inline constexpr std::size_t METRIC_COUNT = static_cast<std::size_t>(Metric::Count);
+
+/**
+ * @brief 某一时刻所有计数器的值，两次快照相减即得到这段时间内的增量。
+ */
+struct MetricsSnapshot {
+    std::array<std::uint64_t, METRIC_COUNT> values{};
+
+    [[nodiscard]] std::uint64_t operator[](Metric metric) const { return values[static_cast<std::size_t>(metric)]; }
+};
+
+/**
+ * @brief 单个计数器，独占一条缓存行。
+ */
+struct alignas(64) MetricCounter {
+    std::atomic<std::uint64_t> value{0};
+};
+
+/**
+ * @brief 中央性能计数器注册表，任何子系统、任何线程都可以直接累加。
+ *
+ * 计数器是单调递增的 64 位原子量，累加使用 relaxed 内存序（一条 lock add 指令），
+ * 每个计数器独占一条缓存行，避免不同线程累加不同计数器时互相干扰。
+ * 读取方（性能面板）每帧取一次快照，自己计算每帧增量和命中率。
+ * 存储是常量初始化的静态数组，在全局 operator new 中使用也是安全的。
+ */
+class Metrics final {
+private:
+    static inline std::array<MetricCounter, METRIC_COUNT> counters_{};
+
+public:
+    Metrics() = delete;
+
+    static void add(Metric metric, std::uint64_t amount = 1) {
+        counters_[static_cast<std::size_t>(metric)].value.fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] static std::uint64_t get(Metric metric) {
+        return counters_[static_cast<std::size_t>(metric)].value.load(std::memory_order_relaxed);
+    }
+
+    static void snapshot(MetricsSnapshot& out) {
+        for (std::size_t i = 0; i < METRIC_COUNT; ++i) {
+            out.values[i] = counters_[i].value.load(std::memory_order_relaxed);
+        }
+    }
+
+    [[nodiscard]] static const char* getName(Metric metric);
+
+    /**
+     * @brief 是否编译了全局 operator new 的分配统计（CMake 选项 SUNNYLAND_TRACK_ALLOCATIONS）。
+     */
+    [[nodiscard]] static bool isAllocationTrackingEnabled();
+};
+
+} // namespace engine::utils
+
+#endif //SUNNYLAND_METRICS_H
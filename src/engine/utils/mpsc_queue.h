@@ -0,0 +1,90 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#ifndef SUNNYLAND_MPSC_QUEUE_H
+#define SUNNYLAND_MPSC_QUEUE_H
+
+#include <atomic>       // 用于 std::atomic
+#include <bit>          // 用于 std::bit_ceil
+#include <cstddef>      // 用于 std::size_t
+#include <cstdint>      // 用于 std::intptr_t
+#include <memory>       // 用于 std::unique_ptr
+#include <type_traits>  // 用于 std::is_trivially_copyable_v
+
+namespace engine::utils {
+
+/**
+ * @brief 有界无锁多生产者单消费者队列（Vyukov 环形队列）。
+ *
+ * 容量在构造时确定（向上取整为 2 的幂），之后不再分配内存。
+ * tryPush() 可在任意线程调用，队列满时立即返回 false 而不是等待；tryPop() 只能由一个线程调用。
+ * 每个槽位带一个序号，生产者用 CAS 抢占写入位置，写完后发布序号，消费者据此判断槽位是否可读。
+ */
+template <typename T>
+class MpscQueue final {
+    static_assert(std::is_trivially_copyable_v<T>, "MpscQueue 只保存可平凡拷贝的类型");
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> sequence{0};
+        T value{};
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    std::size_t mask_;
+    alignas(64) std::atomic<std::size_t> tail_{0};      ///< @brief 生产者的写入位置
+    alignas(64) std::size_t head_ = 0;                  ///< @brief 消费者的读取位置，只由消费者线程访问
+
+public:
+    explicit MpscQueue(std::size_t capacity)
+        : cells_(std::make_unique<Cell[]>(std::bit_ceil(capacity < 2 ? std::size_t{2} : capacity))),
+          mask_(std::bit_ceil(capacity < 2 ? std::size_t{2} : capacity) - 1) {
+        for (std::size_t i = 0; i <= mask_; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+    MpscQueue(MpscQueue&&) = delete;
+    MpscQueue& operator=(MpscQueue&&) = delete;
+
+    bool tryPush(const T& value) {
+        auto position = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[position & mask_];
+            const auto sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    cell.value = value;
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;   // 队列已满
+            } else {
+                position = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool tryPop(T& out) {
+        Cell& cell = cells_[head_ & mask_];
+        const auto sequence = cell.sequence.load(std::memory_order_acquire);
+        if (static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(head_ + 1) < 0) {
+            return false;       // 队列为空，或生产者尚未写完
+        }
+        out = cell.value;
+        cell.sequence.store(head_ + mask_ + 1, std::memory_order_release);
+        ++head_;
+        return true;
+    }
+
+    [[nodiscard]] std::size_t capacity() const { return mask_ + 1; }
+};
+
+} // namespace engine::utils
+
+#endif //SUNNYLAND_MPSC_QUEUE_H
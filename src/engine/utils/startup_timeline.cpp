@@ -0,0 +1,115 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#include "startup_timeline.h"
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <spdlog/spdlog.h>
+
+namespace engine::utils {
+
+namespace {
+
+constexpr int BAR_WIDTH = 40;
+
+struct Span {
+    const char* name = "";
+    std::int64_t begin_ns = 0;
+    std::int64_t end_ns = -1;       ///< @brief -1 表示尚未结束
+    std::size_t thread = 0;         ///< @brief 线程首次出现的顺序，0 为最先记录的线程（主线程）
+};
+
+struct State {
+    std::mutex mutex;
+    std::vector<Span> spans;
+    std::vector<std::thread::id> threads;
+};
+
+// 静态初始化时取起点，近似进程启动时间
+const auto ORIGIN = std::chrono::steady_clock::now();
+
+State& state() {
+    static State instance;
+    return instance;
+}
+
+std::int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - ORIGIN).count();
+}
+
+std::size_t threadIndex(State& s) {
+    const auto id = std::this_thread::get_id();
+    const auto it = std::ranges::find(s.threads, id);
+    if (it != s.threads.end()) {
+        return static_cast<std::size_t>(it - s.threads.begin());
+    }
+    s.threads.push_back(id);
+    return s.threads.size() - 1;
+}
+
+} // namespace
+
+std::size_t StartupTimeline::begin(const char* name) {
+    const auto now = nowNs();
+    auto& s = state();
+    std::lock_guard lock(s.mutex);
+    s.spans.push_back({name, now, -1, threadIndex(s)});
+    return s.spans.size() - 1;
+}
+
+void StartupTimeline::end(std::size_t id) {
+    const auto now = nowNs();
+    auto& s = state();
+    std::lock_guard lock(s.mutex);
+    if (id < s.spans.size()) {
+        s.spans[id].end_ns = now;
+    }
+}
+
+void StartupTimeline::mark(const char* name) {
+    const auto now = nowNs();
+    auto& s = state();
+    std::lock_guard lock(s.mutex);
+    s.spans.push_back({name, now, now, threadIndex(s)});
+}
+
+double StartupTimeline::getElapsedMs() {
+    return static_cast<double>(nowNs()) / 1'000'000.0;
+}
+
+void StartupTimeline::report() {
+    auto& s = state();
+    std::vector<Span> spans;
+    {
+        std::lock_guard lock(s.mutex);
+        spans = s.spans;
+    }
+    const auto now = nowNs();
+    std::int64_t total = 1;
+    for (auto& span : spans) {
+        if (span.end_ns < 0) {
+            span.end_ns = now;      // 仍在进行的段按当前时间显示
+        }
+        total = std::max(total, span.end_ns);
+    }
+    std::ranges::stable_sort(spans, {}, &Span::begin_ns);
+
+    spdlog::info("启动时间线（自进程启动，共 {:.1f} ms）:", static_cast<double>(total) / 1'000'000.0);
+    std::string bar;
+    for (const auto& span : spans) {
+        const auto first = static_cast<int>(span.begin_ns * BAR_WIDTH / total);
+        const auto last = std::max(first + 1, static_cast<int>(span.end_ns * BAR_WIDTH / total));
+        bar.assign(BAR_WIDTH, '.');
+        std::fill(bar.begin() + first, bar.begin() + std::min(last, BAR_WIDTH), span.begin_ns == span.end_ns ? '|' : '#');
+        spdlog::info("  [{}] {} {:8.1f} -> {:8.1f} ms ({:7.1f} ms)  线程 {}  {}", bar, span.begin_ns == span.end_ns ? "*" : " ",
+                     static_cast<double>(span.begin_ns) / 1'000'000.0, static_cast<double>(span.end_ns) / 1'000'000.0,
+                     static_cast<double>(span.end_ns - span.begin_ns) / 1'000'000.0, span.thread, span.name);
+    }
+}
+
+} // namespace engine::utils
@@ -0,0 +1,49 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+
+#ifndef SUNNYLAND_STARTUP_TIMELINE_H
+#define SUNNYLAND_STARTUP_TIMELINE_H
+
+#include <cstddef>      // 用于 std::size_t
+#include <cstdint>      // 用于 std::int64_t
+
+namespace engine::utils {
+
+/**
+ * @brief 启动时间线：记录启动期间各子系统初始化的起止时间（相对进程启动），用于跟踪首帧时间。
+ *
+ * 任何线程都可以记录（内部加锁，只在启动期使用，开销可以忽略）。
+ * report() 按开始时间输出每一段的线程、起止时间和一条文字进度条。
+ */
+class StartupTimeline final {
+public:
+    StartupTimeline() = delete;
+
+    static std::size_t begin(const char* name);     ///< @brief 开始一段，name 必须是字符串字面量
+    static void end(std::size_t id);
+    static void mark(const char* name);             ///< @brief 记录一个时间点（如首帧）
+    static void report();                           ///< @brief 输出时间线（info 级别）
+    [[nodiscard]] static double getElapsedMs();     ///< @brief 距进程启动的毫秒数
+};
+
+/**
+ * @brief 作用域内的一段时间线。
+ */
+class StartupSpan final {
+private:
+    std::size_t id_;
+
+public:
+    explicit StartupSpan(const char* name) : id_(StartupTimeline::begin(name)) {}
+    ~StartupSpan() { StartupTimeline::end(id_); }
+
+    StartupSpan(const StartupSpan&) = delete;
+    StartupSpan& operator=(const StartupSpan&) = delete;
+    StartupSpan(StartupSpan&&) = delete;
+    StartupSpan& operator=(StartupSpan&&) = delete;
+};
+
+} // namespace engine::utils
+
+#endif //SUNNYLAND_STARTUP_TIMELINE_H
@@ -1,11 +1,14 @@
 ﻿#include "engine/core/game_app.h"
 
-#include <spdlog/spdlog.h>
+#include "engine/utils/log.h"
 
 int main() {
-    spdlog::set_level(spdlog::level::debug); // 设置日志级别为 trace，输出所有日志
-    engine::core::GameApp app;
-    app.run();
+    engine::utils::Log::init(); // 异步日志，运行期级别为 debug（Release 构建中 trace/debug 在编译期已移除）
+    {
+        engine::core::GameApp app;
+        app.run();
+    }
+    engine::utils::Log::shutdown(); // GameApp 析构时的日志也要写出
     return 0;
 
 }
\ No newline at end of file
@@ -0,0 +1,286 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+// 音效烘焙工具：把目录下的 wav/mp3/ogg 解码并转换为混音器输出格式，写入同名 .slpcm。
+// 运行时 AudioManager 发现未过期的 .slpcm 时用 MIX_LoadRawAudio 直接载入，不再解码；格式一致时混音线程也不再重采样。
+// 用法: audio_baker [目录=assets/audio] [--freq 48000] [--channels 2] [--format f32|s16] [--max-seconds 10] [--force]
+//                   [--bench [轮数=5]] [--headless]
+//   默认目标格式取自默认播放设备上创建的混音器（与游戏运行时相同），--freq/--channels/--format 可覆盖。
+//   超过 --max-seconds 的文件视为音乐，继续流式解码，不烘焙。
+//   --bench    对比源文件与 .slpcm 的载入耗时，以及所有音效同时循环播放时混音（MIX_Generate）占用的 CPU
+//   --headless 使用 dummy 音频驱动，适合在 CI 或无声卡环境下运行（此时默认格式为 dummy 驱动的格式）。
+
+#include "engine/resource/baked_audio.h"
+#include "engine/utils/binary_stream.h"
+#include <SDL3/SDL.h>
+#include <SDL3_mixer/SDL_mixer.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int GENERATE_FRAMES = 1024;       ///< @brief 每次 MIX_Generate 的帧数，接近常见的设备缓冲区大小
+constexpr double GENERATE_SECONDS = 10.0;   ///< @brief 混音基准生成的音频时长
+
+std::vector<std::string> findAudio(const std::string& root) {
+    std::vector<std::string> files;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(root, ec)) {
+        const auto extension = entry.path().extension();
+        if (entry.is_regular_file() && (extension == ".wav" || extension == ".mp3" || extension == ".ogg")) {
+            files.push_back(entry.path().generic_string());
+        }
+    }
+    std::ranges::sort(files);
+    return files;
+}
+
+double elapsedMs(Uint64 start, Uint64 end) {
+    return static_cast<double>(end - start) * 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+}
+
+struct LoadResult {
+    double total_ms = 0.0;      ///< @brief 所有音效一轮载入的平均耗时
+    double worst_ms = 0.0;
+    int failures = 0;
+};
+
+struct MixResult {
+    double generate_ms = 0.0;   ///< @brief 生成 GENERATE_SECONDS 秒音频的耗时
+    double cpu_percent = 0.0;   ///< @brief 相对实时播放的 CPU 占用
+};
+
+// 所有音效各占一条轨道循环播放，测量混音器生成音频的耗时
+MixResult benchMix(MIX_Mixer* mixer, const std::vector<MIX_Audio*>& audio, const SDL_AudioSpec& spec) {
+    std::vector<MIX_Track*> tracks;
+    const SDL_PropertiesID options = SDL_CreateProperties();
+    SDL_SetNumberProperty(options, MIX_PROP_PLAY_LOOPS_NUMBER, -1);
+    for (MIX_Audio* sound : audio) {
+        MIX_Track* track = MIX_CreateTrack(mixer);
+        if (track && MIX_SetTrackAudio(track, sound) && MIX_PlayTrack(track, options)) {
+            tracks.push_back(track);
+        } else if (track) {
+            MIX_DestroyTrack(track);
+        }
+    }
+    SDL_DestroyProperties(options);
+
+    const int frame_bytes = static_cast<int>(SDL_AUDIO_BYTESIZE(spec.format)) * spec.channels;
+    std::vector<std::byte> buffer(static_cast<std::size_t>(GENERATE_FRAMES * frame_bytes));
+    const auto chunks = static_cast<int>(GENERATE_SECONDS * spec.freq / GENERATE_FRAMES);
+    const Uint64 start = SDL_GetPerformanceCounter();
+    for (int i = 0; i < chunks; ++i) {
+        MIX_Generate(mixer, buffer.data(), static_cast<int>(buffer.size()));
+    }
+    const Uint64 end = SDL_GetPerformanceCounter();
+
+    for (MIX_Track* track : tracks) {
+        MIX_DestroyTrack(track);
+    }
+    MixResult result;
+    result.generate_ms = elapsedMs(start, end);
+    result.cpu_percent = result.generate_ms / (GENERATE_SECONDS * 1000.0) * 100.0;
+    return result;
+}
+
+template <typename LoadFn>
+LoadResult benchLoad(const std::vector<std::string>& files, int rounds, std::vector<MIX_Audio*>& loaded, LoadFn&& load) {
+    LoadResult result;
+    for (int round = 0; round < rounds; ++round) {
+        const bool keep = round == rounds - 1;      // 最后一轮载入的音频留给混音基准使用
+        for (std::size_t i = 0; i < files.size(); ++i) {
+            const Uint64 start = SDL_GetPerformanceCounter();
+            MIX_Audio* audio = load(i);
+            const double ms = elapsedMs(start, SDL_GetPerformanceCounter());
+            result.total_ms += ms;
+            result.worst_ms = std::max(result.worst_ms, ms);
+            if (!audio) {
+                ++result.failures;
+            } else if (keep) {
+                loaded.push_back(audio);
+            } else {
+                MIX_DestroyAudio(audio);
+            }
+        }
+    }
+    result.total_ms /= rounds;
+    result.failures /= rounds;
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string root = "assets/audio";
+    SDL_AudioSpec override_spec{};
+    double max_seconds = 10.0;
+    bool force = false;
+    bool headless = false;
+    int bench_rounds = 0;
+    for (int i = 1; i < argc; ++i) {
+        const bool has_value = i + 1 < argc;
+        if (std::strcmp(argv[i], "--freq") == 0 && has_value) {
+            override_spec.freq = std::stoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--channels") == 0 && has_value) {
+            override_spec.channels = std::stoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--format") == 0 && has_value) {
+            const std::string format = argv[++i];
+            if (format == "f32") {
+                override_spec.format = SDL_AUDIO_F32;
+            } else if (format == "s16") {
+                override_spec.format = SDL_AUDIO_S16;
+            } else {
+                spdlog::error("未知的采样格式 '{}'，可选 f32、s16。", format);
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--max-seconds") == 0 && has_value) {
+            max_seconds = std::stod(argv[++i]);
+        } else if (std::strcmp(argv[i], "--force") == 0) {
+            force = true;
+        } else if (std::strcmp(argv[i], "--headless") == 0) {
+            headless = true;
+        } else if (std::strcmp(argv[i], "--bench") == 0) {
+            bench_rounds = 5;
+            if (has_value && std::isdigit(static_cast<unsigned char>(argv[i + 1][0]))) {
+                bench_rounds = std::max(1, std::stoi(argv[++i]));
+            }
+        } else {
+            root = argv[i];
+        }
+    }
+
+    spdlog::set_level(spdlog::level::info);
+    if (headless) {
+        SDL_SetHint(SDL_HINT_AUDIO_DRIVER, "dummy");
+    }
+    if (!SDL_Init(SDL_INIT_AUDIO) || !MIX_Init()) {
+        spdlog::error("SDL 音频初始化失败! SDL错误: {}", SDL_GetError());
+        return 1;
+    }
+
+    // 与 AudioManager 相同的方式创建混音器，取其输出格式作为烘焙目标
+    SDL_AudioSpec target{};
+    if (MIX_Mixer* device_mixer = MIX_CreateMixerDevice(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, nullptr)) {
+        MIX_GetMixerFormat(device_mixer, &target);
+        MIX_DestroyMixer(device_mixer);
+    } else {
+        spdlog::warn("无法打开默认播放设备（{}），使用 F32 48000 Hz 立体声。", SDL_GetError());
+        target = {SDL_AUDIO_F32, 2, 48000};
+    }
+    if (override_spec.format != SDL_AUDIO_UNKNOWN) {
+        target.format = override_spec.format;
+    }
+    if (override_spec.channels > 0) {
+        target.channels = override_spec.channels;
+    }
+    if (override_spec.freq > 0) {
+        target.freq = override_spec.freq;
+    }
+    spdlog::info("目标格式: {} {} Hz {} 声道", SDL_GetAudioFormatName(target.format), target.freq, target.channels);
+
+    const auto files = findAudio(root);
+    if (files.empty()) {
+        spdlog::error("目录 '{}' 下没有找到音频文件。", root);
+        MIX_Quit();
+        SDL_Quit();
+        return 1;
+    }
+
+    // --- 烘焙 ---
+    int baked_count = 0, skipped = 0, streamed = 0, failed = 0;
+    std::vector<std::string> sources, baked_files;      // 已有有效 .slpcm 的音效，供基准测试使用
+    std::vector<std::byte> buffer;
+    for (const auto& file : files) {
+        const auto baked = engine::resource::getBakedAudioPath(file);
+        const bool current = engine::utils::readFileBytes(baked, buffer) &&
+                             engine::resource::isBakedAudioCurrent(buffer, file);
+        SDL_AudioSpec baked_spec{};
+        std::span<const std::byte> pcm;
+        const bool same_spec = current && engine::resource::readBakedAudio(buffer, baked_spec, pcm) &&
+                               baked_spec.format == target.format && baked_spec.channels == target.channels &&
+                               baked_spec.freq == target.freq;
+        if (!force && same_spec) {
+            ++skipped;
+            sources.push_back(file);
+            baked_files.push_back(baked);
+            continue;
+        }
+        engine::resource::AudioBakeResult result;
+        if (!engine::resource::bakeAudio(file, baked, target, max_seconds, &result)) {
+            if (result.seconds > max_seconds) {
+                ++streamed;
+                spdlog::info("{} 超过 {:.0f} 秒，作为音乐流式播放，不烘焙。", file, max_seconds);
+            } else {
+                ++failed;
+            }
+            continue;
+        }
+        ++baked_count;
+        sources.push_back(file);
+        baked_files.push_back(baked);
+        spdlog::info("{} ({} {} Hz {} 声道) -> {:.2f} 秒, {:.1f} KiB", baked,
+                     SDL_GetAudioFormatName(result.source_spec.format), result.source_spec.freq,
+                     result.source_spec.channels, result.seconds, static_cast<double>(result.data_size) / 1024.0);
+    }
+    spdlog::info("烘焙 {} 个，跳过未变化的 {} 个，音乐 {} 个，失败 {} 个。", baked_count, skipped, streamed, failed);
+
+    int exit_code = failed > 0 ? 1 : 0;
+    if (bench_rounds > 0 && !sources.empty()) {
+        // 内存混音器：不需要音频设备，输出格式与烘焙目标一致
+        MIX_Mixer* mixer = MIX_CreateMixer(&target);
+        if (!mixer) {
+            spdlog::error("创建内存混音器失败: {}", SDL_GetError());
+            exit_code = 1;
+        } else {
+            std::vector<MIX_Audio*> decoded_audio, baked_audio;
+            const auto decoded_load = benchLoad(sources, bench_rounds, decoded_audio, [&](std::size_t i) {
+                return MIX_LoadAudio(mixer, sources[i].c_str(), true);
+            });
+            // 与 AudioManager 相同：复用文件缓冲区，检查源文件时间戳
+            const auto baked_load = benchLoad(baked_files, bench_rounds, baked_audio, [&](std::size_t i) -> MIX_Audio* {
+                SDL_AudioSpec spec{};
+                std::span<const std::byte> pcm;
+                if (!engine::utils::readFileBytes(baked_files[i], buffer) ||
+                    !engine::resource::isBakedAudioCurrent(buffer, sources[i]) ||
+                    !engine::resource::readBakedAudio(buffer, spec, pcm)) {
+                    return nullptr;
+                }
+                return MIX_LoadRawAudio(mixer, pcm.data(), pcm.size(), &spec);
+            });
+            const auto decoded_mix = benchMix(mixer, decoded_audio, target);
+            const auto baked_mix = benchMix(mixer, baked_audio, target);
+
+            spdlog::info("音频驱动: {}  音效 {} 个  {} 轮（文件已在系统缓存中）",
+                         SDL_GetCurrentAudioDriver(), sources.size(), bench_rounds);
+            spdlog::info("源文件  载入 每轮 {:8.2f} ms  单个最长 {:7.3f} ms  混音 {:.0f} 秒耗时 {:8.2f} ms（CPU {:.2f}%）",
+                         decoded_load.total_ms, decoded_load.worst_ms, GENERATE_SECONDS, decoded_mix.generate_ms, decoded_mix.cpu_percent);
+            spdlog::info(".slpcm  载入 每轮 {:8.2f} ms  单个最长 {:7.3f} ms  混音 {:.0f} 秒耗时 {:8.2f} ms（CPU {:.2f}%）",
+                         baked_load.total_ms, baked_load.worst_ms, GENERATE_SECONDS, baked_mix.generate_ms, baked_mix.cpu_percent);
+            if (baked_load.total_ms > 0.0 && baked_mix.generate_ms > 0.0) {
+                spdlog::info("载入加速 {:.2f} 倍，混音加速 {:.2f} 倍", decoded_load.total_ms / baked_load.total_ms,
+                             decoded_mix.generate_ms / baked_mix.generate_ms);
+            }
+            if (decoded_load.failures > 0 || baked_load.failures > 0) {
+                spdlog::error("载入失败：源文件 {} 个，.slpcm {} 个。", decoded_load.failures, baked_load.failures);
+                exit_code = 1;
+            }
+
+            for (MIX_Audio* audio : decoded_audio) {
+                MIX_DestroyAudio(audio);
+            }
+            for (MIX_Audio* audio : baked_audio) {
+                MIX_DestroyAudio(audio);
+            }
+            MIX_DestroyMixer(mixer);
+        }
+    }
+
+    MIX_Quit();
+    SDL_Quit();
+    return exit_code;
+}
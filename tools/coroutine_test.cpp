@@ -0,0 +1,183 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+// 协程调度器测试：嵌套启动脚本时的取消、子协程抛出异常、等待事件与计时器，以及结束后协程帧全部归还内存池。
+// 用法: coroutine_test
+//   全部通过返回 0，否则输出失败的检查并返回 1。建议在 AddressSanitizer 构建下运行，销毁仍在执行的协程帧会被直接发现。
+
+#include "engine/core/coroutine.h"
+#include "engine/core/event_bus.h"
+#include "engine/utils/frame_pool.h"
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+using engine::core::CoroutineScheduler;
+using engine::core::EventBus;
+using engine::core::ScriptId;
+using engine::core::Task;
+
+int failures = 0;
+
+#define CHECK(condition)                                                          \
+    do {                                                                          \
+        if (!(condition)) {                                                       \
+            spdlog::error("{}:{} 检查失败: {}", __FILE__, __LINE__, #condition);   \
+            ++failures;                                                           \
+        }                                                                         \
+    } while (false)
+
+struct HitEvent {
+    int target = 0;
+    int amount = 0;
+};
+
+// 记录脚本执行到了哪一步
+std::vector<int> trace;
+
+Task cancelOwnerChild(CoroutineScheduler& scheduler, const void* owner) {
+    trace.push_back(2);
+    scheduler.cancelAll(owner);         // 取消仍在调用栈上的父脚本
+    trace.push_back(3);
+    co_await engine::core::nextFrame();
+    trace.push_back(-1);                // 自己也属于 owner，不应再被恢复
+}
+
+Task startingParent(CoroutineScheduler& scheduler, const void* owner) {
+    trace.push_back(1);
+    scheduler.start(cancelOwnerChild(scheduler, owner), owner);
+    trace.push_back(4);                 // 父脚本在本次恢复结束前继续执行，之后被销毁
+    co_await engine::core::nextFrame();
+    trace.push_back(-2);
+}
+
+void testNestedStartCancelAll() {
+    trace.clear();
+    EventBus event_bus;
+    CoroutineScheduler scheduler(event_bus);
+    const int owner = 0;
+    const auto parent = scheduler.start(startingParent(scheduler, &owner), &owner);
+    CHECK(parent == engine::core::INVALID_SCRIPT);
+    CHECK(scheduler.getScriptCount() == 0);
+    for (int i = 0; i < 3; ++i) {
+        scheduler.update(0.016f);
+    }
+    CHECK((trace == std::vector<int>{1, 2, 3, 4}));
+}
+
+ScriptId parent_id = engine::core::INVALID_SCRIPT;
+
+Task cancelParentChild(CoroutineScheduler& scheduler) {
+    scheduler.cancel(parent_id);
+    co_await engine::core::waitSeconds(0.1f);
+    trace.push_back(2);
+}
+
+Task parentByIdScript(CoroutineScheduler& scheduler) {
+    co_await engine::core::nextFrame();
+    scheduler.start(cancelParentChild(scheduler));
+    trace.push_back(1);
+    co_await engine::core::waitSeconds(0.05f);
+    trace.push_back(-1);
+}
+
+void testNestedStartCancelById() {
+    trace.clear();
+    EventBus event_bus;
+    CoroutineScheduler scheduler(event_bus);
+    parent_id = scheduler.start(parentByIdScript(scheduler));
+    CHECK(scheduler.isRunning(parent_id));
+    for (int i = 0; i < 20; ++i) {
+        scheduler.update(0.016f);
+    }
+    CHECK(!scheduler.isRunning(parent_id));
+    CHECK((trace == std::vector<int>{1, 2}));
+    CHECK(scheduler.getScriptCount() == 0);
+}
+
+Task throwingChild() {
+    co_await engine::core::nextFrame();
+    throw std::runtime_error("测试用异常");
+}
+
+Task parentOfThrowing() {
+    trace.push_back(1);
+    co_await throwingChild();
+    trace.push_back(-1);                // 子协程失败后父协程不应继续
+}
+
+void testChildException() {
+    trace.clear();
+    EventBus event_bus;
+    CoroutineScheduler scheduler(event_bus);
+    const auto script = scheduler.start(parentOfThrowing());
+    CHECK(scheduler.isRunning(script));
+    scheduler.update(0.016f);
+    CHECK(!scheduler.isRunning(script));
+    CHECK((trace == std::vector<int>{1}));
+}
+
+Task selfCancelling(CoroutineScheduler& scheduler, const ScriptId& self) {
+    co_await engine::core::nextFrame();
+    scheduler.cancel(self);
+    trace.push_back(1);
+    co_await engine::core::nextFrame();
+    trace.push_back(-1);
+}
+
+void testSelfCancel() {
+    trace.clear();
+    EventBus event_bus;
+    CoroutineScheduler scheduler(event_bus);
+    ScriptId self = engine::core::INVALID_SCRIPT;
+    self = scheduler.start(selfCancelling(scheduler, self));
+    for (int i = 0; i < 3; ++i) {
+        scheduler.update(0.016f);
+    }
+    CHECK(!scheduler.isRunning(self));
+    CHECK((trace == std::vector<int>{1}));
+}
+
+Task hitWaiter(int id, int& total) {
+    const auto hit = co_await engine::core::waitEvent<HitEvent>([id](const HitEvent& e) { return e.target == id; });
+    total += hit.amount;
+}
+
+void testEventWaitAndCancel() {
+    EventBus event_bus;
+    CoroutineScheduler scheduler(event_bus);
+    int total = 0;
+    const auto first = scheduler.start(hitWaiter(1, total));
+    const auto second = scheduler.start(hitWaiter(2, total));
+    CHECK(scheduler.cancel(second));
+    CHECK(!scheduler.cancel(second));   // 过期 ID 不再生效
+    event_bus.publish(HitEvent{2, 5});
+    event_bus.publish(HitEvent{1, 7});
+    event_bus.dispatch();
+    scheduler.update(0.016f);
+    CHECK(total == 7);
+    CHECK(!scheduler.isRunning(first));
+}
+
+} // namespace
+
+int main() {
+    testNestedStartCancelAll();
+    testNestedStartCancelById();
+    testChildException();
+    testSelfCancel();
+    testEventWaitAndCancel();
+
+    const auto& pool_stats = engine::utils::FramePool::instance().getStats();
+    CHECK(pool_stats.live_blocks == 0);
+    CHECK(pool_stats.oversized_live == 0);
+
+    if (failures > 0) {
+        spdlog::error("协程调度器测试：{} 项检查失败。", failures);
+        return 1;
+    }
+    spdlog::info("协程调度器测试全部通过。");
+    return 0;
+}
@@ -0,0 +1,713 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+// 压力关卡生成器：使用现有的 tileset.tsj / prop.tsj / actor.tsj 生成任意大小的 Tiled 地图（.tmj），
+// 用于测量引擎随地图尺寸和实体数量的扩展性（自带的三张地图只有约 91x29 个图块、17 个对象）。
+// 用法:
+//   level_generator <输出.tmj> [--width 1000] [--height 1000] [--objects 10000] [--image-layers 16] [--seed 1]
+//   level_generator --bench [--frames 600] [--csv 文件] [--keep] [--headless]
+//     --bench    依次生成从 91x29 到 2000x1000 的一组地图，逐个加载并运行，报告加载耗时、内存和帧时间曲线
+//     --csv      把每一帧的 update / render 耗时和驻留区域数写入 CSV，便于画图
+//     --keep     保留生成的地图和区域缓存（默认在 assets/maps/stress/ 下，结束后删除）
+//     --headless 使用 offscreen 视频驱动和软件渲染器，适合在 CI 或无显示环境下运行。
+
+#include "engine/navigation/navigation_grid.h"
+#include "engine/render/animation.h"
+#include "engine/render/camera.h"
+#include "engine/render/parallax_background.h"
+#include "engine/resource/resource_manager.h"
+#include "engine/scene/level_streamer.h"
+#include "engine/scene/tile_table.h"
+#include <SDL3/SDL.h>
+#include <SDL3_mixer/SDL_mixer.h>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+constexpr const char* MAP_DIR = "assets/maps";
+constexpr const char* STRESS_DIR = "assets/maps/stress";
+constexpr float FRAME_DELTA = 1.0f / 60.0f;
+constexpr float CAMERA_SPEED = 480.0f;      // 像素/秒，接近玩家奔跑速度
+constexpr int CURVE_BUCKETS = 10;
+
+struct GeneratorOptions {
+    int width = 1000;
+    int height = 1000;
+    int objects = 10000;
+    int image_layers = 16;
+    std::uint32_t seed = 1;
+};
+
+/**
+ * @brief 图块集中可作为对象放置的一个图块（prop / actor 都是单图集合，每个图块一张图片）。
+ */
+struct ObjectTile {
+    std::uint32_t gid = 0;
+    std::string name;
+    int width = 0;
+    int height = 0;
+};
+
+struct TilesetInfo {
+    std::string source;             // 相对输出地图的路径
+    std::uint32_t firstgid = 0;
+    std::uint32_t tile_count = 0;   // 最大图块 ID + 1（图集合中 ID 可以不连续）
+};
+
+std::string relativePath(const std::filesystem::path& target, const std::filesystem::path& base_dir) {
+    return std::filesystem::relative(target, base_dir).generic_string();
+}
+
+bool readJson(const std::filesystem::path& path, nlohmann::json& out) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        spdlog::error("无法打开文件: {}", path.string());
+        return false;
+    }
+    try {
+        file >> out;
+    } catch (const nlohmann::json::parse_error& e) {
+        spdlog::error("解析 '{}' 失败: {}", path.string(), e.what());
+        return false;
+    }
+    return true;
+}
+
+bool hasProperty(const nlohmann::json& tile, const char* name) {
+    for (const auto& property : tile.value("properties", nlohmann::json::array())) {
+        if (property.value("name", "") == name && property.value("value", false) == true) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::uint32_t tileCount(const nlohmann::json& tileset) {
+    std::uint32_t count = tileset.value("tilecount", 0u);
+    for (const auto& tile : tileset.value("tiles", nlohmann::json::array())) {
+        count = std::max(count, tile.value("id", 0u) + 1);
+    }
+    return count;
+}
+
+std::string stringProperty(const nlohmann::json& tile, const char* name) {
+    for (const auto& property : tile.value("properties", nlohmann::json::array())) {
+        if (property.value("name", "") == name && property.contains("value") && property["value"].is_string()) {
+            return property["value"].get<std::string>();
+        }
+    }
+    return {};
+}
+
+// 收集图集合中的图块；带动画的角色图片是整张精灵表，对象大小取图块的 width/height（单帧大小）
+void collectObjectTiles(const nlohmann::json& tileset, std::uint32_t firstgid, std::vector<ObjectTile>& out,
+                        ObjectTile* player = nullptr) {
+    for (const auto& tile : tileset.value("tiles", nlohmann::json::array())) {
+        if (!tile.contains("image")) {
+            continue;
+        }
+        ObjectTile object;
+        object.gid = firstgid + tile.value("id", 0u);
+        object.name = std::filesystem::path(tile.value("image", "")).stem().string();
+        object.name = object.name.substr(0, object.name.find('-'));     // eagle-attack -> eagle，与关卡中的命名一致
+        object.width = tile.value("width", tile.value("imagewidth", 16));
+        object.height = tile.value("height", tile.value("imageheight", 16));
+        if (stringProperty(tile, "tag") == "player") {
+            if (player) {
+                object.name = "player";
+                *player = std::move(object);
+            }
+            continue;
+        }
+        out.push_back(std::move(object));
+    }
+}
+
+/**
+ * @brief 生成地图：地形为随机游走的地面加悬空平台，对象落在地面上，图片层按视差因子从远到近排列。
+ */
+bool generateMap(const std::filesystem::path& output_path, const GeneratorOptions& options) {
+    const std::filesystem::path map_dir(MAP_DIR);
+    const std::filesystem::path output_dir = std::filesystem::absolute(output_path).parent_path();
+    std::filesystem::create_directories(output_dir);
+
+    nlohmann::json tileset_json, prop_json, actor_json;
+    if (!readJson(map_dir / "tileset.tsj", tileset_json) || !readJson(map_dir / "prop.tsj", prop_json) ||
+        !readJson(map_dir / "actor.tsj", actor_json)) {
+        return false;
+    }
+
+    // --- 图块集与 firstgid（与 level1 相同的顺序） ---
+    std::vector<TilesetInfo> tilesets;
+    std::uint32_t next_gid = 1;
+    const std::array<std::pair<const char*, const nlohmann::json*>, 3> sources = {{
+        {"tileset.tsj", &tileset_json}, {"prop.tsj", &prop_json}, {"actor.tsj", &actor_json}}};
+    for (const auto& [name, json] : sources) {
+        TilesetInfo info;
+        info.source = relativePath(std::filesystem::absolute(map_dir / name), output_dir);
+        info.firstgid = next_gid;
+        info.tile_count = tileCount(*json);
+        next_gid += info.tile_count;
+        tilesets.push_back(info);
+    }
+
+    // 地形图块：实心图块做地面，无属性的图块做背景装饰
+    std::vector<std::uint32_t> solid_gids, decor_gids;
+    std::vector<std::uint8_t> has_properties(tilesets[0].tile_count, 0);
+    for (const auto& tile : tileset_json.value("tiles", nlohmann::json::array())) {
+        const auto id = tile.value("id", 0u);
+        if (id < has_properties.size()) {
+            has_properties[id] = 1;
+        }
+        if (hasProperty(tile, "solid")) {
+            solid_gids.push_back(tilesets[0].firstgid + id);
+        }
+    }
+    for (std::uint32_t id = 0; id < has_properties.size(); ++id) {
+        if (!has_properties[id]) {
+            decor_gids.push_back(tilesets[0].firstgid + id);
+        }
+    }
+    if (solid_gids.empty() || decor_gids.empty()) {
+        spdlog::error("tileset.tsj 中没有可用的实心或装饰图块。");
+        return false;
+    }
+
+    std::vector<ObjectTile> props, actors;
+    collectObjectTiles(prop_json, tilesets[1].firstgid, props);
+    ObjectTile player;
+    collectObjectTiles(actor_json, tilesets[2].firstgid, actors, &player);
+
+    const int width = std::max(options.width, 16);
+    const int height = std::max(options.height, 16);
+    const int tile_w = tileset_json.value("tilewidth", 16);
+    const int tile_h = tileset_json.value("tileheight", 16);
+    std::mt19937 rng(options.seed);
+    const auto random = [&rng](int min, int max) { return std::uniform_int_distribution<int>(min, max)(rng); };
+
+    // --- 图块层 ---
+    std::vector<std::uint32_t> main_layer(static_cast<std::size_t>(width) * height, 0);
+    std::vector<std::uint32_t> back_layer(main_layer.size(), 0);
+    std::vector<int> ground(width);
+    const std::uint32_t surface_gid = solid_gids.front();
+    const std::uint32_t fill_gid = solid_gids.size() > 1 ? solid_gids[1] : surface_gid;
+    int level = height * 2 / 3;
+    for (int x = 0; x < width; ++x) {
+        if (x % 4 == 0) {
+            level = std::clamp(level + random(-1, 1), std::max(height / 3, 4), height - 2);
+        }
+        ground[x] = level;
+        for (int y = level; y < height; ++y) {
+            main_layer[static_cast<std::size_t>(y) * width + x] = y == level ? surface_gid : fill_gid;
+        }
+        for (int y = 0; y < level; ++y) {
+            if (random(0, 99) < 4) {
+                back_layer[static_cast<std::size_t>(y) * width + x] = decor_gids[random(0, static_cast<int>(decor_gids.size()) - 1)];
+            }
+        }
+    }
+    const int platform_count = width * height / 400;
+    for (int i = 0; i < platform_count; ++i) {
+        const int length = random(3, 8);
+        const int x0 = random(0, std::max(width - length, 0));
+        const int y = random(2, std::max(ground[x0] - 3, 2));
+        for (int x = x0; x < std::min(x0 + length, width) && y < ground[x] - 2; ++x) {
+            main_layer[static_cast<std::size_t>(y) * width + x] = surface_gid;
+        }
+    }
+
+    // --- 对象：玩家放在最左侧，其余七成为敌人和道具（带动画），三成为装饰物，底边落在地面上 ---
+    nlohmann::json objects = nlohmann::json::array();
+    const auto place = [&](const ObjectTile& tile, int x) {
+        const int column = std::clamp(x / tile_w, 0, width - 1);
+        objects.push_back({{"id", objects.size() + 1}, {"gid", tile.gid}, {"name", tile.name}, {"type", ""},
+                           {"x", x}, {"y", ground[column] * tile_h}, {"width", tile.width}, {"height", tile.height},
+                           {"rotation", 0}, {"visible", true}});
+    };
+    if (player.gid != 0 && options.objects > 0) {
+        place(player, 2 * tile_w);
+    }
+    while (static_cast<int>(objects.size()) < options.objects && !(actors.empty() && props.empty())) {
+        const bool is_actor = props.empty() || (!actors.empty() && random(0, 9) < 7);
+        const auto& tile = is_actor ? actors[random(0, static_cast<int>(actors.size()) - 1)]
+                                    : props[random(0, static_cast<int>(props.size()) - 1)];
+        place(tile, random(0, std::max(width * tile_w - tile.width, 0)));
+    }
+
+    // --- 图片层：在 far / mid 两张图之间交替，视差因子从 0.1 递增到 0.9 ---
+    nlohmann::json layers = nlohmann::json::array();
+    int layer_id = 1;
+    const std::filesystem::path layer_images[] = {"assets/textures/Layers/back.png", "assets/textures/Layers/middle.png"};
+    const glm::ivec2 layer_sizes[] = {{384, 240}, {176, 368}};
+    for (int i = 0; i < options.image_layers; ++i) {
+        const int kind = i % 2;
+        const float factor = options.image_layers > 1 ? 0.1f + 0.8f * static_cast<float>(i) / static_cast<float>(options.image_layers - 1) : 0.2f;
+        layers.push_back({{"id", layer_id++}, {"name", "image" + std::to_string(i)}, {"type", "imagelayer"},
+                          {"image", relativePath(std::filesystem::absolute(layer_images[kind]), output_dir)},
+                          {"imagewidth", layer_sizes[kind].x}, {"imageheight", layer_sizes[kind].y},
+                          {"offsetx", 0}, {"offsety", kind == 0 ? 0 : 96 + 8 * (i / 2)},
+                          {"parallaxx", factor}, {"repeatx", true}, {"opacity", 1}, {"visible", true}, {"x", 0}, {"y", 0}});
+    }
+    const std::array<std::pair<const char*, const std::vector<std::uint32_t>*>, 2> tile_layers = {{{"back", &back_layer}, {"main", &main_layer}}};
+    for (const auto& [name, data] : tile_layers) {
+        layers.push_back({{"id", layer_id++}, {"name", name}, {"type", "tilelayer"}, {"width", width}, {"height", height},
+                          {"data", *data}, {"opacity", 1}, {"visible", true}, {"x", 0}, {"y", 0}});
+    }
+    const auto object_count = objects.size();
+    layers.push_back({{"id", layer_id++}, {"name", "object"}, {"type", "objectgroup"}, {"draworder", "topdown"},
+                      {"objects", std::move(objects)}, {"opacity", 1}, {"visible", true}, {"x", 0}, {"y", 0}});
+
+    nlohmann::json tileset_refs = nlohmann::json::array();
+    for (const auto& info : tilesets) {
+        tileset_refs.push_back({{"firstgid", info.firstgid}, {"source", info.source}});
+    }
+    const nlohmann::json map = {
+        {"compressionlevel", -1}, {"width", width}, {"height", height}, {"infinite", false},
+        {"nextlayerid", layer_id}, {"nextobjectid", object_count + 1}, {"orientation", "orthogonal"},
+        {"renderorder", "right-down"}, {"tiledversion", "1.11.2"}, {"tilewidth", tile_w}, {"tileheight", tile_h},
+        {"type", "map"}, {"version", "1.10"}, {"tilesets", std::move(tileset_refs)}, {"layers", std::move(layers)}};
+
+    std::ofstream file(output_path, std::ios::binary);
+    if (!file.is_open()) {
+        spdlog::error("无法写入地图: {}", output_path.string());
+        return false;
+    }
+    file << map.dump();
+    spdlog::info("已生成 {}：{}x{} 图块，{} 个对象，{} 个图片层，{:.1f} MB",
+                 output_path.generic_string(), width, height, object_count, options.image_layers,
+                 static_cast<double>(std::filesystem::file_size(output_path)) / (1024.0 * 1024.0));
+    return true;
+}
+
+// ------------------------------ 基准测试 ------------------------------
+
+double elapsedMs(Uint64 start, Uint64 end) {
+    return static_cast<double>(end - start) * 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+}
+
+/**
+ * @brief 当前进程的常驻内存（MB），只在 Linux 上可用，其他平台返回 0。
+ */
+double residentMemoryMb() {
+    std::ifstream statm("/proc/self/statm");
+    std::uint64_t size_pages = 0;
+    std::uint64_t resident_pages = 0;
+    if (!(statm >> size_pages >> resident_pages)) {
+        return 0.0;
+    }
+    return static_cast<double>(resident_pages) * 4096.0 / (1024.0 * 1024.0);
+}
+
+struct Stats {
+    double average = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+};
+
+Stats summarize(std::vector<double> samples) {
+    Stats stats;
+    if (samples.empty()) {
+        return stats;
+    }
+    std::ranges::sort(samples);
+    for (double sample : samples) {
+        stats.average += sample;
+    }
+    stats.average /= static_cast<double>(samples.size());
+    stats.p99 = samples[samples.size() * 99 / 100];
+    stats.max = samples.back();
+    return stats;
+}
+
+struct BenchCase {
+    const char* name;
+    GeneratorOptions options;
+};
+
+struct BenchResult {
+    std::string name;
+    GeneratorOptions options;
+    double file_mb = 0.0;
+    double tile_table_ms = 0.0;
+    double navigation_ms = 0.0;
+    double parallax_ms = 0.0;
+    double stream_build_ms = 0.0;       ///< @brief 首次打开（构建区域缓存）
+    double stream_cached_ms = 0.0;      ///< @brief 再次打开（读取区域缓存）
+    double memory_loaded_mb = 0.0;      ///< @brief 加载完成后相对基线的常驻内存增量
+    double memory_peak_mb = 0.0;        ///< @brief 运行期间的峰值增量
+    Stats frame;
+    std::size_t peak_entities = 0;
+    std::array<double, CURVE_BUCKETS> curve{};
+};
+
+/**
+ * @brief 一个已流式加载的地图对象，带动画的对象持有一个 AnimationSystem 实例。
+ */
+struct Entity {
+    glm::vec2 position{0.0f};       ///< @brief 左上角
+    glm::vec2 size{0.0f};
+    std::uint32_t gid = 0;
+    engine::render::AnimationHandle animation = engine::render::INVALID_ANIMATION;
+};
+
+bool waitUntilReady(engine::scene::LevelStreamer& streamer, glm::vec2 focus) {
+    const Uint64 deadline = SDL_GetTicks() + 120'000;
+    while (!streamer.isReady()) {
+        if (SDL_GetTicks() > deadline) {
+            return false;
+        }
+        streamer.update(focus);
+        SDL_Delay(1);
+    }
+    return true;
+}
+
+bool runCase(SDL_Renderer* renderer, const BenchCase& bench_case, int frame_count, std::FILE* csv, BenchResult& result) {
+    const std::filesystem::path map_path = std::filesystem::path(STRESS_DIR) / (std::string(bench_case.name) + ".tmj");
+    if (!generateMap(map_path, bench_case.options)) {
+        return false;
+    }
+    const std::string map = map_path.generic_string();
+    result.name = bench_case.name;
+    result.options = bench_case.options;
+    result.file_mb = static_cast<double>(std::filesystem::file_size(map_path)) / (1024.0 * 1024.0);
+
+    const double baseline_mb = residentMemoryMb();
+    double peak_mb = baseline_mb;
+    {
+        engine::resource::ResourceManager resource_manager(renderer);
+        engine::render::AnimationLibrary animations;
+        engine::scene::TileTable tiles;
+        engine::navigation::NavigationGrid navigation;
+        engine::render::ParallaxBackground background;
+
+        Uint64 start = SDL_GetPerformanceCounter();
+        if (!tiles.compile(map, &animations)) {
+            return false;
+        }
+        result.tile_table_ms = elapsedMs(start, SDL_GetPerformanceCounter());
+
+        start = SDL_GetPerformanceCounter();
+        navigation.loadFromMap(map, tiles);
+        result.navigation_ms = elapsedMs(start, SDL_GetPerformanceCounter());
+
+        start = SDL_GetPerformanceCounter();
+        background.loadFromMap(map, resource_manager);
+        result.parallax_ms = elapsedMs(start, SDL_GetPerformanceCounter());
+
+        engine::scene::LevelStreamer streamer(resource_manager);
+        engine::render::AnimationSystem animation_system(animations, 4096);
+        engine::render::Camera camera(glm::vec2(1280.0f, 720.0f));
+        const glm::vec2 focus = camera.getCenter();
+
+        // 区域驻留时为其中的对象创建动画实例，卸载时销毁。必须在 open() 之前注册，否则启动时就驻留的区域不会触发回调
+        std::unordered_map<int, std::vector<Entity>> entities;
+        const auto region_key = [&streamer](glm::ivec2 coord) { return coord.y * streamer.getRegionCount().x + coord.x; };
+        std::size_t entity_count = 0;
+        streamer.setOnRegionLoaded([&](const engine::scene::StreamedRegion& region) {
+            auto& list = entities[region_key(region.coord)];
+            for (const auto& object : region.objects) {
+                if (object.gid == 0) {
+                    continue;
+                }
+                Entity entity;
+                entity.position = {object.position.x, object.position.y - object.size.y};
+                entity.size = object.size;
+                entity.gid = object.gid;
+                const auto clip = tiles.getAnimation(object.gid);
+                if (clip != engine::scene::NO_ANIMATION) {
+                    entity.animation = animation_system.create(clip);
+                }
+                list.push_back(entity);
+            }
+            entity_count += list.size();
+        });
+        streamer.setOnRegionUnloaded([&](const engine::scene::StreamedRegion& region) {
+            const auto it = entities.find(region_key(region.coord));
+            if (it == entities.end()) {
+                return;
+            }
+            for (const auto& entity : it->second) {
+                if (entity.animation != engine::render::INVALID_ANIMATION) {
+                    animation_system.destroy(entity.animation);
+                }
+            }
+            entity_count -= it->second.size();
+            entities.erase(it);
+        });
+
+        start = SDL_GetPerformanceCounter();
+        streamer.open(map);
+        if (!waitUntilReady(streamer, focus)) {
+            spdlog::error("等待区域缓存超时: {}", map);
+            return false;
+        }
+        result.stream_build_ms = elapsedMs(start, SDL_GetPerformanceCounter());
+        streamer.close();
+        start = SDL_GetPerformanceCounter();
+        streamer.open(map);
+        if (!waitUntilReady(streamer, focus)) {
+            return false;
+        }
+        result.stream_cached_ms = elapsedMs(start, SDL_GetPerformanceCounter());
+
+        result.memory_loaded_mb = residentMemoryMb() - baseline_mb;
+
+        // 相机以奔跑速度在地图上蛇形扫过，持续触发区域加载/卸载
+        const glm::ivec2 tile_size = streamer.getTileSize();
+        const glm::ivec2 map_size = streamer.getMapSize();
+        const glm::vec2 world_size = glm::vec2(map_size) * glm::vec2(tile_size);
+        const glm::vec2 viewport = camera.getViewportSize();
+        glm::vec2 position{0.0f, std::max(world_size.y * 2.0f / 3.0f - viewport.y, 0.0f)};
+        float direction = 1.0f;
+        const auto& texture_paths = tiles.getTexturePaths();
+        std::vector<SDL_Texture*> textures(texture_paths.size(), nullptr);
+        std::vector<std::uint8_t> resolved(texture_paths.size(), 0);
+        const auto texture = [&](std::uint32_t texture_id) {
+            if (!resolved[texture_id]) {
+                textures[texture_id] = resource_manager.getTexture(texture_paths[texture_id]);
+                resolved[texture_id] = 1;
+            }
+            return textures[texture_id];
+        };
+
+        std::vector<double> frame_ms;
+        frame_ms.reserve(frame_count);
+        for (int frame = 0; frame < frame_count; ++frame) {
+            position.x += direction * CAMERA_SPEED * FRAME_DELTA;
+            if (position.x < 0.0f || position.x + viewport.x > world_size.x) {
+                direction = -direction;
+                position.x = std::clamp(position.x, 0.0f, std::max(world_size.x - viewport.x, 0.0f));
+                position.y = position.y + viewport.y + viewport.y > world_size.y ? 0.0f : position.y + viewport.y;
+            }
+            camera.setPosition(position);
+
+            const Uint64 frame_start = SDL_GetPerformanceCounter();
+            streamer.update(camera.getCenter());
+            const auto view = camera.getViewRect();
+            for (auto& [key, list] : entities) {
+                for (const auto& entity : list) {
+                    if (entity.animation != engine::render::INVALID_ANIMATION) {
+                        animation_system.setVisible(entity.animation, view.intersects(entity.position.x, entity.position.y,
+                                                                                      entity.size.x, entity.size.y));
+                    }
+                }
+            }
+            animation_system.update(FRAME_DELTA);
+            const Uint64 update_end = SDL_GetPerformanceCounter();
+
+            std::ranges::fill(resolved, 0);     // 纹理可能随区域卸载，每帧重新解析（每种纹理一次）
+            SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+            SDL_RenderClear(renderer);
+            background.render(renderer, camera);
+            const auto range = camera.getVisibleTileRange(tile_size, map_size);
+            for (std::size_t layer = 0; layer < streamer.getLayerNames().size(); ++layer) {
+                for (int y = range.begin_y; y < range.end_y; ++y) {
+                    for (int x = range.begin_x; x < range.end_x; ++x) {
+                        const auto gid = streamer.getTile(layer, x, y);
+                        const auto texture_id = tiles.getTextureId(gid);
+                        if (texture_id == engine::scene::NO_TEXTURE) {
+                            continue;
+                        }
+                        const glm::vec2 screen = camera.worldToScreen(glm::vec2(x, y) * glm::vec2(tile_size));
+                        const SDL_FRect dst{screen.x, screen.y, static_cast<float>(tile_size.x), static_cast<float>(tile_size.y)};
+                        SDL_RenderTexture(renderer, texture(texture_id), &tiles.getSourceRect(gid), &dst);
+                    }
+                }
+            }
+            for (const auto& [key, list] : entities) {
+                for (const auto& entity : list) {
+                    if (!view.intersects(entity.position.x, entity.position.y, entity.size.x, entity.size.y)) {
+                        continue;
+                    }
+                    const auto texture_id = tiles.getTextureId(entity.gid);
+                    if (texture_id == engine::scene::NO_TEXTURE) {
+                        continue;
+                    }
+                    const SDL_FRect& source = entity.animation != engine::render::INVALID_ANIMATION
+                                                  ? animation_system.getSourceRect(entity.animation)
+                                                  : tiles.getSourceRect(entity.gid);
+                    const glm::vec2 screen = camera.worldToScreen(entity.position);
+                    const SDL_FRect dst{screen.x, screen.y, source.w, source.h};
+                    SDL_RenderTexture(renderer, texture(texture_id), &source, &dst);
+                }
+            }
+            SDL_RenderPresent(renderer);
+            const Uint64 frame_end = SDL_GetPerformanceCounter();
+
+            frame_ms.push_back(elapsedMs(frame_start, frame_end));
+            result.peak_entities = std::max(result.peak_entities, entity_count);
+            if (frame % 30 == 0) {
+                peak_mb = std::max(peak_mb, residentMemoryMb());
+            }
+            if (csv) {
+                std::fprintf(csv, "%s,%d,%d,%d,%.4f,%.4f,%zu,%zu\n", bench_case.name, map_size.x, map_size.y,
+                             frame, elapsedMs(frame_start, update_end), elapsedMs(update_end, frame_end),
+                             streamer.getResidentRegionCount(), entity_count);
+            }
+        }
+
+        // 帧时间曲线：按时间顺序分成 CURVE_BUCKETS 段取平均
+        for (int bucket = 0; bucket < CURVE_BUCKETS; ++bucket) {
+            const auto begin = frame_ms.size() * bucket / CURVE_BUCKETS;
+            const auto end = frame_ms.size() * (bucket + 1) / CURVE_BUCKETS;
+            double sum = 0.0;
+            for (auto i = begin; i < end; ++i) {
+                sum += frame_ms[i];
+            }
+            result.curve[bucket] = end > begin ? sum / static_cast<double>(end - begin) : 0.0;
+        }
+        result.frame = summarize(std::move(frame_ms));
+        peak_mb = std::max(peak_mb, residentMemoryMb());
+        streamer.close();
+    }
+    result.memory_peak_mb = peak_mb - baseline_mb;
+    return true;
+}
+
+void report(const BenchResult& result) {
+    const auto& o = result.options;
+    spdlog::info("== {}: {}x{} 图块, {} 个对象, {} 个图片层, 文件 {:.1f} MB ==", result.name, o.width, o.height, o.objects,
+                 o.image_layers, result.file_mb);
+    spdlog::info("  加载  图块表 {:.1f} ms  导航 {:.1f} ms  视差 {:.1f} ms  区域缓存 构建 {:.1f} ms / 读取 {:.1f} ms",
+                 result.tile_table_ms, result.navigation_ms, result.parallax_ms, result.stream_build_ms, result.stream_cached_ms);
+    spdlog::info("  内存  加载后 +{:.1f} MB  峰值 +{:.1f} MB  (驻留对象峰值 {})", result.memory_loaded_mb, result.memory_peak_mb,
+                 result.peak_entities);
+    spdlog::info("  帧    平均 {:.3f} ms  p99 {:.3f} ms  最大 {:.3f} ms", result.frame.average, result.frame.p99, result.frame.max);
+    std::string curve;
+    for (double ms : result.curve) {
+        curve += fmt::format(" {:.2f}", ms);
+    }
+    spdlog::info("  曲线 (ms, 每段 1/{} 帧):{}", CURVE_BUCKETS, curve);
+}
+
+int runBench(int frame_count, const char* csv_path, bool keep) {
+    const BenchCase cases[] = {
+        {"stress_tiny", {91, 29, 17, 2, 1}},
+        {"stress_small", {256, 64, 500, 4, 2}},
+        {"stress_medium", {512, 256, 2000, 8, 3}},
+        {"stress_large", {1000, 1000, 10000, 16, 4}},
+        {"stress_huge", {2000, 1000, 25000, 32, 5}},
+    };
+
+    SDL_Window* window = SDL_CreateWindow("level_generator", 1280, 720, 0);
+    SDL_Renderer* renderer = window ? SDL_CreateRenderer(window, nullptr) : nullptr;
+    if (!renderer) {
+        spdlog::error("无法创建窗口或渲染器! SDL错误: {}", SDL_GetError());
+        return 1;
+    }
+    SDL_SetRenderVSync(renderer, 0);
+
+    std::FILE* csv = csv_path ? std::fopen(csv_path, "w") : nullptr;
+    if (csv) {
+        std::fprintf(csv, "map,width,height,frame,update_ms,render_ms,resident_regions,entities\n");
+    }
+
+    std::vector<BenchResult> results;
+    for (const auto& bench_case : cases) {
+        BenchResult result;
+        if (!runCase(renderer, bench_case, frame_count, csv, result)) {
+            spdlog::error("基准测试 {} 失败。", bench_case.name);
+            break;
+        }
+        report(result);
+        results.push_back(std::move(result));
+    }
+
+    spdlog::info("== 汇总（渲染驱动: {}）==", SDL_GetRendererName(renderer));
+    spdlog::info("{:<14} {:>10} {:>8} {:>12} {:>10} {:>10} {:>10}", "地图", "图块数", "对象", "加载(ms)", "内存(MB)", "平均(ms)", "p99(ms)");
+    for (const auto& result : results) {
+        const double load_ms = result.tile_table_ms + result.navigation_ms + result.parallax_ms + result.stream_cached_ms;
+        spdlog::info("{:<14} {:>10} {:>8} {:>12.1f} {:>10.1f} {:>10.3f} {:>10.3f}", result.name,
+                     result.options.width * result.options.height, result.options.objects, load_ms, result.memory_peak_mb,
+                     result.frame.average, result.frame.p99);
+    }
+
+    if (csv) {
+        std::fclose(csv);
+        spdlog::info("逐帧数据已写入 {}", csv_path);
+    }
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroyWindow(window);
+
+    if (!keep) {
+        std::error_code error;
+        std::filesystem::remove_all(STRESS_DIR, error);
+    }
+    return results.size() == std::size(cases) ? 0 : 1;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    GeneratorOptions options;
+    std::string output;
+    bool bench = false;
+    bool headless = false;
+    bool keep = false;
+    int frame_count = 600;
+    const char* csv_path = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        const bool has_value = i + 1 < argc;
+        if (std::strcmp(argv[i], "--width") == 0 && has_value) {
+            options.width = std::stoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--height") == 0 && has_value) {
+            options.height = std::stoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--objects") == 0 && has_value) {
+            options.objects = std::max(0, std::stoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--image-layers") == 0 && has_value) {
+            options.image_layers = std::max(0, std::stoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--seed") == 0 && has_value) {
+            options.seed = static_cast<std::uint32_t>(std::stoul(argv[++i]));
+        } else if (std::strcmp(argv[i], "--frames") == 0 && has_value) {
+            frame_count = std::max(1, std::stoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--csv") == 0 && has_value) {
+            csv_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--bench") == 0) {
+            bench = true;
+        } else if (std::strcmp(argv[i], "--keep") == 0) {
+            keep = true;
+        } else if (std::strcmp(argv[i], "--headless") == 0) {
+            headless = true;
+        } else {
+            output = argv[i];
+        }
+    }
+
+    spdlog::set_level(spdlog::level::info);
+    if (!bench) {
+        if (output.empty()) {
+            spdlog::error("用法: level_generator <输出.tmj> [--width W] [--height H] [--objects N] [--image-layers N] [--seed S]");
+            spdlog::error("      level_generator --bench [--frames N] [--csv 文件] [--keep] [--headless]");
+            return 1;
+        }
+        return generateMap(output, options) ? 0 : 1;
+    }
+
+    if (headless) {
+        SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen");
+        SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+    }
+    SDL_SetHint(SDL_HINT_AUDIO_DRIVER, "dummy");
+    // AudioManager 在后台线程打开设备，音频子系统和 SDL_mixer 须先在主线程初始化
+    if (!SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) || !MIX_Init()) {
+        spdlog::error("SDL 初始化失败! SDL错误: {}", SDL_GetError());
+        return 1;
+    }
+    const int exit_code = runBench(frame_count, csv_path, keep);
+    MIX_Quit();
+    SDL_Quit();
+    return exit_code;
+}
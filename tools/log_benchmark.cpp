@@ -0,0 +1,119 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+// 日志基准测试：测量游戏线程上一次日志调用的耗时（纳秒），对比
+//   同步写文件（原来的默认行为）、异步队列（Log::init）、运行期被级别过滤、编译期移除、按调用点限流。
+// 用法: log_benchmark [每项调用次数=1000000]
+//   日志写入临时目录下的文件，结束时删除；本工具以默认的 SPDLOG_ACTIVE_LEVEL（info）编译，SPDLOG_TRACE 在编译期被移除。
+
+#include "engine/utils/log.h"
+#include <spdlog/sinks/basic_file_sink.h>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int BATCH = 100;      ///< @brief 每批调用数，按批计时以免计时本身的开销淹没结果
+
+struct Stats {
+    double average = 0.0;
+    double p50 = 0.0;
+    double p99 = 0.0;
+};
+
+// 每批的平均单次耗时（纳秒）。paced 为 true 时每批之后（计时之外）暂停 1 ms，模拟每帧少量日志、后台线程来得及写出
+template <typename Fn>
+Stats measure(int calls, Fn&& fn, bool paced = false) {
+    std::vector<double> samples;
+    samples.reserve(static_cast<std::size_t>(calls / BATCH));
+    double total = 0.0;
+    int frame = 0;
+    for (int done = 0; done < calls; done += BATCH) {
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < BATCH; ++i) {
+            fn(frame++);
+        }
+        const auto end = std::chrono::steady_clock::now();
+        const double ns = std::chrono::duration<double, std::nano>(end - start).count() / BATCH;
+        samples.push_back(ns);
+        total += ns;
+        if (paced) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    std::ranges::sort(samples);
+    Stats stats;
+    stats.average = total / static_cast<double>(samples.size());
+    stats.p50 = samples[samples.size() / 2];
+    stats.p99 = samples[samples.size() * 99 / 100];
+    return stats;
+}
+
+void report(const char* label, const Stats& stats) {
+    spdlog::info("{:<20} 平均 {:9.1f} ns  p50 {:9.1f} ns  p99 {:9.1f} ns", label, stats.average, stats.p50, stats.p99);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const int calls = std::max(BATCH, argc > 1 ? std::stoi(argv[1]) : 1'000'000);
+    const std::string texture_path = "assets/textures/Actors/frog.png";
+    const auto log_path = (std::filesystem::temp_directory_path() / "sunnyland_log_benchmark.log").string();
+    std::vector<std::pair<const char*, Stats>> results;
+
+    // 1. 同步：格式化并在调用线程写文件
+    {
+        auto logger = std::make_shared<spdlog::logger>("sync", std::make_shared<spdlog::sinks::basic_file_sink_mt>(log_path, true));
+        results.emplace_back("同步写文件", measure(calls, [&](int frame) {
+            logger->warn("纹理 '{}' 未找到缓存，尝试加载。帧 {}", texture_path, frame);
+        }));
+        logger->flush();
+    }
+
+    // 2. 异步：调用线程只格式化并入队
+    engine::utils::Log::Settings settings;
+    settings.level = spdlog::level::info;
+    settings.file_path = log_path;
+    settings.console = false;
+    settings.duplicate_window_ms = 0;
+    engine::utils::Log::init(settings);
+    // 连续调用会塞满队列，测到的是队列满时的开销；分帧调用更接近游戏中的情况
+    results.emplace_back("异步队列 (连续)", measure(calls, [&](int frame) {
+        spdlog::warn("纹理 '{}' 未找到缓存，尝试加载。帧 {}", texture_path, frame);
+    }));
+    const auto dropped = engine::utils::Log::getDroppedCount();
+    results.emplace_back("异步队列 (每帧100条)", measure(std::min(calls, 100'000), [&](int frame) {
+        spdlog::warn("纹理 '{}' 未找到缓存，尝试加载。帧 {}", texture_path, frame);
+    }, true));
+
+    // 3. 运行期过滤：debug 低于当前级别，只有一次级别比较
+    results.emplace_back("运行期过滤 (debug)", measure(calls, [&](int frame) {
+        spdlog::debug("纹理 '{}' 未找到缓存，尝试加载。帧 {}", texture_path, frame);
+    }));
+
+    // 4. 编译期移除：SPDLOG_TRACE 展开为空语句，测得的是循环本身的开销
+    results.emplace_back("编译期移除 (trace)", measure(calls, [&](int frame) {
+        SPDLOG_TRACE("纹理 '{}' 未找到缓存，尝试加载。帧 {}", texture_path, frame);
+        (void)frame;
+    }));
+
+    // 5. 限流：每秒放行一次，其余调用只读时钟和原子量
+    results.emplace_back("限流 (1 次/秒)", measure(calls, [&](int frame) {
+        SUNNYLAND_LOG_EVERY(spdlog::level::warn, 1000, "纹理 '{}' 未找到缓存，尝试加载。帧 {}", texture_path, frame);
+    }));
+
+    engine::utils::Log::shutdown();     // 等待后台线程写完
+    std::error_code ec;
+    std::filesystem::remove(log_path, ec);
+
+    spdlog::info("每项 {} 次调用，按每批 {} 次计时：", calls, BATCH);
+    for (const auto& [label, stats] : results) {
+        report(label, stats);
+    }
+    spdlog::info("异步队列容量 {} 条，连续调用时因队列满丢弃 {} 条（丢弃最旧的消息，调用方不阻塞）。", settings.queue_size, dropped);
+    return 0;
+}
@@ -0,0 +1,162 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+// 粒子系统基准测试：维持指定数量的存活粒子，统计每帧 update / render 耗时并与 144 FPS 帧预算比较。
+// 用法: particle_benchmark [存活粒子数=50000] [帧数=600] [--headless]
+//   --headless 使用 offscreen 视频驱动和软件渲染器，适合在 CI 或无显示环境下运行。
+
+#include "engine/render/camera.h"
+#include "engine/render/particle_system.h"
+#include "engine/resource/resource_manager.h"
+#include <SDL3/SDL.h>
+#include <SDL3_mixer/SDL_mixer.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr double FRAME_BUDGET_MS = 1000.0 / 144.0;
+
+struct Stats {
+    double average = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+};
+
+Stats summarize(std::vector<double> samples) {
+    Stats stats;
+    if (samples.empty()) {
+        return stats;
+    }
+    std::ranges::sort(samples);
+    for (double sample : samples) {
+        stats.average += sample;
+    }
+    stats.average /= static_cast<double>(samples.size());
+    stats.p99 = samples[samples.size() * 99 / 100];
+    stats.max = samples.back();
+    return stats;
+}
+
+double elapsedMs(Uint64 start, Uint64 end) {
+    return static_cast<double>(end - start) * 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::uint32_t target_live = 50000;
+    int frame_count = 600;
+    bool headless = false;
+    int positional = 0;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--headless") == 0) {
+            headless = true;
+        } else if (positional++ == 0) {
+            target_live = static_cast<std::uint32_t>(std::stoul(argv[i]));
+        } else {
+            frame_count = std::stoi(argv[i]);
+        }
+    }
+
+    spdlog::set_level(spdlog::level::info);
+    if (headless) {
+        SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen");
+        SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+    }
+    SDL_SetHint(SDL_HINT_AUDIO_DRIVER, "dummy");
+    // AudioManager 在后台线程打开设备，音频子系统和 SDL_mixer 须先在主线程初始化
+    if (!SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) || !MIX_Init()) {
+        spdlog::error("SDL 初始化失败! SDL错误: {}", SDL_GetError());
+        return 1;
+    }
+    SDL_Window* window = SDL_CreateWindow("particle_benchmark", 1280, 720, 0);
+    SDL_Renderer* renderer = window ? SDL_CreateRenderer(window, nullptr) : nullptr;
+    if (!renderer) {
+        spdlog::error("无法创建窗口或渲染器! SDL错误: {}", SDL_GetError());
+        MIX_Quit();
+        SDL_Quit();
+        return 1;
+    }
+    SDL_SetRenderVSync(renderer, 0);
+
+    {
+        engine::resource::ResourceManager resource_manager(renderer);
+        engine::render::ParticleSystem particles(resource_manager);
+        engine::render::Camera camera(glm::vec2(1280.0f, 720.0f));
+
+        // 两种发射器共享同一纹理（验证合批），第三种使用另一纹理
+        const std::uint32_t capacity = target_live / 2 + 1024;
+        engine::render::ParticleEmitterDesc spark;
+        spark.texture_path = "assets/textures/FX/item-feedback.png";
+        spark.source_rect = {0, 0, 32, 32};
+        spark.capacity = capacity;
+        spark.velocity_min = {-120.0f, -200.0f};
+        spark.velocity_max = {120.0f, -40.0f};
+        engine::render::ParticleEmitterDesc dust = spark;
+        dust.gravity = {0.0f, 20.0f};
+        dust.size_start = 4.0f;
+        engine::render::ParticleEmitterDesc smoke;
+        smoke.texture_path = "assets/textures/FX/enemy-deadth.png";
+        smoke.source_rect = {0, 0, 40, 41};
+        smoke.capacity = capacity;
+        const engine::render::EmitterId emitters[] = {particles.registerEmitter(spark),
+                                                      particles.registerEmitter(dust),
+                                                      particles.registerEmitter(smoke)};
+
+        // 预热到目标数量附近
+        const float delta_time = 1.0f / 144.0f;
+        const std::uint32_t per_frame = target_live / 144 + 1;   // 平均寿命约 0.75s，持续发射以维持数量
+        std::vector<double> update_ms, render_ms, frame_ms;
+        update_ms.reserve(frame_count);
+        render_ms.reserve(frame_count);
+        frame_ms.reserve(frame_count);
+        std::uint32_t peak_live = 0;
+
+        for (int frame = 0; frame < frame_count; ++frame) {
+            const auto live = particles.getLiveCount();
+            const std::uint32_t deficit = live < target_live ? target_live - live : 0;
+            const std::uint32_t emit_count = std::min(deficit, per_frame * 4);
+            for (std::size_t e = 0; e < std::size(emitters); ++e) {
+                const glm::vec2 position{160.0f + 480.0f * static_cast<float>(e), 600.0f};
+                particles.emit(emitters[e], position, emit_count / 3);
+            }
+
+            const Uint64 start = SDL_GetPerformanceCounter();
+            particles.update(delta_time);
+            const Uint64 after_update = SDL_GetPerformanceCounter();
+            SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+            SDL_RenderClear(renderer);
+            particles.render(renderer, camera);
+            SDL_RenderPresent(renderer);
+            const Uint64 end = SDL_GetPerformanceCounter();
+
+            peak_live = std::max(peak_live, particles.getLiveCount());
+            if (frame >= frame_count / 10) {    // 丢弃前 10% 的预热帧
+                update_ms.push_back(elapsedMs(start, after_update));
+                render_ms.push_back(elapsedMs(after_update, end));
+                frame_ms.push_back(elapsedMs(start, end));
+            }
+        }
+
+        const auto update_stats = summarize(update_ms);
+        const auto render_stats = summarize(render_ms);
+        const auto frame_stats = summarize(frame_ms);
+        spdlog::info("渲染驱动: {}  目标存活粒子: {}  峰值存活: {}  绘制调用/帧: {}",
+                     SDL_GetCurrentVideoDriver(), target_live, peak_live, particles.getDrawCalls());
+        spdlog::info("update  平均 {:.3f} ms  p99 {:.3f} ms  最大 {:.3f} ms", update_stats.average, update_stats.p99, update_stats.max);
+        spdlog::info("render  平均 {:.3f} ms  p99 {:.3f} ms  最大 {:.3f} ms", render_stats.average, render_stats.p99, render_stats.max);
+        spdlog::info("合计    平均 {:.3f} ms  p99 {:.3f} ms  (144 FPS 预算 {:.3f} ms) -> {}",
+                     frame_stats.average, frame_stats.p99, FRAME_BUDGET_MS,
+                     frame_stats.p99 <= FRAME_BUDGET_MS ? "达标" : "超出预算");
+    }
+
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroyWindow(window);
+    MIX_Quit();
+    SDL_Quit();
+    return 0;
+}
@@ -0,0 +1,489 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+// 资源浸泡测试：无界面地反复加载、卸载每个关卡的资源集合（地图纹理、全部音效和音乐、字体），
+// 每轮结束后记录常驻内存、堆分配器统计、存活的 SDL 纹理和各资源缓存的大小，发现随时间上升的趋势即失败。
+// 用于发现长时间运行（展台、挂机）时缓慢的内存增长、纹理泄漏和堆碎片。
+// 用法:
+//   soak_test [--cycles 100] [--hours H] [--frames 30] [--warmup 3] [--tolerance-mb 4] [--clear] [--csv 文件] [--headless]
+//     --cycles       运行的轮数；每轮依次切换到 assets/maps 下的每个关卡，最后切到空场景释放全部关卡资源
+//     --hours        按时长运行（可以是小数），给出时忽略 --cycles
+//     --frames       每个关卡加载完成后运行的帧数
+//     --warmup       不计入趋势的预热轮数（首轮会建立缓存、内存池和驱动内部的分配）
+//     --tolerance-mb 常驻内存、堆占用在整个运行中允许的增长（按线性回归外推）
+//     --clear        每轮结束时额外调用 ResourceManager::clear()
+//     --csv          把每轮的采样写入 CSV，便于画图
+//     --headless     使用 offscreen 视频驱动和软件渲染器，适合在 CI 或无显示环境下运行。
+
+#include "engine/core/coroutine.h"
+#include "engine/core/event_bus.h"
+#include "engine/core/frame_governor.h"
+#include "engine/render/virtual_canvas.h"
+#include "engine/resource/resource_manager.h"
+#include "engine/scene/scene.h"
+#include "engine/scene/scene_manager.h"
+#include "engine/utils/frame_pool.h"
+#include "engine/utils/metrics.h"
+#include <SDL3/SDL.h>
+#include <SDL3_mixer/SDL_mixer.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if defined(__GLIBC__)
+#include <malloc.h>         // 用于 mallinfo2
+#endif
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>          // 用于 K32GetProcessMemoryInfo
+#endif
+
+namespace {
+
+constexpr const char* MAP_DIR = "assets/maps";
+constexpr const char* AUDIO_DIR = "assets/audio";
+constexpr const char* FONT_DIR = "assets/fonts";
+constexpr float FRAME_DELTA = 1.0f / 60.0f;
+constexpr int SCRIPTS_PER_LEVEL = 256;          // 每个关卡启动的协程脚本数，检验场景清理时脚本被取消
+constexpr Uint64 LOAD_TIMEOUT_NS = 60'000'000'000ull;
+constexpr double MB = 1024.0 * 1024.0;
+
+struct Options {
+    int cycles = 100;
+    double hours = 0.0;
+    int frames = 30;
+    int warmup = 3;
+    double tolerance_mb = 4.0;
+    bool clear = false;
+    const char* csv_path = nullptr;
+};
+
+/**
+ * @brief 所有关卡共用的非地图资源：音效（.wav/.mp3）、音乐（.ogg）和字体。
+ */
+struct SharedAssets {
+    std::vector<std::string> sounds;
+    std::vector<std::string> music;
+    std::vector<std::string> fonts;
+};
+
+/**
+ * @brief 每轮结束、关卡资源全部释放之后的一次采样。
+ */
+struct Sample {
+    int cycle = 0;
+    double seconds = 0.0;
+    double rss_mb = 0.0;
+    double heap_used_mb = 0.0;      ///< @brief 分配器中正在使用的字节（glibc 以外为 0）
+    double heap_free_mb = 0.0;      ///< @brief 分配器已向系统申请、但空闲的字节（碎片）
+    std::uint64_t live_textures = 0;
+    double texture_mb = 0.0;
+    std::size_t textures = 0;
+    std::size_t sounds = 0;
+    std::size_t music = 0;
+    std::size_t fonts = 0;
+    std::size_t frame_pool_blocks = 0;
+    std::size_t scripts = 0;
+};
+
+double residentMemoryMb() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (!K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return 0.0;
+    }
+    return static_cast<double>(counters.WorkingSetSize) / MB;
+#else
+    std::ifstream statm("/proc/self/statm");
+    std::uint64_t size_pages = 0;
+    std::uint64_t resident_pages = 0;
+    if (!(statm >> size_pages >> resident_pages)) {
+        return 0.0;
+    }
+    return static_cast<double>(resident_pages) * 4096.0 / MB;
+#endif
+}
+
+engine::core::Task wanderScript(int index) {
+    const float period = 0.05f * static_cast<float>(index % 8 + 1);
+    for (;;) {
+        co_await engine::core::waitSeconds(period);
+        co_await engine::core::nextFrame();
+    }
+}
+
+/**
+ * @brief 关卡场景：后台预加载地图纹理和共用资源，运行时把每张纹理画一次并运行一批协程脚本。
+ */
+class SoakLevelScene final : public engine::scene::Scene {
+private:
+    std::string map_path_;
+    const SharedAssets& shared_;
+    int font_size_;
+
+public:
+    SoakLevelScene(const std::string& map_path, const SharedAssets& shared, int font_size,
+                   engine::resource::ResourceManager& resource_manager, engine::scene::SceneManager& scene_manager)
+        : Scene(std::filesystem::path(map_path).stem().string(), resource_manager, scene_manager),
+          map_path_(map_path), shared_(shared), font_size_(font_size) {
+    }
+
+    bool prepare(engine::scene::SceneLoadContext& context) override {
+        if (!context.preloadMapTextures(map_path_)) {
+            return false;
+        }
+        for (const auto& sound : shared_.sounds) {
+            context.preloadSound(sound);
+        }
+        for (const auto& music : shared_.music) {
+            context.preloadMusic(music);
+        }
+        // 每个关卡用不同字号，字体缓存也会随关卡切换而载入、卸载
+        for (const auto& font : shared_.fonts) {
+            context.preloadFont(font, font_size_);
+        }
+        return true;
+    }
+
+    void init() override {
+        auto& scheduler = scene_manager_.getScheduler();
+        for (int i = 0; i < SCRIPTS_PER_LEVEL; ++i) {
+            scheduler.start(wanderScript(i), this);
+        }
+    }
+
+    void render(SDL_Renderer* renderer) override {
+        float x = 0.0f;
+        for (const auto& path : getAssets().textures) {
+            if (SDL_Texture* texture = resource_manager_.getTexture(path)) {
+                const SDL_FRect dest{x, 0.0f, 32.0f, 32.0f};
+                SDL_RenderTexture(renderer, texture, nullptr, &dest);
+                x += 8.0f;
+            }
+        }
+    }
+};
+
+/**
+ * @brief 没有任何资源的场景。切换到它时，上一个关卡独占的资源全部被 SceneManager 卸载。
+ */
+class BlankScene final : public engine::scene::Scene {
+public:
+    BlankScene(engine::resource::ResourceManager& resource_manager, engine::scene::SceneManager& scene_manager)
+        : Scene("blank", resource_manager, scene_manager) {
+    }
+};
+
+/**
+ * @brief 与 GameApp 相同的引擎组件，只是没有窗口事件处理和帧率限制。
+ */
+struct Engine {
+    SDL_Renderer* renderer;
+    engine::core::EventBus event_bus;
+    engine::core::CoroutineScheduler scheduler{event_bus};
+    engine::core::FrameGovernor governor;
+    engine::render::VirtualCanvas canvas;
+    engine::resource::ResourceManager resources;
+    engine::scene::SceneManager scenes{resources, event_bus, governor, scheduler, canvas};
+
+    explicit Engine(SDL_Renderer* sdl_renderer)
+        : renderer(sdl_renderer), canvas(sdl_renderer, glm::ivec2(640, 360)), resources(sdl_renderer) {
+        governor.setEnabled(false);
+    }
+
+    void frame() {
+        SDL_Event event;
+        while (SDL_PollEvent(&event)) {
+        }
+        scenes.update(FRAME_DELTA);
+        event_bus.dispatch();
+        scheduler.update(FRAME_DELTA);
+        canvas.begin();
+        scenes.render(renderer);
+        canvas.present();
+        SDL_RenderPresent(renderer);
+    }
+
+    // 切换场景并逐帧推进直到加载完成
+    bool replaceAndWait(std::unique_ptr<engine::scene::Scene> scene) {
+        scenes.requestReplaceScene(std::move(scene));
+        const Uint64 deadline = SDL_GetTicksNS() + LOAD_TIMEOUT_NS;
+        while (scenes.isLoading()) {
+            if (SDL_GetTicksNS() > deadline) {
+                spdlog::error("场景加载超时。");
+                return false;
+            }
+            frame();
+        }
+        frame();    // 切换发生在 update 开头，再跑一帧让新场景完成首帧
+        return true;
+    }
+};
+
+std::vector<std::string> listFiles(const char* directory, std::initializer_list<const char*> extensions) {
+    std::vector<std::string> files;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+        if (!entry.is_regular_file()) {
+            continue;
+        }
+        const auto extension = entry.path().extension().string();
+        if (std::ranges::any_of(extensions, [&](const char* wanted) { return extension == wanted; })) {
+            files.push_back(entry.path().generic_string());
+        }
+    }
+    std::ranges::sort(files);
+    return files;
+}
+
+Sample takeSample(int cycle, double seconds, const engine::resource::ResourceManager& resources,
+                  const engine::core::CoroutineScheduler& scheduler) {
+    using engine::utils::Metric;
+
+    Sample sample;
+    sample.cycle = cycle;
+    sample.seconds = seconds;
+    sample.rss_mb = residentMemoryMb();
+#if defined(__GLIBC__)
+    const auto info = mallinfo2();
+    sample.heap_used_mb = static_cast<double>(info.uordblks + info.hblkhd) / MB;
+    sample.heap_free_mb = static_cast<double>(info.fordblks) / MB;
+#endif
+    engine::utils::MetricsSnapshot now;
+    engine::utils::Metrics::snapshot(now);
+    sample.live_textures = now[Metric::TexturesCreated] - now[Metric::TexturesDestroyed];
+    sample.texture_mb = static_cast<double>(now[Metric::TextureBytesCreated] - now[Metric::TextureBytesDestroyed]) / MB;
+    sample.textures = resources.getTextureCount();
+    sample.sounds = resources.getSoundCount();
+    sample.music = resources.getMusicCount();
+    sample.fonts = resources.getFontCount();
+    sample.frame_pool_blocks = engine::utils::FramePool::instance().getStats().live_blocks;
+    sample.scripts = scheduler.getScriptCount();
+    return sample;
+}
+
+/**
+ * @brief 最小二乘拟合的斜率（每轮的增量）。
+ */
+double slope(const std::vector<Sample>& samples, double Sample::*field) {
+    const auto n = static_cast<double>(samples.size());
+    if (n < 2.0) {
+        return 0.0;
+    }
+    double sum_x = 0.0, sum_y = 0.0, sum_xx = 0.0, sum_xy = 0.0;
+    for (const auto& sample : samples) {
+        const auto x = static_cast<double>(sample.cycle);
+        const auto y = sample.*field;
+        sum_x += x;
+        sum_y += y;
+        sum_xx += x * x;
+        sum_xy += x * y;
+    }
+    const double denominator = n * sum_xx - sum_x * sum_x;
+    return denominator != 0.0 ? (n * sum_xy - sum_x * sum_y) / denominator : 0.0;
+}
+
+/**
+ * @brief 检查预热之后的采样。计数类指标（纹理、缓存、脚本、协程帧）每轮结束时必须回到基线；
+ *        内存类指标有噪声，按线性回归外推整个运行的增长，超过容差即失败。
+ * @return 没有发现上升趋势时返回 true。
+ */
+bool analyze(const std::vector<Sample>& samples, const Options& options) {
+    std::vector<Sample> measured;
+    for (const auto& sample : samples) {
+        if (sample.cycle > options.warmup) {
+            measured.push_back(sample);
+        }
+    }
+    if (measured.size() < 5) {
+        spdlog::warn("预热之后只有 {} 轮采样，不足以判断趋势（至少需要 5 轮）。", measured.size());
+        return true;
+    }
+
+    bool passed = true;
+    const auto& baseline = measured.front();
+    const auto checkCount = [&](const char* name, auto field) {
+        const auto base = baseline.*field;
+        const auto peak = std::ranges::max(measured, {}, field).*field;
+        if (peak > base) {
+            spdlog::error("失败: {} 没有回到基线（基线 {}，最高 {}），每轮卸载后仍有残留。", name, base, peak);
+            passed = false;
+        }
+    };
+    checkCount("存活的 SDL 纹理", &Sample::live_textures);
+    checkCount("纹理缓存", &Sample::textures);
+    checkCount("音效缓存", &Sample::sounds);
+    checkCount("音乐缓存", &Sample::music);
+    checkCount("字体缓存", &Sample::fonts);
+    checkCount("协程帧", &Sample::frame_pool_blocks);
+    checkCount("协程脚本", &Sample::scripts);
+
+    const double span = static_cast<double>(measured.back().cycle - baseline.cycle);
+    const auto checkTrend = [&](const char* name, double Sample::*field) {
+        const double per_cycle = slope(measured, field);
+        const double growth = per_cycle * span;
+        spdlog::info("{}: {:.2f} -> {:.2f} MB，趋势 {:+.4f} MB/轮，外推增长 {:+.2f} MB（容差 {:.2f} MB）",
+                     name, baseline.*field, measured.back().*field, per_cycle, growth, options.tolerance_mb);
+        if (growth > options.tolerance_mb) {
+            spdlog::error("失败: {} 持续上升。", name);
+            passed = false;
+        }
+    };
+    checkTrend("常驻内存", &Sample::rss_mb);
+    checkTrend("纹理显存（估算）", &Sample::texture_mb);
+#if defined(__GLIBC__)
+    checkTrend("堆占用", &Sample::heap_used_mb);
+    // 空闲块占比上升说明堆在碎片化：占用不变时，常驻内存的上升会被上面的检查发现，这里只报告
+    const auto fragmentation = [](const Sample& sample) {
+        const double total = sample.heap_used_mb + sample.heap_free_mb;
+        return total > 0.0 ? 100.0 * sample.heap_free_mb / total : 0.0;
+    };
+    spdlog::info("堆空闲占比（碎片）: {:.1f}% -> {:.1f}%", fragmentation(baseline), fragmentation(measured.back()));
+#else
+    spdlog::info("当前平台没有 mallinfo2，跳过堆分配器统计。");
+#endif
+    return passed;
+}
+
+void writeCsv(const char* path, const std::vector<Sample>& samples) {
+    std::FILE* file = std::fopen(path, "w");
+    if (!file) {
+        spdlog::error("无法写入 CSV: {}", path);
+        return;
+    }
+    std::fprintf(file, "cycle,seconds,rss_mb,heap_used_mb,heap_free_mb,live_textures,texture_mb,"
+                       "textures,sounds,music,fonts,frame_pool_blocks,scripts\n");
+    for (const auto& s : samples) {
+        std::fprintf(file, "%d,%.1f,%.3f,%.3f,%.3f,%llu,%.3f,%zu,%zu,%zu,%zu,%zu,%zu\n",
+                     s.cycle, s.seconds, s.rss_mb, s.heap_used_mb, s.heap_free_mb,
+                     static_cast<unsigned long long>(s.live_textures), s.texture_mb,
+                     s.textures, s.sounds, s.music, s.fonts, s.frame_pool_blocks, s.scripts);
+    }
+    std::fclose(file);
+    spdlog::info("已写入 {} 轮采样: {}", samples.size(), path);
+}
+
+int runSoak(SDL_Renderer* renderer, const Options& options) {
+    const auto maps = listFiles(MAP_DIR, {".tmj"});
+    if (maps.empty()) {
+        spdlog::error("{} 下没有关卡地图。", MAP_DIR);
+        return 1;
+    }
+    SharedAssets shared;
+    shared.sounds = listFiles(AUDIO_DIR, {".wav", ".mp3"});
+    shared.music = listFiles(AUDIO_DIR, {".ogg"});
+    shared.fonts = listFiles(FONT_DIR, {".ttf"});
+    spdlog::info("浸泡测试: {} 个关卡，{} 个音效，{} 首音乐，{} 个字体；{}，每关 {} 帧，预热 {} 轮。",
+                 maps.size(), shared.sounds.size(), shared.music.size(), shared.fonts.size(),
+                 options.hours > 0.0 ? fmt::format("{:.2f} 小时", options.hours) : fmt::format("{} 轮", options.cycles),
+                 options.frames, options.warmup);
+
+    Engine app(renderer);
+    std::vector<Sample> samples;
+    const Uint64 start = SDL_GetTicksNS();
+    const auto elapsedSeconds = [start] { return static_cast<double>(SDL_GetTicksNS() - start) / 1e9; };
+
+    for (int cycle = 1;; ++cycle) {
+        if (options.hours > 0.0 ? elapsedSeconds() >= options.hours * 3600.0 : cycle > options.cycles) {
+            break;
+        }
+        for (std::size_t i = 0; i < maps.size(); ++i) {
+            const int font_size = 16 + 8 * static_cast<int>(i);
+            if (!app.replaceAndWait(std::make_unique<SoakLevelScene>(maps[i], shared, font_size, app.resources, app.scenes))) {
+                return 1;
+            }
+            for (int frame = 0; frame < options.frames; ++frame) {
+                app.frame();
+            }
+        }
+        if (!app.replaceAndWait(std::make_unique<BlankScene>(app.resources, app.scenes))) {
+            return 1;
+        }
+        if (options.clear) {
+            app.resources.clear();
+        }
+
+        samples.push_back(takeSample(cycle, elapsedSeconds(), app.resources, app.scheduler));
+        const auto& s = samples.back();
+        if (cycle == 1 || cycle % 10 == 0) {
+            spdlog::info("第 {} 轮 ({:.0f} s): RSS {:.1f} MB  堆 {:.1f}/{:.1f} MB  纹理 {} ({:.1f} MB)  缓存 {}/{}/{}/{}  协程帧 {}",
+                         cycle, s.seconds, s.rss_mb, s.heap_used_mb, s.heap_free_mb, s.live_textures, s.texture_mb,
+                         s.textures, s.sounds, s.music, s.fonts, s.frame_pool_blocks);
+        }
+    }
+
+    if (options.csv_path) {
+        writeCsv(options.csv_path, samples);
+    }
+    const bool passed = analyze(samples, options);
+    spdlog::info(passed ? "浸泡测试通过。" : "浸泡测试失败。");
+    return passed ? 0 : 1;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    bool headless = false;
+    for (int i = 1; i < argc; ++i) {
+        const bool has_value = i + 1 < argc;
+        if (std::strcmp(argv[i], "--cycles") == 0 && has_value) {
+            options.cycles = std::max(1, std::stoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--hours") == 0 && has_value) {
+            options.hours = std::max(0.0, std::stod(argv[++i]));
+        } else if (std::strcmp(argv[i], "--frames") == 0 && has_value) {
+            options.frames = std::max(0, std::stoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--warmup") == 0 && has_value) {
+            options.warmup = std::max(0, std::stoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--tolerance-mb") == 0 && has_value) {
+            options.tolerance_mb = std::stod(argv[++i]);
+        } else if (std::strcmp(argv[i], "--csv") == 0 && has_value) {
+            options.csv_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--clear") == 0) {
+            options.clear = true;
+        } else if (std::strcmp(argv[i], "--headless") == 0) {
+            headless = true;
+        } else {
+            spdlog::error("未知参数: {}", argv[i]);
+            spdlog::error("用法: soak_test [--cycles N] [--hours H] [--frames N] [--warmup N] [--tolerance-mb MB] [--clear] [--csv 文件] [--headless]");
+            return 1;
+        }
+    }
+
+    spdlog::set_level(spdlog::level::info);
+    if (headless) {
+        SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen");
+        SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+    }
+    SDL_SetHint(SDL_HINT_AUDIO_DRIVER, "dummy");
+    // AudioManager 在后台线程打开设备，音频子系统和 SDL_mixer 须先在主线程初始化
+    if (!SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) || !MIX_Init()) {
+        spdlog::error("SDL 初始化失败! SDL错误: {}", SDL_GetError());
+        return 1;
+    }
+    SDL_Window* window = SDL_CreateWindow("soak_test", 640, 360, SDL_WINDOW_HIDDEN);
+    SDL_Renderer* renderer = window ? SDL_CreateRenderer(window, nullptr) : nullptr;
+    if (!renderer) {
+        spdlog::error("无法创建窗口或渲染器! SDL错误: {}", SDL_GetError());
+        MIX_Quit();
+        SDL_Quit();
+        return 1;
+    }
+
+    const int exit_code = runSoak(renderer, options);
+
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroyWindow(window);
+    MIX_Quit();
+    SDL_Quit();
+    return exit_code;
+}
@@ -0,0 +1,277 @@
+﻿//
+// Created by Lenovo on 2026/10/19.
+//
+// 纹理烘焙工具：把目录下所有 PNG 转为同名 .sltex（已解码、预乘 alpha、渲染器原生像素格式，颜色少时使用调色板）。
+// 运行时 TextureManager 发现未过期的 .sltex 时直接上传，不再解码 PNG。
+// 用法: texture_baker [目录=assets/textures] [--format argb8888|abgr8888] [--no-palette] [--force] [--bench [轮数=5]] [--headless]
+//   --force    即使 .sltex 与 PNG 一致也重新烘焙
+//   --bench    烘焙后对比 PNG 路径（IMG_LoadTexture）与烘焙路径的加载耗时、读取字节数和 SDL 堆内存峰值
+//   --headless 使用 offscreen 视频驱动和软件渲染器，适合在 CI 或无显示环境下运行。
+
+#include "engine/resource/baked_texture.h"
+#include "engine/utils/binary_stream.h"
+#include "engine/utils/metrics.h"
+#include <SDL3/SDL.h>
+#include <SDL3_image/SDL_image.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace {
+
+// --- 通过 SDL_SetMemoryFunctions 统计 SDL（及 SDL_image 解码器）的堆内存 ---
+// 每块前面加 16 字节记录大小，以便 realloc/free 时扣减
+
+constexpr std::size_t ALLOC_HEADER = 16;
+std::atomic<std::int64_t> g_sdl_heap_bytes{0};
+std::atomic<std::int64_t> g_sdl_heap_peak{0};
+
+void recordAlloc(std::int64_t delta) {
+    const auto now = g_sdl_heap_bytes.fetch_add(delta, std::memory_order_relaxed) + delta;
+    auto peak = g_sdl_heap_peak.load(std::memory_order_relaxed);
+    while (now > peak && !g_sdl_heap_peak.compare_exchange_weak(peak, now, std::memory_order_relaxed)) {
+    }
+}
+
+void* trackedMalloc(std::size_t size) {
+    auto* block = static_cast<std::byte*>(std::malloc(size + ALLOC_HEADER));
+    if (!block) {
+        return nullptr;
+    }
+    std::memcpy(block, &size, sizeof(size));
+    recordAlloc(static_cast<std::int64_t>(size));
+    return block + ALLOC_HEADER;
+}
+
+void* trackedCalloc(std::size_t count, std::size_t size) {
+    const std::size_t total = count * size;
+    void* ptr = trackedMalloc(total);
+    if (ptr) {
+        std::memset(ptr, 0, total);
+    }
+    return ptr;
+}
+
+void trackedFree(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+    auto* block = static_cast<std::byte*>(ptr) - ALLOC_HEADER;
+    std::size_t size = 0;
+    std::memcpy(&size, block, sizeof(size));
+    recordAlloc(-static_cast<std::int64_t>(size));
+    std::free(block);
+}
+
+void* trackedRealloc(void* ptr, std::size_t size) {
+    if (!ptr) {
+        return trackedMalloc(size);
+    }
+    auto* block = static_cast<std::byte*>(ptr) - ALLOC_HEADER;
+    std::size_t old_size = 0;
+    std::memcpy(&old_size, block, sizeof(old_size));
+    auto* resized = static_cast<std::byte*>(std::realloc(block, size + ALLOC_HEADER));
+    if (!resized) {
+        return nullptr;
+    }
+    std::memcpy(resized, &size, sizeof(size));
+    recordAlloc(static_cast<std::int64_t>(size) - static_cast<std::int64_t>(old_size));
+    return resized + ALLOC_HEADER;
+}
+
+std::vector<std::string> findImages(const std::string& root) {
+    std::vector<std::string> images;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(root, ec)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".png") {
+            images.push_back(entry.path().generic_string());
+        }
+    }
+    std::ranges::sort(images);
+    return images;
+}
+
+bool needsBake(const std::string& image, const std::string& baked, std::vector<std::byte>& buffer) {
+    return !engine::utils::readFileBytes(baked, buffer) || !engine::resource::isBakedTextureCurrent(buffer, image);
+}
+
+double elapsedMs(Uint64 start, Uint64 end) {
+    return static_cast<double>(end - start) * 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+}
+
+struct BenchResult {
+    double total_ms = 0.0;          ///< @brief 所有图片一轮加载的平均耗时
+    double worst_ms = 0.0;          ///< @brief 单张图片的最长耗时
+    std::uint64_t bytes_read = 0;   ///< @brief 一轮从磁盘读取的字节数
+    std::int64_t peak_heap = 0;     ///< @brief 加载单张图片时 SDL 堆内存相对基线的最大增量
+    std::uint64_t allocations = 0;  ///< @brief 一轮中 operator new 的次数（需要 SUNNYLAND_TRACK_ALLOCATIONS）
+    int failures = 0;
+};
+
+template <typename LoadFn>
+BenchResult runBench(const std::vector<std::string>& files, int rounds, LoadFn&& load) {
+    BenchResult result;
+    for (const auto& file : files) {
+        std::error_code ec;
+        result.bytes_read += static_cast<std::uint64_t>(std::filesystem::file_size(file, ec));
+    }
+    const auto allocations_before = engine::utils::Metrics::get(engine::utils::Metric::Allocations);
+    for (int round = 0; round < rounds; ++round) {
+        for (std::size_t i = 0; i < files.size(); ++i) {
+            const auto baseline = g_sdl_heap_bytes.load(std::memory_order_relaxed);
+            g_sdl_heap_peak.store(baseline, std::memory_order_relaxed);
+            const Uint64 start = SDL_GetPerformanceCounter();
+            SDL_Texture* texture = load(i);
+            const Uint64 end = SDL_GetPerformanceCounter();
+            result.peak_heap = std::max(result.peak_heap, g_sdl_heap_peak.load(std::memory_order_relaxed) - baseline);
+            const double ms = elapsedMs(start, end);
+            result.total_ms += ms;
+            result.worst_ms = std::max(result.worst_ms, ms);
+            if (texture) {
+                SDL_DestroyTexture(texture);
+            } else {
+                ++result.failures;
+            }
+        }
+    }
+    result.total_ms /= rounds;
+    result.failures /= rounds;
+    result.allocations = (engine::utils::Metrics::get(engine::utils::Metric::Allocations) - allocations_before) / rounds;
+    return result;
+}
+
+void printBench(const char* label, const BenchResult& result) {
+    spdlog::info("{:<6} 每轮 {:8.2f} ms  单张最长 {:7.3f} ms  读取 {:8.1f} KiB  SDL 堆峰值 {:8.1f} KiB  operator new {} 次{}",
+                 label, result.total_ms, result.worst_ms, static_cast<double>(result.bytes_read) / 1024.0,
+                 static_cast<double>(result.peak_heap) / 1024.0, result.allocations,
+                 result.failures > 0 ? fmt::format("  失败 {} 张", result.failures) : "");
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string root = "assets/textures";
+    engine::resource::TextureBakeOptions options;
+    bool force = false;
+    bool headless = false;
+    int bench_rounds = 0;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--format") == 0 && i + 1 < argc) {
+            const std::string format = argv[++i];
+            if (format == "abgr8888") {
+                options.format = SDL_PIXELFORMAT_ABGR8888;
+            } else if (format != "argb8888") {
+                spdlog::error("未知的像素格式 '{}'，可选 argb8888、abgr8888。", format);
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--no-palette") == 0) {
+            options.allow_palette = false;
+        } else if (std::strcmp(argv[i], "--force") == 0) {
+            force = true;
+        } else if (std::strcmp(argv[i], "--headless") == 0) {
+            headless = true;
+        } else if (std::strcmp(argv[i], "--bench") == 0) {
+            bench_rounds = 5;
+            if (i + 1 < argc && std::isdigit(static_cast<unsigned char>(argv[i + 1][0]))) {
+                bench_rounds = std::max(1, std::stoi(argv[++i]));
+            }
+        } else {
+            root = argv[i];
+        }
+    }
+
+    // 必须在 SDL 的第一次分配之前设置
+    SDL_SetMemoryFunctions(trackedMalloc, trackedCalloc, trackedRealloc, trackedFree);
+    spdlog::set_level(spdlog::level::info);
+
+    const auto images = findImages(root);
+    if (images.empty()) {
+        spdlog::error("目录 '{}' 下没有找到 PNG 图片。", root);
+        return 1;
+    }
+
+    // --- 烘焙 ---
+    int baked_count = 0, skipped = 0, failed = 0;
+    std::uint64_t png_bytes = 0, baked_bytes = 0;
+    std::vector<std::byte> buffer;
+    for (const auto& image : images) {
+        const auto baked = engine::resource::getBakedTexturePath(image);
+        std::error_code ec;
+        png_bytes += static_cast<std::uint64_t>(std::filesystem::file_size(image, ec));
+        if (!force && !needsBake(image, baked, buffer)) {
+            baked_bytes += buffer.size();
+            ++skipped;
+            continue;
+        }
+        engine::resource::TextureBakeResult result;
+        if (!engine::resource::bakeTexture(image, baked, options, &result)) {
+            ++failed;
+            continue;
+        }
+        baked_bytes += result.file_size;
+        ++baked_count;
+        spdlog::info("{} ({}x{}, {}) -> {:.1f} KiB", baked, result.width, result.height,
+                     result.palette_size > 0 ? fmt::format("调色板 {} 色", result.palette_size) : std::string("直接像素"),
+                     static_cast<double>(result.file_size) / 1024.0);
+    }
+    spdlog::info("烘焙 {} 张，跳过未变化的 {} 张，失败 {} 张。PNG 合计 {:.1f} KiB，.sltex 合计 {:.1f} KiB。",
+                 baked_count, skipped, failed, static_cast<double>(png_bytes) / 1024.0, static_cast<double>(baked_bytes) / 1024.0);
+    if (bench_rounds == 0) {
+        return failed > 0 ? 1 : 0;
+    }
+
+    // --- 对比加载耗时 ---
+    if (headless) {
+        SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen");
+        SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+    }
+    if (!SDL_Init(SDL_INIT_VIDEO)) {
+        spdlog::error("SDL 初始化失败! SDL错误: {}", SDL_GetError());
+        return 1;
+    }
+    SDL_Window* window = SDL_CreateWindow("texture_baker", 640, 360, SDL_WINDOW_HIDDEN);
+    SDL_Renderer* renderer = window ? SDL_CreateRenderer(window, nullptr) : nullptr;
+    if (!renderer) {
+        spdlog::error("无法创建窗口或渲染器! SDL错误: {}", SDL_GetError());
+        SDL_Quit();
+        return 1;
+    }
+
+    std::vector<std::string> baked_files;
+    baked_files.reserve(images.size());
+    for (const auto& image : images) {
+        baked_files.push_back(engine::resource::getBakedTexturePath(image));
+    }
+    // 与 TextureManager 相同：复用文件缓冲区和调色板展开缓冲区，并检查源文件时间戳
+    std::vector<std::uint32_t> scratch;
+    const auto png = runBench(images, bench_rounds, [&](std::size_t i) {
+        return IMG_LoadTexture(renderer, images[i].c_str());
+    });
+    const auto sltex = runBench(baked_files, bench_rounds, [&](std::size_t i) -> SDL_Texture* {
+        if (!engine::utils::readFileBytes(baked_files[i], buffer) || !engine::resource::isBakedTextureCurrent(buffer, images[i])) {
+            return nullptr;
+        }
+        return engine::resource::createBakedTexture(renderer, buffer, scratch);
+    });
+
+    spdlog::info("渲染驱动: {}  图片 {} 张  {} 轮（文件已在系统缓存中，耗时不含磁盘 I/O）",
+                 SDL_GetCurrentVideoDriver(), images.size(), bench_rounds);
+    printBench("PNG", png);
+    printBench(".sltex", sltex);
+    if (sltex.total_ms > 0.0) {
+        spdlog::info("烘焙路径加速 {:.2f} 倍，SDL 堆峰值 {:+.1f} KiB{}", png.total_ms / sltex.total_ms,
+                     static_cast<double>(sltex.peak_heap - png.peak_heap) / 1024.0,
+                     engine::utils::Metrics::isAllocationTrackingEnabled() ? "" : "（未开启 SUNNYLAND_TRACK_ALLOCATIONS，operator new 次数无效）");
+    }
+
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroyWindow(window);
+    SDL_Quit();
+    return failed > 0 || sltex.failures > 0 ? 1 : 0;
+}